@@ -94,6 +94,25 @@ class V8_EXPORT Heap {
     kIncrementalAndConcurrent
   };
 
+  /**
+   * Specifies the type of a garbage collection.
+   */
+  enum class CollectionType : uint8_t {
+    /**
+     * Minor garbage collection that only reclaims objects allocated since the
+     * previous garbage collection. Objects surviving a minor garbage
+     * collection are promoted to the old generation. Requires a heap with
+     * `HeapOptions::enable_young_generation` and a build with
+     * `cppgc_enable_young_generation`; otherwise a major garbage collection is
+     * performed instead.
+     */
+    kMinor,
+    /**
+     * Major garbage collection that considers all objects on the heap.
+     */
+    kMajor,
+  };
+
   /**
    * Constraints for a Heap setup.
    */
@@ -105,6 +124,13 @@ class V8_EXPORT Heap {
      * garbage collector when growing the heap.
      */
     size_t initial_heap_size_bytes = 0;
+    /**
+     * Number of bytes that may be allocated between two minor garbage
+     * collections when the young generation is enabled. When 0, the limit is
+     * derived from the size of the heap after the last major garbage
+     * collection.
+     */
+    size_t young_generation_size_bytes = 0;
   };
 
   /**
@@ -146,6 +172,16 @@ class V8_EXPORT Heap {
      */
     SweepingType sweeping_support = SweepingType::kIncrementalAndConcurrent;
 
+    /**
+     * Specifies whether the heap uses a young generation. Objects that survive
+     * a garbage collection become old and are only reclaimed by major garbage
+     * collections, whereas the GC scheduler triggers cheaper minor garbage
+     * collections to reclaim short-lived objects. The young generation is
+     * enabled by the first garbage collection after creating the heap and
+     * requires a build with `cppgc_enable_young_generation`.
+     */
+    bool enable_young_generation = false;
+
     /**
      * Resource constraints specifying various properties that the internal
      * GC scheduler follows.
@@ -174,10 +210,13 @@ class V8_EXPORT Heap {
    * \param reason String specifying the reason for the forced garbage
    *   collection.
    * \param stack_state The embedder stack state, see StackState.
+   * \param collection_type The type of garbage collection, see
+   *   CollectionType.
    */
   void ForceGarbageCollectionSlow(
       const char* source, const char* reason,
-      StackState stack_state = StackState::kMayContainHeapPointers);
+      StackState stack_state = StackState::kMayContainHeapPointers,
+      CollectionType collection_type = CollectionType::kMajor);
 
   /**
    * \returns the opaque handle for allocating objects using
@@ -25,6 +25,10 @@ enum class MessageLoopBehavior : bool {
 
 enum class PriorityMode : bool { kDontApply, kApply };
 
+enum class WorkerThreadScheduling : bool { kSharedQueue, kWorkStealing };
+
+enum class NumaMode : bool { kDisabled, kEnabled };
+
 /**
  * Returns a new instance of the default v8::Platform implementation.
  *
@@ -40,6 +44,14 @@ enum class PriorityMode : bool { kDontApply, kApply };
  * If |priority_mode| is PriorityMode::kApply, the default platform will use
  * multiple task queues executed by threads different system-level priorities
  * (where available) to schedule tasks.
+ * If |worker_thread_scheduling| is WorkerThreadScheduling::kWorkStealing, all
+ * worker tasks run on a single pool of threads where every thread has its own
+ * task queue and idle threads steal tasks from busy ones. Tasks posted from a
+ * worker thread, such as additional job workers, then don't contend on a
+ * shared queue. |priority_mode| is ignored in this case.
+ * If |numa_mode| is NumaMode::kEnabled, worker threads are distributed over
+ * the NUMA nodes of the machine (where supported), bound to the processors of
+ * their node and prefer memory from their node.
  */
 V8_PLATFORM_EXPORT std::unique_ptr<v8::Platform> NewDefaultPlatform(
     int thread_pool_size = 0,
@@ -47,7 +59,10 @@ V8_PLATFORM_EXPORT std::unique_ptr<v8::Platform> NewDefaultPlatform(
     InProcessStackDumping in_process_stack_dumping =
         InProcessStackDumping::kDisabled,
     std::unique_ptr<v8::TracingController> tracing_controller = {},
-    PriorityMode priority_mode = PriorityMode::kDontApply);
+    PriorityMode priority_mode = PriorityMode::kDontApply,
+    WorkerThreadScheduling worker_thread_scheduling =
+        WorkerThreadScheduling::kSharedQueue,
+    NumaMode numa_mode = NumaMode::kDisabled);
 
 /**
  * The same as NewDefaultPlatform but disables the worker thread pool.
@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "cppgc/common.h"
@@ -152,6 +153,17 @@ class V8_EXPORT ResourceConstraints {
     initial_young_generation_size_ = initial_size;
   }
 
+  /**
+   * The number of entries of the primary megamorphic stub caches, which map
+   * (map, name) pairs to property access handlers. Applications with many
+   * megamorphic property accesses can use a larger cache to reduce conflicts.
+   * The value is rounded up to a power of two. If 0, V8 uses its default.
+   */
+  size_t stub_cache_entries() const { return stub_cache_entries_; }
+  void set_stub_cache_entries(size_t entries) {
+    stub_cache_entries_ = entries;
+  }
+
  private:
   static constexpr size_t kMB = 1048576u;
   size_t code_range_size_ = 0;
@@ -159,6 +171,7 @@ class V8_EXPORT ResourceConstraints {
   size_t max_young_generation_size_ = 0;
   size_t initial_old_generation_size_ = 0;
   size_t initial_young_generation_size_ = 0;
+  size_t stub_cache_entries_ = 0;
   uint32_t* stack_limit_ = nullptr;
 };
 
@@ -821,6 +834,61 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Returns the pretenuring decisions and survival histograms of the
+   * |max_sites| allocation sites with the most surviving objects in a textual
+   * format. The result can be passed to ImportPretenuringFeedback() of an
+   * isolate running the same scripts, e.g. in a later run of the embedder.
+   * Sites are identified by script name and source position, so only sites
+   * in named scripts are exported.
+   *
+   * Sites are only recorded while the --allocation-site-lifetime-histograms
+   * flag is enabled, which it is not by default as recording costs time in
+   * every garbage collection. Without it, the result contains no sites.
+   */
+  std::string ExportPretenuringFeedback(size_t max_sites = 1000);
+
+  /**
+   * Imports feedback produced by ExportPretenuringFeedback(). Literal
+   * allocation sites created after this call start out with the imported
+   * pretenuring decision instead of collecting feedback first.
+   *
+   * \returns false if |feedback| is malformed, in which case nothing is
+   *   imported.
+   */
+  bool ImportPretenuringFeedback(const std::string& feedback);
+
+  /**
+   * Returns a profile of the functions this isolate has run so far: the
+   * tier each function reached, its invocation count and a summary of its
+   * inline cache states. Functions are identified by the hash of their
+   * script source and their source range. Embedders can store the profile
+   * next to their code cache and pass it to ImportJitProfile() in a later
+   * run of the same scripts.
+   */
+  std::string ExportJitProfile();
+
+  /**
+   * Imports a profile produced by ExportJitProfile(). Functions that the
+   * profile saw optimized are tiered up after far fewer invocations,
+   * skipping Maglev if they reached Turbofan.
+   *
+   * \returns false if |profile| is malformed, in which case nothing is
+   *   imported.
+   */
+  bool ImportJitProfile(const std::string& profile);
+
+  /**
+   * Limits the size of the optimized code installed in this isolate to
+   * |budget_bytes|. When newly optimized code exceeds the budget, the least
+   * recently used optimized functions are deoptimized and may tier up again
+   * once they get hot. Functions on the stack count as used, and functions
+   * that tier up again after being deoptimized this way are only deoptimized
+   * again when no other candidate is left. Pass 0 to remove the limit. Only
+   * code optimized after this call is accounted.
+   */
+  void SetOptimizedCodeBudget(size_t budget_bytes);
+
   /**
    * This API is experimental and may change significantly.
    *
@@ -1382,6 +1450,18 @@ class V8_EXPORT Isolate {
    */
   void SetRAILMode(RAILMode rail_mode);
 
+  /**
+   * Optional request to size the young generation such that scavenges take
+   * at most |scavenge_pause_target_ms| and the application spends at least
+   * |throughput_target| (between 0 and 1) of its time outside of scavenges.
+   * The pause target takes precedence. Latency-sensitive embedders pick a
+   * low pause target, memory-constrained ones a low throughput target. The
+   * size stays within the young generation limits of the ResourceConstraints.
+   * Can be called repeatedly to adjust the targets.
+   */
+  void SetYoungGenerationTargets(double scavenge_pause_target_ms,
+                                 double throughput_target);
+
   /**
    * Update load start time of the RAIL mode
    */
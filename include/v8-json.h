@@ -5,15 +5,26 @@
 #ifndef INCLUDE_V8_JSON_H_
 #define INCLUDE_V8_JSON_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
 #include "v8-local-handle.h"  // NOLINT(build/include_directory)
+#include "v8-maybe.h"         // NOLINT(build/include_directory)
 #include "v8config.h"         // NOLINT(build/include_directory)
 
 namespace v8 {
 
 class Context;
+class Isolate;
 class Value;
 class String;
 
+namespace internal {
+class JsonStreamingParser;
+}  // namespace internal
+
 /**
  * A JSON Parser and Stringifier.
  */
@@ -40,6 +51,53 @@ class V8_EXPORT JSON {
   static V8_WARN_UNUSED_RESULT MaybeLocal<String> Stringify(
       Local<Context> context, Local<Value> json_object,
       Local<String> gap = Local<String>());
+
+  /**
+   * Parses a JSON text that is provided in chunks, e.g. as it arrives from
+   * the network, without holding on to the whole text.
+   *
+   * Complete elements of a top-level array and complete members of a
+   * top-level object are parsed as soon as their text has been fed, and their
+   * text is dropped right away, so at most one top-level element or member is
+   * buffered at any time. Top-level scalars are buffered completely.
+   *
+   * Positions in the messages of syntax errors within an element or member
+   * are relative to the start of that element or member.
+   */
+  class V8_EXPORT StreamingParser {
+   public:
+    enum class Encoding {
+      // Every byte is a Latin1 character, as for String::NewFromOneByte.
+      kOneByte,
+      kUtf8,
+    };
+
+    StreamingParser(Isolate* isolate, Encoding encoding);
+    ~StreamingParser();
+
+    StreamingParser(const StreamingParser&) = delete;
+    StreamingParser& operator=(const StreamingParser&) = delete;
+
+    /**
+     * Consumes the next |length| bytes of the text. Chunks may be split at
+     * any byte, including in the middle of a token or of a UTF-8 sequence.
+     * The chunk is not referenced after this call returns.
+     *
+     * Returns Nothing and throws a SyntaxError if the text is found to be
+     * invalid. The parser must not be used after that.
+     */
+    V8_WARN_UNUSED_RESULT Maybe<bool> Feed(Local<Context> context,
+                                           const uint8_t* data, size_t length);
+
+    /**
+     * Signals the end of the text and returns the parsed value, or throws a
+     * SyntaxError if the text is incomplete or invalid.
+     */
+    V8_WARN_UNUSED_RESULT MaybeLocal<Value> Finish(Local<Context> context);
+
+   private:
+    std::unique_ptr<internal::JsonStreamingParser> impl_;
+  };
 };
 
 }  // namespace v8
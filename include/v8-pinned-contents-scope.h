@@ -0,0 +1,87 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef INCLUDE_V8_PINNED_CONTENTS_SCOPE_H_
+#define INCLUDE_V8_PINNED_CONTENTS_SCOPE_H_
+
+#include <stddef.h>
+
+#include "v8-internal.h"      // NOLINT(build/include_directory)
+#include "v8-local-handle.h"  // NOLINT(build/include_directory)
+#include "v8config.h"         // NOLINT(build/include_directory)
+
+namespace v8 {
+
+class ArrayBufferView;
+class Isolate;
+class String;
+
+/**
+ * A stack-allocated class that gives access to the contents of an
+ * ArrayBufferView or a String without copying them, e.g. to pass them to
+ * native I/O. The garbage collector may run while the scope is alive, but
+ * does not move the contents and keeps the object holding them alive until
+ * the scope is destroyed: a string is pinned, and the off-heap contents of a
+ * view are kept alive through its ArrayBuffer.
+ *
+ * Pages with pinned objects cannot be compacted, and a young generation
+ * collection becomes a full collection while young objects are pinned, so
+ * scopes should be short-lived. The cost of pinning is reported with
+ * --trace-gc-nvp.
+ *
+ * The contents are not copied, so changes made by JavaScript while the scope
+ * is alive are visible through data(). Detaching the ArrayBuffer of a view
+ * while the scope is alive frees the contents.
+ *
+ * Creating a scope for a typed array whose contents are on the V8 heap first
+ * moves the contents to an off-heap backing store, as accessing its buffer
+ * would. A pinned string is not internalized in place or turned into a thin
+ * string, and String::MakeExternal() and String::CanMakeExternal() return
+ * false for it while the scope is alive.
+ */
+class V8_EXPORT PinnedContentsScope {
+ public:
+  PinnedContentsScope(Isolate* isolate, Local<ArrayBufferView> view);
+  /**
+   * Flattens |string| if it is not flat yet.
+   */
+  PinnedContentsScope(Isolate* isolate, Local<String> string);
+  ~PinnedContentsScope();
+
+  PinnedContentsScope(const PinnedContentsScope&) = delete;
+  PinnedContentsScope& operator=(const PinnedContentsScope&) = delete;
+
+  const void* data() const { return data_; }
+  size_t byte_length() const { return byte_length_; }
+  /**
+   * Whether the contents of a string are one-byte (Latin-1) characters, as
+   * opposed to two-byte (UTF-16) characters. Always true for views.
+   */
+  bool is_one_byte() const { return is_one_byte_; }
+
+ private:
+  // Declaring operator new and delete as deleted is not spec compliant.
+  // Therefore declare them private instead to disable dynamic alloc.
+  void* operator new(size_t size);
+  void* operator new[](size_t size);
+  void operator delete(void*, size_t);
+  void operator delete[](void*, size_t);
+
+  void Pin(internal::Address object);
+
+  internal::Isolate* const isolate_;
+  // A global handle to the pinned object, or nullptr if the contents are not
+  // on the V8 heap.
+  internal::Address* pinned_object_ = nullptr;
+  // A global handle to the ArrayBuffer of a view, which owns the off-heap
+  // contents.
+  internal::Address* buffer_ = nullptr;
+  const void* data_ = nullptr;
+  size_t byte_length_ = 0;
+  bool is_one_byte_ = true;
+};
+
+}  // namespace v8
+
+#endif  // INCLUDE_V8_PINNED_CONTENTS_SCOPE_H_
@@ -188,6 +188,13 @@ class JobDelegate {
    * running JobHandle::Join().
    */
   virtual bool IsJoiningThread() const = 0;
+
+  /**
+   * Returns the NUMA node of the processor that the current thread runs on,
+   * or -1 if unknown. Workers can use this to prefer work items whose memory
+   * is local to their node.
+   */
+  virtual int GetNumaNode() const { return -1; }
 };
 
 /**
@@ -210,7 +210,8 @@ class V8_EXPORT OutputStream {
 class V8_EXPORT CpuProfile {
  public:
   enum SerializationFormat {
-    kJSON = 0  // See format description near 'Serialize' method.
+    kJSON = 0,   // See format description near 'Serialize' method.
+    kBinary = 1  // See format description near 'Serialize' method.
   };
   /** Returns CPU profile title. */
   Local<String> GetTitle() const;
@@ -631,7 +632,8 @@ class V8_EXPORT HeapGraphNode {
 class V8_EXPORT HeapSnapshot {
  public:
   enum SerializationFormat {
-    kJSON = 0  // See format description near 'Serialize' method.
+    kJSON = 0,   // See format description near 'Serialize' method.
+    kBinary = 1  // See format description near 'Serialize' method.
   };
 
   /** Returns the root node of the heap graph. */
@@ -681,6 +683,21 @@ class V8_EXPORT HeapSnapshot {
    *
    * Nodes reference strings, other nodes, and edges by their indexes
    * in corresponding arrays.
+   *
+   * The binary format starts with the bytes "V8HS" and a format version,
+   * followed by a sequence of records. All numbers are unsigned LEB128
+   * varints. Each record starts with a one-byte tag:
+   *
+   *   0 end:      node_count, edge_count
+   *   1 string:   string_id, byte_length, UTF-8 bytes
+   *   2 node:     type, name string_id, id, self_size, trace_node_id,
+   *               detachedness
+   *   3 edge:     type, name string_id or index, from node id, to node id
+   *   4 location: node id, script_id, line, column
+   *
+   * Records refer to nodes by their SnapshotObjectId and to strings by the
+   * id of a string record that precedes them. Edges are not grouped by
+   * their source node. The end record is always the last one.
    */
   void Serialize(OutputStream* stream,
                  SerializationFormat format = kJSON) const;
@@ -1080,6 +1097,23 @@ class V8_EXPORT HeapProfiler {
       ObjectNameResolver* global_object_name_resolver = nullptr,
       bool hide_internals = true, bool capture_numeric_value = false);
 
+  /**
+   * Takes a heap snapshot and writes it to |stream| in the binary format
+   * described at `HeapSnapshot::Serialize()`, without retaining it. Edges are
+   * written while the heap is traversed, so the memory needed is bounded by
+   * the nodes of the snapshot rather than by all of its edges. Use this for
+   * large heaps where `TakeHeapSnapshot()` would need too much memory.
+   *
+   * |stream| is called while the heap is being traversed. Its methods must
+   * not call into V8, e.g. to create handles or run JavaScript, and must not
+   * allocate on the JavaScript heap. Debug builds check this.
+   *
+   * \returns whether the snapshot was written completely.
+   */
+  bool StreamHeapSnapshot(
+      OutputStream* stream,
+      const HeapSnapshotOptions& options = HeapSnapshotOptions());
+
   /**
    * Starts tracking of heap objects population statistics. After calling
    * this method, all heap objects relocations done by the garbage collector
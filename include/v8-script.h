@@ -747,6 +747,13 @@ class V8_EXPORT ScriptCompiler {
    * Creates and returns code cache for the specified unbound_script.
    * This will return nullptr if the script cannot be serialized. The
    * CachedData returned by this function should be owned by the caller.
+   *
+   * Optimized code is never cached. With --code-cache-tiering-hints, the
+   * cache records which functions were optimized so that they tier up early
+   * when the cache is consumed. These hints are only dropped if a protector
+   * the optimized code depended on has been invalidated in the consuming
+   * isolate; other dependencies of the code, such as maps of builtin
+   * prototypes, are not revalidated.
    */
   static CachedData* CreateCodeCache(Local<UnboundScript> unbound_script);
 
@@ -21,6 +21,7 @@
 #include "include/v8-function.h"
 #include "include/v8-json.h"
 #include "include/v8-locker.h"
+#include "include/v8-pinned-contents-scope.h"
 #include "include/v8-primitive-object.h"
 #include "include/v8-profiler.h"
 #include "include/v8-source-location.h"
@@ -55,6 +56,7 @@
 #include "src/execution/messages.h"
 #include "src/execution/microtask-queue.h"
 #include "src/execution/simulator.h"
+#include "src/execution/tiering-manager.h"
 #include "src/execution/v8threads.h"
 #include "src/execution/vm-state-inl.h"
 #include "src/handles/global-handles.h"
@@ -69,6 +71,7 @@
 #include "src/init/startup-data-util.h"
 #include "src/init/v8.h"
 #include "src/json/json-parser.h"
+#include "src/json/json-streaming-parser.h"
 #include "src/json/json-stringifier.h"
 #include "src/logging/counters-scopes.h"
 #include "src/logging/metrics.h"
@@ -3403,6 +3406,34 @@ MaybeLocal<String> JSON::Stringify(Local<Context> context,
   RETURN_ESCAPED(result);
 }
 
+JSON::StreamingParser::StreamingParser(Isolate* v8_isolate, Encoding encoding)
+    : impl_(std::make_unique<i::JsonStreamingParser>(
+          reinterpret_cast<i::Isolate*>(v8_isolate), encoding)) {}
+
+JSON::StreamingParser::~StreamingParser() = default;
+
+Maybe<bool> JSON::StreamingParser::Feed(Local<Context> context,
+                                        const uint8_t* data, size_t length) {
+  Utils::ApiCheck(!impl_->failed(), "v8::JSON::StreamingParser::Feed",
+                  "Parser used after a syntax error");
+  auto i_isolate = reinterpret_cast<i::Isolate*>(context->GetIsolate());
+  ENTER_V8_NO_SCRIPT(i_isolate, context, JSON_StreamingParser, Feed,
+                     Nothing<bool>(), i::HandleScope);
+  has_pending_exception = !impl_->Feed(base::VectorOf(data, length));
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return Just(true);
+}
+
+MaybeLocal<Value> JSON::StreamingParser::Finish(Local<Context> context) {
+  Utils::ApiCheck(!impl_->failed(), "v8::JSON::StreamingParser::Finish",
+                  "Parser used after a syntax error");
+  PREPARE_FOR_EXECUTION(context, JSON_StreamingParser, Finish, Value);
+  Local<Value> result;
+  has_pending_exception = !ToLocal<Value>(impl_->Finish(), &result);
+  RETURN_ON_FAILED_EXECUTION(Value);
+  RETURN_ESCAPED(result);
+}
+
 // --- V a l u e   S e r i a l i z a t i o n ---
 
 SharedValueConveyor::SharedValueConveyor(SharedValueConveyor&& other) noexcept
@@ -9571,6 +9602,7 @@ void Isolate::Initialize(Isolate* v8_isolate,
   i_isolate->set_allow_atomics_wait(params.allow_atomics_wait);
 
   i_isolate->heap()->ConfigureHeap(params.constraints);
+  i_isolate->set_stub_cache_entries(params.constraints.stub_cache_entries());
   if (params.constraints.stack_limit() != nullptr) {
     uintptr_t limit =
         reinterpret_cast<uintptr_t>(params.constraints.stack_limit());
@@ -9924,6 +9956,34 @@ bool Isolate::GetHeapCodeAndMetadataStatistics(
   return true;
 }
 
+std::string Isolate::ExportPretenuringFeedback(size_t max_sites) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
+  return i_isolate->heap()->pretenuring_handler()->ExportPretenuringFeedback(
+      max_sites);
+}
+
+bool Isolate::ImportPretenuringFeedback(const std::string& feedback) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
+  return i_isolate->heap()->pretenuring_handler()->ImportPretenuringFeedback(
+      feedback);
+}
+
+std::string Isolate::ExportJitProfile() {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
+  ENTER_V8_NO_SCRIPT_NO_EXCEPTION(i_isolate);
+  return i_isolate->tiering_manager()->ExportProfile();
+}
+
+bool Isolate::ImportJitProfile(const std::string& profile) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
+  return i_isolate->tiering_manager()->ImportProfile(profile);
+}
+
+void Isolate::SetOptimizedCodeBudget(size_t budget_bytes) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
+  i_isolate->tiering_manager()->set_optimized_code_budget(budget_bytes);
+}
+
 bool Isolate::MeasureMemory(std::unique_ptr<MeasureMemoryDelegate> delegate,
                             MeasureMemoryExecution execution) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
@@ -10182,6 +10242,13 @@ void Isolate::SetRAILMode(RAILMode rail_mode) {
   return i_isolate->SetRAILMode(rail_mode);
 }
 
+void Isolate::SetYoungGenerationTargets(double scavenge_pause_target_ms,
+                                        double throughput_target) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
+  i_isolate->heap()->SetYoungGenerationTargets(scavenge_pause_target_ms,
+                                               throughput_target);
+}
+
 void Isolate::UpdateLoadStartTime() {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
   i_isolate->UpdateLoadStartTime();
@@ -11120,10 +11187,16 @@ SnapshotObjectId HeapSnapshot::GetMaxSnapshotJSObjectId() const {
 
 void HeapSnapshot::Serialize(OutputStream* stream,
                              HeapSnapshot::SerializationFormat format) const {
-  Utils::ApiCheck(format == kJSON, "v8::HeapSnapshot::Serialize",
+  Utils::ApiCheck(format == kJSON || format == kBinary,
+                  "v8::HeapSnapshot::Serialize",
                   "Unknown serialization format");
   Utils::ApiCheck(stream->GetChunkSize() > 0, "v8::HeapSnapshot::Serialize",
                   "Invalid stream chunk size");
+  if (format == kBinary) {
+    i::HeapSnapshotBinarySerializer serializer(ToInternal(this));
+    serializer.Serialize(stream);
+    return;
+  }
   i::HeapSnapshotJSONSerializer serializer(ToInternal(this));
   serializer.Serialize(stream);
 }
@@ -11182,6 +11255,15 @@ const HeapSnapshot* HeapProfiler::TakeHeapSnapshot(ActivityControl* control,
   return TakeHeapSnapshot(options);
 }
 
+bool HeapProfiler::StreamHeapSnapshot(OutputStream* stream,
+                                      const HeapSnapshotOptions& options) {
+  Utils::ApiCheck(stream->GetChunkSize() > 0,
+                  "v8::HeapProfiler::StreamHeapSnapshot",
+                  "Invalid stream chunk size");
+  return reinterpret_cast<i::HeapProfiler*>(this)->StreamSnapshot(stream,
+                                                                   options);
+}
+
 void HeapProfiler::StartTrackingHeapObjects(bool track_allocations) {
   reinterpret_cast<i::HeapProfiler*>(this)->StartHeapObjectsTracking(
       track_allocations);
@@ -11244,6 +11326,80 @@ EmbedderStateScope::EmbedderStateScope(Isolate* v8_isolate,
 // Default destructor must be defined in implementation file.
 EmbedderStateScope::~EmbedderStateScope() = default;
 
+PinnedContentsScope::PinnedContentsScope(Isolate* v8_isolate,
+                                         Local<ArrayBufferView> view)
+    : isolate_(reinterpret_cast<i::Isolate*>(v8_isolate)) {
+  i::Handle<i::JSArrayBufferView> self = Utils::OpenHandle(*view);
+  if (i::IsJSTypedArray(*self)) {
+    i::Handle<i::JSTypedArray> array = i::Handle<i::JSTypedArray>::cast(self);
+    // Accessing the buffer of an on-heap typed array moves its contents to
+    // an off-heap backing store, which would leave data() stale. Do that
+    // upfront, after which the contents never move.
+    if (array->is_on_heap()) array->GetBuffer();
+  }
+  i::DisallowGarbageCollection no_gc;
+  // The contents are off the V8 heap and do not move, but the buffer that
+  // owns them must stay alive.
+  buffer_ = isolate_->global_handles()->Create(self->buffer()).location();
+  if (i::IsJSTypedArray(*self)) {
+    i::Tagged<i::JSTypedArray> array = i::JSTypedArray::cast(*self);
+    DCHECK(!array->is_on_heap());
+    data_ = array->DataPtr();
+    byte_length_ = array->GetByteLength();
+  } else if (i::IsJSDataView(*self)) {
+    i::Tagged<i::JSDataView> data_view = i::JSDataView::cast(*self);
+    data_ = data_view->data_pointer();
+    byte_length_ = data_view->byte_length();
+  } else {
+    DCHECK(i::IsJSRabGsabDataView(*self));
+    i::Tagged<i::JSRabGsabDataView> data_view =
+        i::JSRabGsabDataView::cast(*self);
+    data_ = data_view->data_pointer();
+    byte_length_ = data_view->GetByteLength();
+  }
+}
+
+PinnedContentsScope::PinnedContentsScope(Isolate* v8_isolate,
+                                         Local<String> string)
+    : isolate_(reinterpret_cast<i::Isolate*>(v8_isolate)) {
+  i::Handle<i::String> str =
+      i::String::Flatten(isolate_, Utils::OpenHandle(*string));
+  i::DisallowGarbageCollection no_gc;
+  // Pin the string that holds the characters.
+  i::Tagged<i::String> underlying = *str;
+  while (i::StringShape(underlying).IsIndirect()) {
+    underlying = underlying->GetUnderlying();
+  }
+  i::String::FlatContent content = str->GetFlatContent(no_gc);
+  DCHECK(content.IsFlat());
+  if (content.IsOneByte()) {
+    base::Vector<const uint8_t> chars = content.ToOneByteVector();
+    data_ = chars.begin();
+    byte_length_ = chars.size();
+  } else {
+    base::Vector<const base::uc16> chars = content.ToUC16Vector();
+    data_ = chars.begin();
+    byte_length_ = chars.size() * sizeof(base::uc16);
+    is_one_byte_ = false;
+  }
+  if (!i::IsExternalString(underlying)) Pin(underlying.ptr());
+}
+
+PinnedContentsScope::~PinnedContentsScope() {
+  if (buffer_ != nullptr) i::GlobalHandles::Destroy(buffer_);
+  if (pinned_object_ == nullptr) return;
+  isolate_->heap()->UnpinObject(
+      i::HeapObject::cast(i::Tagged<i::Object>(*pinned_object_)));
+  i::GlobalHandles::Destroy(pinned_object_);
+}
+
+void PinnedContentsScope::Pin(i::Address object) {
+  DCHECK_NULL(pinned_object_);
+  pinned_object_ = isolate_->global_handles()->Create(object).location();
+  isolate_->heap()->PinObject(
+      i::HeapObject::cast(i::Tagged<i::Object>(object)));
+}
+
 void TracedReferenceBase::CheckValue() const {
 #ifdef V8_HOST_ARCH_64_BIT
   if (IsEmpty()) return;
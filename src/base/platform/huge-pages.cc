@@ -0,0 +1,121 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/platform/huge-pages.h"
+
+#if V8_OS_LINUX
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+
+#include "src/base/bits.h"
+
+namespace v8 {
+namespace base {
+
+#if V8_OS_LINUX
+
+namespace {
+
+// Used if the kernel does not report the huge page size.
+constexpr size_t kDefaultHugePageSize = 2 * 1024 * 1024;
+
+bool IsEnabledSystemWide() {
+  FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (file == nullptr) return false;
+  // The file lists all modes with the active one in brackets, e.g.
+  // "always [madvise] never".
+  char modes[64] = {0};
+  bool enabled = fgets(modes, sizeof(modes), file) != nullptr &&
+                 strstr(modes, "[never]") == nullptr;
+  fclose(file);
+  return enabled;
+}
+
+size_t ReadHugePageSize() {
+  if (!IsEnabledSystemWide()) return 0;
+  FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+  if (file == nullptr) return kDefaultHugePageSize;
+  unsigned long long size = 0;  // NOLINT(runtime/int)
+  if (fscanf(file, "%llu", &size) != 1 ||
+      !bits::IsPowerOfTwo(static_cast<uint64_t>(size))) {
+    size = kDefaultHugePageSize;
+  }
+  fclose(file);
+  return static_cast<size_t>(size);
+}
+
+}  // namespace
+
+// static
+size_t HugePages::PageSize() {
+  static const size_t page_size = ReadHugePageSize();
+  return page_size;
+}
+
+// static
+bool HugePages::Enable(void* address, size_t size) {
+#ifdef MADV_HUGEPAGE
+  if (PageSize() == 0) return false;
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+// static
+size_t HugePages::BackedBytes(void* address, size_t size) {
+  if (PageSize() == 0) return 0;
+  FILE* file = fopen("/proc/self/smaps", "r");
+  if (file == nullptr) return 0;
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(address);
+  const uintptr_t end = begin + size;
+  size_t result = 0;
+  // Size of the overlap of the current mapping with the range.
+  size_t overlap = 0;
+  bool at_line_start = true;
+  char line[256];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    const bool is_line_start = at_line_start;
+    at_line_start = strchr(line, '\n') != nullptr;
+    // Skip the rest of lines that did not fit into the buffer.
+    if (!is_line_start) continue;
+    uintptr_t mapping_begin;
+    uintptr_t mapping_end;
+    unsigned long long kilobytes;  // NOLINT(runtime/int)
+    if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &mapping_begin, &mapping_end) ==
+        2) {
+      // Mapping headers look like "7f0000000000-7f0000200000 rw-p ...".
+      const uintptr_t overlap_begin = std::max(begin, mapping_begin);
+      const uintptr_t overlap_end = std::min(end, mapping_end);
+      overlap = overlap_begin < overlap_end ? overlap_end - overlap_begin : 0;
+    } else if (overlap > 0 &&
+               sscanf(line, "AnonHugePages: %llu kB", &kilobytes) == 1) {
+      result += std::min(overlap, static_cast<size_t>(kilobytes) * 1024);
+    }
+  }
+  fclose(file);
+  return result;
+}
+
+#else  // !V8_OS_LINUX
+
+// static
+size_t HugePages::PageSize() { return 0; }
+
+// static
+bool HugePages::Enable(void* address, size_t size) { return false; }
+
+// static
+size_t HugePages::BackedBytes(void* address, size_t size) { return 0; }
+
+#endif  // !V8_OS_LINUX
+
+}  // namespace base
+}  // namespace v8
@@ -0,0 +1,39 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_BASE_PLATFORM_HUGE_PAGES_H_
+#define V8_BASE_PLATFORM_HUGE_PAGES_H_
+
+#include <stddef.h>
+
+#include "src/base/base-export.h"
+
+namespace v8 {
+namespace base {
+
+// Transparent huge page (THP) support. Only implemented on Linux; elsewhere
+// huge pages are reported as unsupported.
+class V8_BASE_EXPORT HugePages final {
+ public:
+  // Returns the size of a transparent huge page, or 0 if transparent huge
+  // pages are not supported or disabled system-wide.
+  static size_t PageSize();
+
+  // Lets the kernel back the given range, which may still be inaccessible,
+  // with huge pages once it is faulted in. Only the parts of the range that
+  // are aligned to PageSize() can actually be backed by huge pages. Returns
+  // false if that is not supported.
+  static bool Enable(void* address, size_t size);
+
+  // Returns the number of bytes in the given range that are currently backed
+  // by huge pages, or 0 if unknown. Mappings that only partially overlap the
+  // range are accounted for with at most the size of the overlap. This walks
+  // the process' memory map and is slow.
+  static size_t BackedBytes(void* address, size_t size);
+};
+
+}  // namespace base
+}  // namespace v8
+
+#endif  // V8_BASE_PLATFORM_HUGE_PAGES_H_
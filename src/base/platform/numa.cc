@@ -0,0 +1,141 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/platform/numa.h"
+
+#if V8_OS_LINUX
+#include <sched.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include "src/base/logging.h"
+#include "src/base/macros.h"
+
+namespace v8 {
+namespace base {
+
+#if V8_OS_LINUX
+
+namespace {
+
+// From <linux/mempolicy.h>, which is not available everywhere.
+constexpr int kMpolPreferred = 1;
+
+// The largest node number that fits into the node masks passed to the kernel.
+constexpr int kMaxNodes = 1024;
+constexpr int kBitsPerLong = sizeof(unsigned long) * 8;  // NOLINT(runtime/int)
+
+// Parses a list of ranges such as "0-3,8,10-11", as used in sysfs, into the
+// numbers it contains. Returns an empty vector on failure.
+std::vector<int> ReadRangeList(const char* path) {
+  std::vector<int> result;
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) return result;
+  int first;
+  while (fscanf(file, "%d", &first) == 1) {
+    int last = first;
+    int separator = fgetc(file);
+    if (separator == '-') {
+      if (fscanf(file, "%d", &last) != 1) break;
+      separator = fgetc(file);
+    }
+    for (int i = first; i <= last; i++) result.push_back(i);
+    if (separator != ',') break;
+  }
+  fclose(file);
+  return result;
+}
+
+class NodeMask final {
+ public:
+  explicit NodeMask(int node) {
+    DCHECK_LE(0, node);
+    DCHECK_LT(node, kMaxNodes);
+    bits_[node / kBitsPerLong] = 1UL << (node % kBitsPerLong);
+  }
+
+  const unsigned long* bits() const { return bits_; }  // NOLINT(runtime/int)
+  // The kernel ignores the last bit of the mask.
+  unsigned long max_node() const { return kMaxNodes + 1; }  // NOLINT
+
+ private:
+  unsigned long bits_[kMaxNodes / kBitsPerLong] = {0};  // NOLINT(runtime/int)
+};
+
+bool IsValidNode(int node) {
+  return node >= 0 && node < std::min(Numa::NumberOfNodes(), kMaxNodes);
+}
+
+}  // namespace
+
+// static
+int Numa::NumberOfNodes() {
+  static const int number_of_nodes = [] {
+    std::vector<int> nodes = ReadRangeList("/sys/devices/system/node/possible");
+    if (nodes.empty()) return 1;
+    return *std::max_element(nodes.begin(), nodes.end()) + 1;
+  }();
+  return number_of_nodes;
+}
+
+// static
+int Numa::GetCurrentNode() {
+  unsigned cpu;
+  unsigned node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return kNoNode;
+  return static_cast<int>(node);
+}
+
+// static
+bool Numa::BindCurrentThreadToNode(int node) {
+  if (!IsValidNode(node)) return false;
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+           node);
+  std::vector<int> cpus = ReadRangeList(path);
+  if (cpus.empty()) return false;
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpu_set);
+  }
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) return false;
+  NodeMask mask(node);
+  return syscall(SYS_set_mempolicy, kMpolPreferred, mask.bits(),
+                 mask.max_node()) == 0;
+}
+
+// static
+bool Numa::SetPreferredNode(void* address, size_t size, int node) {
+  if (!IsValidNode(node)) return false;
+  NodeMask mask(node);
+  return syscall(SYS_mbind, address, size, kMpolPreferred, mask.bits(),
+                 mask.max_node(), 0) == 0;
+}
+
+#else  // !V8_OS_LINUX
+
+// static
+int Numa::NumberOfNodes() { return 1; }
+
+// static
+int Numa::GetCurrentNode() { return kNoNode; }
+
+// static
+bool Numa::BindCurrentThreadToNode(int node) { return false; }
+
+// static
+bool Numa::SetPreferredNode(void* address, size_t size, int node) {
+  return false;
+}
+
+#endif  // !V8_OS_LINUX
+
+}  // namespace base
+}  // namespace v8
@@ -0,0 +1,42 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_BASE_PLATFORM_NUMA_H_
+#define V8_BASE_PLATFORM_NUMA_H_
+
+#include <stddef.h>
+
+#include "src/base/base-export.h"
+
+namespace v8 {
+namespace base {
+
+// Queries and placement for non-uniform memory access (NUMA) nodes. Only
+// implemented on Linux; elsewhere the machine is reported as a single node and
+// placement requests fail.
+class V8_BASE_EXPORT Numa final {
+ public:
+  static constexpr int kNoNode = -1;
+
+  // Returns the number of NUMA nodes on the current machine, or 1 if unknown.
+  static int NumberOfNodes();
+
+  // Returns the NUMA node of the processor that the current thread runs on, or
+  // kNoNode if unknown.
+  static int GetCurrentNode();
+
+  // Restricts the current thread to the processors of |node| and makes it
+  // prefer memory from |node| when faulting in pages. Returns false if that is
+  // not supported.
+  static bool BindCurrentThreadToNode(int node);
+
+  // Makes pages in the given range that are faulted in from now on prefer
+  // memory from |node|. Returns false if that is not supported.
+  static bool SetPreferredNode(void* address, size_t size, int node);
+};
+
+}  // namespace base
+}  // namespace v8
+
+#endif  // V8_BASE_PLATFORM_NUMA_H_
@@ -8,13 +8,17 @@
 
 #include "src/baseline/baseline-compiler.h"
 #include "src/codegen/compiler.h"
+#include "src/codegen/flush-instruction-cache.h"
 #include "src/execution/isolate.h"
 #include "src/handles/global-handles-inl.h"
+#include "src/heap/concurrent-allocator.h"
 #include "src/heap/factory-inl.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/local-heap-inl.h"
 #include "src/heap/parked-scope.h"
+#include "src/logging/runtime-call-stats-scope.h"
 #include "src/objects/fixed-array-inl.h"
+#include "src/objects/instruction-stream.h"
 #include "src/objects/js-function-inl.h"
 #include "src/utils/locked-queue-inl.h"
 
@@ -46,10 +50,18 @@ class BaselineCompilerTask {
                                                          : nullptr);
     BaselineCompiler compiler(local_isolate, shared_function_info_, bytecode_);
     compiler.GenerateCode();
+    // The batch flushes the instruction cache for all its code at once.
     maybe_code_ = local_isolate->heap()->NewPersistentMaybeHandle(
-        compiler.Build(local_isolate));
+        compiler.Build(local_isolate, /*flush_icache=*/false));
   }
 
+  int EstimateCodeSize() const {
+    return InstructionStream::SizeFor(
+        BaselineCompiler::EstimateInstructionSize(*bytecode_));
+  }
+
+  MaybeHandle<Code> code() const { return maybe_code_; }
+
   // Executed in the main thread.
   void Install(Isolate* isolate) {
     shared_function_info_->set_is_sparkplug_compiling(false);
@@ -111,6 +123,7 @@ class BaselineBatchCompilerJob {
       // Skip functions that are already being compiled.
       if (shared->is_sparkplug_compiling()) continue;
       tasks_.emplace_back(isolate, handles_.get(), shared);
+      estimated_code_size_ += tasks_.back().EstimateCodeSize();
     }
     if (v8_flags.trace_baseline_concurrent_compilation) {
       CodeTracer::Scope scope(isolate->GetCodeTracer());
@@ -122,24 +135,63 @@ class BaselineBatchCompilerJob {
   // Executed in the background thread.
   void Compile(LocalIsolate* local_isolate) {
     local_isolate->heap()->AttachPersistentHandles(std::move(handles_));
+    // Reserve code space for the whole batch up front, so that its code ends
+    // up in one contiguous range that can be flushed at once.
+    ConcurrentAllocator* code_allocator =
+        local_isolate->heap()->code_space_allocator();
+    base::Optional<base::AddressRegion> code_region;
+    if (!tasks_.empty()) {
+      code_region = code_allocator->ReserveLab(
+          std::min(estimated_code_size_, kMaxReservedCodeSize),
+          AllocationOrigin::kRuntime);
+    }
     for (auto& task : tasks_) {
       task.Compile(local_isolate);
     }
+    code_allocator->EndLabReservation();
+    FlushInstructionCache(code_region);
     // Get the handle back since we'd need them to install the code later.
     handles_ = local_isolate->heap()->DetachPersistentHandles();
   }
 
   // Executed in the main thread.
-  void Install(Isolate* isolate) {
-    HandleScope local_scope(isolate);
+  int Install(Isolate* isolate) {
     for (auto& task : tasks_) {
       task.Install(isolate);
     }
+    return static_cast<int>(tasks_.size());
   }
 
  private:
+  // Upper bound for the code space reserved per batch; larger batches
+  // allocate the remaining code through the regular paths.
+  static constexpr int kMaxReservedCodeSize =
+      4 * ConcurrentAllocator::kMaxLabSize;
+
+  // Flushes the instruction cache once for all code in |code_region|, and
+  // separately for code that did not fit or was moved by a GC.
+  void FlushInstructionCache(base::Optional<base::AddressRegion> code_region) {
+    Address region_end = kNullAddress;
+    for (auto& task : tasks_) {
+      Handle<Code> code;
+      if (!task.code().ToHandle(&code)) continue;
+      if (code_region && code_region->contains(code->instruction_start(),
+                                               code->instruction_size())) {
+        region_end = std::max(
+            region_end, code->instruction_start() + code->instruction_size());
+      } else {
+        code->FlushICache();
+      }
+    }
+    if (region_end != kNullAddress) {
+      ::v8::internal::FlushInstructionCache(code_region->begin(),
+                                            region_end - code_region->begin());
+    }
+  }
+
   std::vector<BaselineCompilerTask> tasks_;
   std::unique_ptr<PersistentHandles> handles_;
+  int estimated_code_size_ = 0;
 };
 
 class ConcurrentBaselineCompiler {
@@ -212,17 +264,33 @@ class ConcurrentBaselineCompiler {
     job_handle_->NotifyConcurrencyIncrease();
   }
 
+  // Installs the code of all finished batches in one step.
   void InstallBatch() {
-    while (!outgoing_queue_.IsEmpty()) {
-      std::unique_ptr<BaselineBatchCompilerJob> job;
-      outgoing_queue_.Dequeue(&job);
-      job->Install(isolate_);
+    if (outgoing_queue_.IsEmpty()) return;
+    RCS_SCOPE(isolate_, RuntimeCallCounterId::kCompileBaseline);
+    HandleScope scope(isolate_);
+    int batches = 0;
+    int functions = 0;
+    std::unique_ptr<BaselineBatchCompilerJob> job;
+    while (outgoing_queue_.Dequeue(&job)) {
+      functions += job->Install(isolate_);
+      batches++;
+    }
+    install_steps_++;
+    if (v8_flags.trace_baseline_concurrent_compilation) {
+      CodeTracer::Scope trace_scope(isolate_->GetCodeTracer());
+      PrintF(trace_scope.file(),
+             "[Concurrent Sparkplug] installed %d functions from %d batches\n",
+             functions, batches);
     }
   }
 
+  int install_steps() const { return install_steps_; }
+
  private:
   Isolate* isolate_;
   std::unique_ptr<JobHandle> job_handle_ = nullptr;
+  int install_steps_ = 0;
   LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>> incoming_queue_;
   LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>> outgoing_queue_;
 };
@@ -286,6 +354,10 @@ void BaselineBatchCompiler::InstallBatch() {
   concurrent_compiler_->InstallBatch();
 }
 
+int BaselineBatchCompiler::install_steps_for_testing() const {
+  return concurrent_compiler_ ? concurrent_compiler_->install_steps() : 0;
+}
+
 void BaselineBatchCompiler::EnsureQueueCapacity() {
   if (compilation_queue_.is_null()) {
     compilation_queue_ = isolate_->global_handles()->Create(
@@ -24,7 +24,7 @@ class BaselineBatchCompiler {
   explicit BaselineBatchCompiler(Isolate* isolate);
   ~BaselineBatchCompiler();
   // Enqueues SharedFunctionInfo of |function| for compilation.
-  void EnqueueFunction(Handle<JSFunction> function);
+  V8_EXPORT_PRIVATE void EnqueueFunction(Handle<JSFunction> function);
   void EnqueueSFI(Tagged<SharedFunctionInfo> shared);
 
   void set_enabled(bool enabled) { enabled_ = enabled; }
@@ -32,6 +32,9 @@ class BaselineBatchCompiler {
 
   void InstallBatch();
 
+  // Number of times the code of finished concurrent batches was installed.
+  V8_EXPORT_PRIVATE int install_steps_for_testing() const;
+
  private:
   // Ensure there is enough space in the compilation queue to enqueue another
   // function, growing the queue if necessary.
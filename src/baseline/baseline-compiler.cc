@@ -332,7 +332,8 @@ void BaselineCompiler::GenerateCode() {
   }
 }
 
-MaybeHandle<Code> BaselineCompiler::Build(LocalIsolate* local_isolate) {
+MaybeHandle<Code> BaselineCompiler::Build(LocalIsolate* local_isolate,
+                                          bool flush_icache) {
   CodeDesc desc;
   __ GetCode(local_isolate, &desc);
 
@@ -348,6 +349,7 @@ MaybeHandle<Code> BaselineCompiler::Build(LocalIsolate* local_isolate) {
   } else {
     code_builder.set_interpreter_data(bytecode_);
   }
+  if (!flush_icache) code_builder.set_skip_icache_flush();
   return code_builder.TryBuild();
 }
 
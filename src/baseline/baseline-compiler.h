@@ -53,7 +53,10 @@ class BaselineCompiler {
                             Handle<BytecodeArray> bytecode);
 
   void GenerateCode();
-  MaybeHandle<Code> Build(LocalIsolate* local_isolate);
+  // Builds the code object. If |flush_icache| is false, the caller has to
+  // flush the instruction cache before the code runs.
+  MaybeHandle<Code> Build(LocalIsolate* local_isolate,
+                          bool flush_icache = true);
   static int EstimateInstructionSize(Tagged<BytecodeArray> bytecode);
 
  private:
@@ -34,6 +34,7 @@
 #include "src/execution/isolate-inl.h"
 #include "src/execution/isolate.h"
 #include "src/execution/local-isolate.h"
+#include "src/execution/tiering-manager.h"
 #include "src/execution/vm-state-inl.h"
 #include "src/flags/flags.h"
 #include "src/handles/global-handles-inl.h"
@@ -1025,6 +1026,9 @@ class OptimizedCodeCache : public AllStatic {
     const CodeKind kind = code->kind();
     if (!CodeKindIsStoredInOptimizedCodeCache(kind)) return;
 
+    isolate->tiering_manager()->OnOptimizedCodeInstalled(function, code,
+                                                         IsOSR(osr_offset));
+
     Tagged<FeedbackVector> feedback_vector = function->feedback_vector();
 
     if (IsOSR(osr_offset)) {
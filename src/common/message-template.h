@@ -554,6 +554,8 @@ namespace internal {
     "Unexpected token '%', ...\"%\" is not valid JSON")                        \
   T(JsonParseUnexpectedTokenStartStringWithContext,                            \
     "Unexpected token '%', \"%\"... is not valid JSON")                        \
+  T(JsonParseUnexpectedTokenAtPosition,                                        \
+    "Unexpected token '%' in JSON at position %")                              \
   T(LabelRedeclaration, "Label '%' has already been declared")                 \
   T(LabelledFunctionDeclaration,                                               \
     "Labelled function declaration not allowed as the body of a control flow " \
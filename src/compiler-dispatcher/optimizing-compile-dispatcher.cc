@@ -9,6 +9,7 @@
 #include "src/codegen/optimized-compilation-info.h"
 #include "src/execution/isolate.h"
 #include "src/execution/local-isolate-inl.h"
+#include "src/execution/tiering-manager.h"
 #include "src/handles/handles-inl.h"
 #include "src/heap/local-heap-inl.h"
 #include "src/init/v8.h"
@@ -18,6 +19,7 @@
 #include "src/objects/js-function.h"
 #include "src/tasks/cancelable-task.h"
 #include "src/tracing/trace-event.h"
+#include "src/utils/locked-priority-queue-inl.h"
 
 namespace v8 {
 namespace internal {
@@ -74,23 +76,30 @@ class OptimizingCompileDispatcher::CompileTask : public v8::JobTask {
 };
 
 OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
-  DCHECK_EQ(0, input_queue_length_);
+  DCHECK(input_queue_.IsEmpty());
   if (job_handle_ && job_handle_->IsValid()) {
     // Wait for the job handle to complete, so that we know the queue
     // pointers are safe.
     job_handle_->Cancel();
   }
-  DeleteArray(input_queue_);
+}
+
+bool OptimizingCompileDispatcher::IsQueueAvailable() {
+  return input_queue_.size() < input_queue_capacity_;
+}
+
+int OptimizingCompileDispatcher::InputQueueLength() {
+  return static_cast<int>(input_queue_.size());
 }
 
 TurbofanCompilationJob* OptimizingCompileDispatcher::NextInput(
     LocalIsolate* local_isolate) {
-  base::MutexGuard access_input_queue_(&input_queue_mutex_);
-  if (input_queue_length_ == 0) return nullptr;
-  TurbofanCompilationJob* job = input_queue_[InputQueueIndex(0)];
+  TurbofanCompilationJob* job = nullptr;
+  base::TimeDelta queue_time;
+  if (!input_queue_.Dequeue(&job, &queue_time)) return nullptr;
   DCHECK_NOT_NULL(job);
-  input_queue_shift_ = InputQueueIndex(1);
-  input_queue_length_--;
+  isolate_->counters()->turbofan_compile_queue_latency()->AddTimedSample(
+      queue_time);
   return job;
 }
 
@@ -130,13 +139,10 @@ void OptimizingCompileDispatcher::FlushOutputQueue(bool restore_function_code) {
 }
 
 void OptimizingCompileDispatcher::FlushInputQueue() {
-  base::MutexGuard access_input_queue_(&input_queue_mutex_);
-  while (input_queue_length_ > 0) {
-    std::unique_ptr<TurbofanCompilationJob> job(
-        input_queue_[InputQueueIndex(0)]);
+  TurbofanCompilationJob* raw_job;
+  while (input_queue_.Dequeue(&raw_job)) {
+    std::unique_ptr<TurbofanCompilationJob> job(raw_job);
     DCHECK_NOT_NULL(job);
-    input_queue_shift_ = InputQueueIndex(1);
-    input_queue_length_--;
     Compiler::DisposeTurbofanCompilationJob(isolate_, job.get(), true);
   }
 }
@@ -151,10 +157,7 @@ void OptimizingCompileDispatcher::AwaitCompileTasks() {
   job_handle_ = V8::GetCurrentPlatform()->PostJob(
       kTaskPriority, std::make_unique<CompileTask>(isolate_, this));
 
-#ifdef DEBUG
-  base::MutexGuard access_input_queue(&input_queue_mutex_);
-  CHECK_EQ(input_queue_length_, 0);
-#endif  // DEBUG
+  DCHECK(input_queue_.IsEmpty());
 }
 
 void OptimizingCompileDispatcher::FlushQueues(
@@ -178,8 +181,7 @@ void OptimizingCompileDispatcher::Stop() {
   HandleScope handle_scope(isolate_);
   FlushQueues(BlockingBehavior::kBlock, false);
   // At this point the optimizing compiler thread's event loop has stopped.
-  // There is no need for a mutex when reading input_queue_length_.
-  DCHECK_EQ(input_queue_length_, 0);
+  DCHECK(input_queue_.IsEmpty());
 }
 
 void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
@@ -220,23 +222,28 @@ bool OptimizingCompileDispatcher::HasJobs() {
 void OptimizingCompileDispatcher::QueueForOptimization(
     TurbofanCompilationJob* job) {
   DCHECK(IsQueueAvailable());
-  {
-    // Add job to the back of the input queue.
-    base::MutexGuard access_input_queue(&input_queue_mutex_);
-    DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
-    input_queue_length_++;
-  }
+  const int priority = TieringManager::CompileQueuePriority(
+      *job->compilation_info()->closure(), job->compilation_info()->is_osr());
+  input_queue_.Enqueue(job, priority);
   job_handle_->NotifyConcurrencyIncrease();
 }
 
+void OptimizingCompileDispatcher::Reprioritize(Tagged<JSFunction> function,
+                                               int priority) {
+  DCHECK_EQ(ThreadId::Current(), isolate_->thread_id());
+  // Jobs in the input queue are not running yet, so it is safe to
+  // dereference their handles on the main thread.
+  input_queue_.RaisePriority(
+      [function](TurbofanCompilationJob* job) {
+        return *job->compilation_info()->closure() == function;
+      },
+      priority);
+}
+
 OptimizingCompileDispatcher::OptimizingCompileDispatcher(Isolate* isolate)
     : isolate_(isolate),
       input_queue_capacity_(v8_flags.concurrent_recompilation_queue_length),
-      input_queue_length_(0),
-      input_queue_shift_(0),
       recompilation_delay_(v8_flags.concurrent_recompilation_delay) {
-  input_queue_ = NewArray<TurbofanCompilationJob*>(input_queue_capacity_);
   if (v8_flags.concurrent_recompilation) {
     job_handle_ = V8::GetCurrentPlatform()->PostJob(
         kTaskPriority, std::make_unique<CompileTask>(isolate, this));
@@ -14,10 +14,12 @@
 #include "src/flags/flags.h"
 #include "src/heap/parked-scope.h"
 #include "src/utils/allocation.h"
+#include "src/utils/locked-priority-queue.h"
 
 namespace v8 {
 namespace internal {
 
+class JSFunction;
 class LocalHeap;
 class TurbofanCompilationJob;
 class RuntimeCallStats;
@@ -33,18 +35,15 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
   void Flush(BlockingBehavior blocking_behavior);
   // Takes ownership of |job|.
   void QueueForOptimization(TurbofanCompilationJob* job);
+  // Raises the priority of queued jobs for |function| to |priority|. Must be
+  // called on the main thread.
+  void Reprioritize(Tagged<JSFunction> function, int priority);
   void AwaitCompileTasks();
   void InstallOptimizedFunctions();
 
-  inline bool IsQueueAvailable() {
-    base::MutexGuard access_input_queue(&input_queue_mutex_);
-    return input_queue_length_ < input_queue_capacity_;
-  }
+  bool IsQueueAvailable();
 
-  inline int InputQueueLength() {
-    base::MutexGuard access_input_queue(&input_queue_mutex_);
-    return input_queue_length_;
-  }
+  int InputQueueLength();
 
   static bool Enabled() { return v8_flags.concurrent_recompilation; }
 
@@ -73,21 +72,12 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
   void CompileNext(TurbofanCompilationJob* job, LocalIsolate* local_isolate);
   TurbofanCompilationJob* NextInput(LocalIsolate* local_isolate);
 
-  inline int InputQueueIndex(int i) {
-    int result = (i + input_queue_shift_) % input_queue_capacity_;
-    DCHECK_LE(0, result);
-    DCHECK_LT(result, input_queue_capacity_);
-    return result;
-  }
-
   Isolate* isolate_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
-  TurbofanCompilationJob** input_queue_;
-  int input_queue_capacity_;
-  int input_queue_length_;
-  int input_queue_shift_;
-  base::Mutex input_queue_mutex_;
+  // Queue of incoming recompilation tasks (including OSR), ordered by the
+  // hotness of the function being compiled.
+  LockedPriorityQueue<TurbofanCompilationJob*> input_queue_;
+  const size_t input_queue_capacity_;
 
   // Queue of recompilation tasks ready to be installed (excluding OSR).
   std::queue<TurbofanCompilationJob*> output_queue_;
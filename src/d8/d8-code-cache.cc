@@ -0,0 +1,166 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/d8/d8-code-cache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <cinttypes>
+
+namespace v8 {
+
+namespace {
+
+constexpr uint32_t kEntryMagicNumber = 0xC0DECAC4;
+
+// Precedes the output of the code serializer in every entry. The size keeps
+// the data pointer-aligned.
+struct EntryHeader {
+  uint32_t magic_number;
+  uint32_t version_tag;
+  uint64_t source_hash;
+  uint32_t source_length;
+  uint32_t data_length;
+};
+static_assert(sizeof(EntryHeader) % sizeof(void*) == 0);
+
+// FNV-1a, which is good enough to name files and detect collisions.
+uint64_t HashBytes(uint64_t hash, const void* data, size_t length) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ bytes[i]) * uint64_t{0x100000001b3};
+  }
+  return hash;
+}
+
+constexpr uint64_t kKeySeed = uint64_t{0xcbf29ce484222325};
+constexpr uint64_t kSourceSeed = uint64_t{0x84222325cbf29ce4};
+
+}  // namespace
+
+class CodeCacheDirectory::WriteTask final : public v8::Task {
+ public:
+  WriteTask(CodeCacheDirectory* directory, const Key& key,
+            std::unique_ptr<ScriptCompiler::CachedData> data)
+      : directory_(directory), key_(key), data_(std::move(data)) {}
+
+  void Run() override {
+    directory_->WriteEntry(key_, data_->data, data_->length);
+    base::MutexGuard guard(&directory_->mutex_);
+    if (--directory_->pending_writes_ == 0) {
+      directory_->writes_done_.NotifyAll();
+    }
+  }
+
+ private:
+  CodeCacheDirectory* const directory_;
+  const Key key_;
+  const std::unique_ptr<ScriptCompiler::CachedData> data_;
+};
+
+CodeCacheDirectory::CodeCacheDirectory(const char* path,
+                                       v8::Platform* platform)
+    : path_(path), platform_(platform) {}
+
+CodeCacheDirectory::~CodeCacheDirectory() { WaitForPendingWrites(); }
+
+// static
+CodeCacheDirectory::Key CodeCacheDirectory::ComputeKey(
+    Isolate* isolate, Local<String> source, Local<Value> resource_name) {
+  String::Utf8Value source_utf8(isolate, source);
+  uint64_t source_hash =
+      HashBytes(kSourceSeed, *source_utf8, source_utf8.length());
+  uint64_t hash = HashBytes(kKeySeed, *source_utf8, source_utf8.length());
+  if (!resource_name.IsEmpty() && resource_name->IsString()) {
+    String::Utf8Value name_utf8(isolate, resource_name);
+    hash = HashBytes(hash, *name_utf8, name_utf8.length());
+  }
+  uint32_t version_tag = ScriptCompiler::CachedDataVersionTag();
+  hash = HashBytes(hash, &version_tag, sizeof(version_tag));
+  return {hash, source_hash, static_cast<uint32_t>(source_utf8.length())};
+}
+
+std::string CodeCacheDirectory::EntryPath(const Key& key) const {
+  char name[32];
+  base::OS::SNPrintF(name, sizeof(name), "%016" PRIx64 ".v8cache", key.hash);
+  std::string path = path_;
+  if (!path.empty() && !base::OS::isDirectorySeparator(path.back())) {
+    path += base::OS::DirectorySeparator();
+  }
+  return path + name;
+}
+
+ScriptCompiler::CachedData* CodeCacheDirectory::Lookup(
+    const Key& key, std::unique_ptr<base::OS::MemoryMappedFile>* mapping) {
+  std::unique_ptr<base::OS::MemoryMappedFile> file(
+      base::OS::MemoryMappedFile::open(
+          EntryPath(key).c_str(),
+          base::OS::MemoryMappedFile::FileMode::kReadOnly));
+  if (!file || file->size() < sizeof(EntryHeader)) return nullptr;
+  EntryHeader header;
+  memcpy(&header, file->memory(), sizeof(header));
+  if (header.magic_number != kEntryMagicNumber ||
+      header.version_tag != ScriptCompiler::CachedDataVersionTag() ||
+      header.source_hash != key.source_hash ||
+      header.source_length != key.source_length ||
+      header.data_length != file->size() - sizeof(EntryHeader)) {
+    return nullptr;
+  }
+  const uint8_t* data =
+      static_cast<const uint8_t*>(file->memory()) + sizeof(EntryHeader);
+  *mapping = std::move(file);
+  return new ScriptCompiler::CachedData(
+      data, static_cast<int>(header.data_length),
+      ScriptCompiler::CachedData::BufferNotOwned);
+}
+
+void CodeCacheDirectory::Remove(const Key& key) {
+  remove(EntryPath(key).c_str());
+}
+
+void CodeCacheDirectory::StoreInBackground(
+    const Key& key, std::unique_ptr<ScriptCompiler::CachedData> data) {
+  if (!data || data->length == 0) return;
+  {
+    base::MutexGuard guard(&mutex_);
+    pending_writes_++;
+  }
+  platform_->CallBlockingTaskOnWorkerThread(
+      std::make_unique<WriteTask>(this, key, std::move(data)));
+}
+
+void CodeCacheDirectory::WaitForPendingWrites() {
+  base::MutexGuard guard(&mutex_);
+  while (pending_writes_ > 0) writes_done_.Wait(&mutex_);
+}
+
+void CodeCacheDirectory::WriteEntry(const Key& key, const uint8_t* data,
+                                    int length) {
+  EntryHeader header = {kEntryMagicNumber,
+                        ScriptCompiler::CachedDataVersionTag(),
+                        key.source_hash, key.source_length,
+                        static_cast<uint32_t>(length)};
+  // Write to a file private to this thread and rename it afterwards, so that
+  // other processes never map a partially written entry.
+  std::string path = EntryPath(key);
+  char suffix[48];
+  base::OS::SNPrintF(suffix, sizeof(suffix), ".%d.%d.tmp",
+                     base::OS::GetCurrentProcessId(),
+                     base::OS::GetCurrentThreadId());
+  std::string temp_path = path + suffix;
+  FILE* file = fopen(temp_path.c_str(), "wb");
+  if (file == nullptr) return;
+  bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 fwrite(data, 1, length, file) == static_cast<size_t>(length);
+  if (fclose(file) != 0) written = false;
+  if (written && rename(temp_path.c_str(), path.c_str()) != 0) {
+    // Windows does not replace existing files.
+    remove(path.c_str());
+    written = rename(temp_path.c_str(), path.c_str()) == 0;
+  }
+  if (!written) remove(temp_path.c_str());
+}
+
+}  // namespace v8
@@ -0,0 +1,76 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_D8_D8_CODE_CACHE_H_
+#define V8_D8_D8_CODE_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "include/v8-platform.h"
+#include "include/v8-script.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+
+namespace v8 {
+
+// Identifies a script in a CodeCacheDirectory.
+struct CodeCacheKey {
+  // Names the file of the entry.
+  uint64_t hash;
+  // Stored in the entry to detect collisions of {hash}.
+  uint64_t source_hash;
+  uint32_t source_length;
+};
+
+// A persistent code cache that stores the output of the code serializer in a
+// directory, one file per script (see --code-cache-dir). Entries are keyed by
+// the script source, its origin and ScriptCompiler::CachedDataVersionTag(),
+// which covers the V8 version and the flags. Entries are memory-mapped when
+// they are consumed and written by background tasks.
+class CodeCacheDirectory {
+ public:
+  using Key = CodeCacheKey;
+
+  CodeCacheDirectory(const char* path, v8::Platform* platform);
+  ~CodeCacheDirectory();
+  CodeCacheDirectory(const CodeCacheDirectory&) = delete;
+  CodeCacheDirectory& operator=(const CodeCacheDirectory&) = delete;
+
+  // Hashes the whole source, so callers should compute the key of a script
+  // once and reuse it.
+  static Key ComputeKey(Isolate* isolate, Local<String> source,
+                        Local<Value> resource_name);
+
+  // Returns the cached data for {key}, or nullptr if there is no valid entry.
+  // The returned data points into {mapping}, which needs to outlive it.
+  ScriptCompiler::CachedData* Lookup(
+      const Key& key, std::unique_ptr<base::OS::MemoryMappedFile>* mapping);
+  // Removes an entry that V8 rejected, e.g. because it was produced with a
+  // different build.
+  void Remove(const Key& key);
+
+  // Writes {data} as the entry for {key} on a background thread. Concurrent
+  // readers either see the old or the new entry, never a partial one.
+  void StoreInBackground(const Key& key,
+                         std::unique_ptr<ScriptCompiler::CachedData> data);
+  void WaitForPendingWrites();
+
+ private:
+  class WriteTask;
+
+  std::string EntryPath(const Key& key) const;
+  void WriteEntry(const Key& key, const uint8_t* data, int length);
+
+  const std::string path_;
+  v8::Platform* const platform_;
+  base::Mutex mutex_;
+  base::ConditionVariable writes_done_;
+  int pending_writes_ = 0;
+};
+
+}  // namespace v8
+
+#endif  // V8_D8_D8_CODE_CACHE_H_
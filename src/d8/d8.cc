@@ -35,6 +35,7 @@
 #include "src/api/api-inl.h"
 #include "src/base/cpu.h"
 #include "src/base/logging.h"
+#include "src/base/optional.h"
 #include "src/base/platform/memory.h"
 #include "src/base/platform/platform.h"
 #include "src/base/platform/time.h"
@@ -43,6 +44,7 @@
 #include "src/base/sys-info.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/compiler-dispatcher/optimizing-compile-dispatcher.h"
+#include "src/d8/d8-code-cache.h"
 #include "src/d8/d8-console.h"
 #include "src/d8/d8-platforms.h"
 #include "src/d8/d8.h"
@@ -513,6 +515,7 @@ std::map<v8::Isolate*, int> Shell::isolate_running_streaming_tasks_;
 base::LazyMutex Shell::cached_code_mutex_;
 std::map<std::string, std::unique_ptr<ScriptCompiler::CachedData>>
     Shell::cached_code_map_;
+std::unique_ptr<CodeCacheDirectory> Shell::code_cache_directory_;
 std::atomic<int> Shell::unhandled_promise_rejections_{0};
 
 Global<Context> Shell::evaluation_context_;
@@ -661,7 +664,10 @@ MaybeLocal<Module> Compile(Local<Context> context,
 template <class T>
 MaybeLocal<T> Shell::CompileString(Isolate* isolate, Local<Context> context,
                                    Local<String> source,
-                                   const ScriptOrigin& origin) {
+                                   const ScriptOrigin& origin,
+                                   const CodeCacheKey* code_cache_key,
+                                   CodeCacheSource* code_cache_source) {
+  if (code_cache_source) *code_cache_source = CodeCacheSource::kNone;
   if (options.streaming_compile) {
     v8::ScriptCompiler::StreamedSource streamed_source(
         std::make_unique<DummySourceStream>(source),
@@ -679,12 +685,31 @@ MaybeLocal<T> Shell::CompileString(Isolate* isolate, Local<Context> context,
   if (options.compile_options == ScriptCompiler::kConsumeCodeCache) {
     cached_code = LookupCodeCache(isolate, source);
   }
+  // Fall back to the persistent cache. Its entries point into {mapping}.
+  std::unique_ptr<base::OS::MemoryMappedFile> mapping;
+  bool from_code_cache_dir = false;
+  if (cached_code == nullptr && code_cache_key != nullptr) {
+    DCHECK_NOT_NULL(code_cache_directory_);
+    DCHECK((std::is_same<T, Script>::value));
+    cached_code = code_cache_directory_->Lookup(*code_cache_key, &mapping);
+    from_code_cache_dir = cached_code != nullptr;
+  }
   ScriptCompiler::Source script_source(source, origin, cached_code);
   MaybeLocal<T> result =
       Compile<T>(context, &script_source,
                  cached_code ? ScriptCompiler::kConsumeCodeCache
                              : ScriptCompiler::kNoCompileOptions);
-  if (cached_code) CHECK(!cached_code->rejected);
+  if (from_code_cache_dir && cached_code->rejected) {
+    // Entries on disk can be stale, e.g. after a snapshot change, so drop
+    // rejected ones and let ExecuteString write a fresh entry.
+    code_cache_directory_->Remove(*code_cache_key);
+  } else if (cached_code) {
+    CHECK(!cached_code->rejected);
+    if (code_cache_source) {
+      *code_cache_source = from_code_cache_dir ? CodeCacheSource::kDirectory
+                                               : CodeCacheSource::kInMemory;
+    }
+  }
   return result;
 }
 
@@ -929,14 +954,27 @@ bool Shell::ExecuteString(Isolate* isolate, Local<String> source,
         GetModuleDataFromContext(realm);
     module_data->origin = ToSTLString(isolate, name);
 
+    // Hashing the source is not free, so compute the key for --code-cache-dir
+    // only once.
+    base::Optional<CodeCacheKey> code_cache_key;
+    if (code_cache_directory_) {
+      code_cache_key = CodeCacheDirectory::ComputeKey(isolate, source, name);
+    }
+    const CodeCacheKey* code_cache_key_ptr =
+        code_cache_key ? &code_cache_key.value() : nullptr;
+
     for (int i = 1; i < options.repeat_compile; ++i) {
       HandleScope handle_scope_for_compiling(isolate);
-      if (CompileString<Script>(isolate, context, source, origin).IsEmpty()) {
+      if (CompileString<Script>(isolate, context, source, origin,
+                                code_cache_key_ptr)
+              .IsEmpty()) {
         return false;
       }
     }
     Local<Script> script;
-    if (!CompileString<Script>(isolate, context, source, origin)
+    CodeCacheSource code_cache_source;
+    if (!CompileString<Script>(isolate, context, source, origin,
+                               code_cache_key_ptr, &code_cache_source)
              .ToLocal(&script)) {
       return false;
     }
@@ -950,7 +988,9 @@ bool Shell::ExecuteString(Isolate* isolate, Local<String> source,
       delete cached_data;
     }
     if (options.compile_only) return true;
-    if (options.compile_options == ScriptCompiler::kConsumeCodeCache) {
+    if (code_cache_source != CodeCacheSource::kNone) {
+      // The code serializer drops the host-defined options, which dynamic
+      // import() needs, so restore them for scripts from either cache.
       i::Handle<i::Script> i_script(
           i::Script::cast(Utils::OpenHandle(*script)->shared()->script()),
           i_isolate);
@@ -967,6 +1007,16 @@ bool Shell::ExecuteString(Isolate* isolate, Local<String> source,
       StoreInCodeCache(isolate, source, cached_data);
       delete cached_data;
     }
+    if (code_cache_key && code_cache_source != CodeCacheSource::kDirectory &&
+        !maybe_result.IsEmpty()) {
+      // The entry was missing or rejected. Serialize after execution so that
+      // the entry includes the functions that were compiled lazily, and write
+      // it in the background.
+      code_cache_directory_->StoreInBackground(
+          *code_cache_key, std::unique_ptr<ScriptCompiler::CachedData>(
+                               ScriptCompiler::CreateCodeCache(
+                                   script->GetUnboundScript())));
+    }
     if (process_message_queue) {
       if (!CompleteMessageLoop(isolate)) success = false;
       if (!HandleUnhandledPromiseRejections(isolate)) success = false;
@@ -3901,6 +3951,9 @@ void Shell::OnExit(v8::Isolate* isolate, bool dispose) {
     FuzzerMonitor::SimulateErrors();
   }
 
+  // Finish writing the persistent code cache before the platform goes away.
+  if (code_cache_directory_) code_cache_directory_->WaitForPendingWrites();
+
   if (dispose) {
     V8::Dispose();
     V8::DisposePlatform();
@@ -4993,6 +5046,9 @@ bool Shell::SetOptions(int argc, char* argv[]) {
         return false;
       }
       argv[i] = nullptr;
+    } else if (strncmp(argv[i], "--code-cache-dir=", 17) == 0) {
+      options.code_cache_dir = argv[i] + 17;
+      argv[i] = nullptr;
     } else if (strcmp(argv[i], "--streaming-compile") == 0) {
       options.streaming_compile = true;
       argv[i] = nullptr;
@@ -5035,6 +5091,12 @@ bool Shell::SetOptions(int argc, char* argv[]) {
     } else if (strncmp(argv[i], "--thread-pool-size=", 19) == 0) {
       options.thread_pool_size = atoi(argv[i] + 19);
       argv[i] = nullptr;
+    } else if (strcmp(argv[i], "--work-stealing") == 0) {
+      options.work_stealing = true;
+      argv[i] = nullptr;
+    } else if (strcmp(argv[i], "--numa") == 0) {
+      options.numa = true;
+      argv[i] = nullptr;
     } else if (strcmp(argv[i], "--stress-delay-tasks") == 0) {
       // Delay execution of tasks by 0-100ms randomly (based on --random-seed).
       options.stress_delay_tasks = true;
@@ -5824,7 +5886,12 @@ int Shell::Main(int argc, char* argv[]) {
         options.thread_pool_size, v8::platform::IdleTaskSupport::kEnabled,
         in_process_stack_dumping, std::move(tracing),
         options.apply_priority ? v8::platform::PriorityMode::kApply
-                               : v8::platform::PriorityMode::kDontApply);
+                               : v8::platform::PriorityMode::kDontApply,
+        options.work_stealing
+            ? v8::platform::WorkerThreadScheduling::kWorkStealing
+            : v8::platform::WorkerThreadScheduling::kSharedQueue,
+        options.numa ? v8::platform::NumaMode::kEnabled
+                     : v8::platform::NumaMode::kDisabled);
   }
   g_default_platform = g_platform.get();
   if (i::v8_flags.predictable) {
@@ -5846,6 +5913,11 @@ int Shell::Main(int argc, char* argv[]) {
   }
   v8::V8::InitializePlatform(g_platform.get());
 
+  if (options.code_cache_dir) {
+    code_cache_directory_ = std::make_unique<CodeCacheDirectory>(
+        options.code_cache_dir, g_platform.get());
+  }
+
   // Disable flag freezing if we are producing a code cache, because for that we
   // modify v8_flags.hash_seed (below).
   if (options.code_cache_options != ShellOptions::kNoProduceCache) {
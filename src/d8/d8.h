@@ -28,6 +28,8 @@ namespace v8 {
 
 class BackingStore;
 class CompiledWasmModule;
+class CodeCacheDirectory;
+struct CodeCacheKey;
 class D8Console;
 class Message;
 class TryCatch;
@@ -445,6 +447,8 @@ class ShellOptions {
       compile_options = {"cache", v8::ScriptCompiler::kNoCompileOptions};
   DisallowReassignment<CodeCacheOptions, true> code_cache_options = {
       "cache", CodeCacheOptions::kNoProduceCache};
+  DisallowReassignment<const char*> code_cache_dir = {"code-cache-dir",
+                                                     nullptr};
   DisallowReassignment<bool> streaming_compile = {"streaming-compile", false};
   DisallowReassignment<SourceGroup*> isolate_sources = {"isolate-sources",
                                                         nullptr};
@@ -462,6 +466,8 @@ class ShellOptions {
   DisallowReassignment<bool> quiet_load = {"quiet-load", false};
   DisallowReassignment<bool> apply_priority = {"apply-priority", true};
   DisallowReassignment<int> thread_pool_size = {"thread-pool-size", 0};
+  DisallowReassignment<bool> work_stealing = {"work-stealing", false};
+  DisallowReassignment<bool> numa = {"numa", false};
   DisallowReassignment<bool> stress_delay_tasks = {"stress-delay-tasks", false};
   std::vector<const char*> arguments;
   DisallowReassignment<bool> include_arguments = {"arguments", true};
@@ -800,10 +806,16 @@ class Shell : public i::AllStatic {
   static MaybeLocal<Value> JSONModuleEvaluationSteps(Local<Context> context,
                                                      Local<Module> module);
 
+  // The code cache that CompileString consumed, if any.
+  enum class CodeCacheSource { kNone, kInMemory, kDirectory };
+
+  // For classic scripts, {code_cache_key} is the key of {source} in the
+  // --code-cache-dir cache, which is only looked up if it is given.
   template <class T>
-  static MaybeLocal<T> CompileString(Isolate* isolate, Local<Context> context,
-                                     Local<String> source,
-                                     const ScriptOrigin& origin);
+  static MaybeLocal<T> CompileString(
+      Isolate* isolate, Local<Context> context, Local<String> source,
+      const ScriptOrigin& origin, const CodeCacheKey* code_cache_key = nullptr,
+      CodeCacheSource* code_cache_source = nullptr);
 
   static ScriptCompiler::CachedData* LookupCodeCache(Isolate* isolate,
                                                      Local<Value> name);
@@ -818,6 +830,8 @@ class Shell : public i::AllStatic {
   static base::LazyMutex cached_code_mutex_;
   static std::map<std::string, std::unique_ptr<ScriptCompiler::CachedData>>
       cached_code_map_;
+  // Set by --code-cache-dir.
+  static std::unique_ptr<CodeCacheDirectory> code_cache_directory_;
   static std::atomic<int> unhandled_promise_rejections_;
 };
 
@@ -4536,8 +4536,17 @@ bool Isolate::Init(SnapshotData* startup_snapshot_data,
   eternal_handles_ = new EternalHandles();
   bootstrapper_ = new Bootstrapper(this);
   handle_scope_implementer_ = new HandleScopeImplementer(this);
-  load_stub_cache_ = new StubCache(this);
-  store_stub_cache_ = new StubCache(this);
+  // The StubCache clamps the size, so only guard against overflowing int.
+  int primary_table_size = v8_flags.stub_cache_entries;
+  if (stub_cache_entries_ != 0) {
+    primary_table_size = static_cast<int>(std::min(
+        stub_cache_entries_,
+        static_cast<size_t>(StubCache::kMaxPrimaryTableSize)));
+  }
+  load_stub_cache_ =
+      new StubCache(this, primary_table_size, v8_flags.stub_cache_ways);
+  store_stub_cache_ =
+      new StubCache(this, primary_table_size, v8_flags.stub_cache_ways);
   materialized_object_store_ = new MaterializedObjectStore(this);
   regexp_stack_ = new RegExpStack();
   date_cache_ = new DateCache();
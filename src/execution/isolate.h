@@ -1954,6 +1954,12 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
   void set_allow_atomics_wait(bool set) { allow_atomics_wait_ = set; }
   bool allow_atomics_wait() { return allow_atomics_wait_; }
 
+  // The number of entries of the primary stub caches, or 0 for the default.
+  void set_stub_cache_entries(size_t entries) {
+    stub_cache_entries_ = entries;
+  }
+  size_t stub_cache_entries() const { return stub_cache_entries_; }
+
   // Register a finalizer to be called at isolate teardown.
   void RegisterManagedPtrDestructor(ManagedPtrDestructor* finalizer);
 
@@ -2541,6 +2547,7 @@ class V8_EXPORT_PRIVATE Isolate final : private HiddenFactory {
       abort_on_uncaught_exception_callback_ = nullptr;
 
   bool allow_atomics_wait_ = true;
+  size_t stub_cache_entries_ = 0;
 
   // Cache for the JavaScriptCompileHintsMagic origin trial.
   // TODO(v8:13917): Remove when the origin trial is removed.
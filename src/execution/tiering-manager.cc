@@ -4,6 +4,12 @@
 
 #include "src/execution/tiering-manager.h"
 
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
 #include "src/base/platform/platform.h"
 #include "src/baseline/baseline.h"
 #include "src/codegen/assembler.h"
@@ -11,21 +17,31 @@
 #include "src/codegen/compiler.h"
 #include "src/codegen/pending-optimization-table.h"
 #include "src/common/globals.h"
+#include "src/compiler-dispatcher/optimizing-compile-dispatcher.h"
+#include "src/deoptimizer/deoptimizer.h"
 #include "src/diagnostics/code-tracer.h"
 #include "src/execution/execution.h"
 #include "src/execution/frames-inl.h"
 #include "src/flags/flags.h"
 #include "src/handles/global-handles.h"
+#include "src/heap/heap.h"
 #include "src/init/bootstrapper.h"
 #include "src/interpreter/interpreter.h"
+#include "src/objects/code-inl.h"
 #include "src/objects/code-kind.h"
-#include "src/objects/code.h"
+#include "src/objects/feedback-vector-inl.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/shared-function-info-inl.h"
 #include "src/tracing/trace-event.h"
 
 #ifdef V8_ENABLE_SPARKPLUG
 #include "src/baseline/baseline-batch-compiler.h"
 #endif  // V8_ENABLE_SPARKPLUG
 
+#ifdef V8_ENABLE_MAGLEV
+#include "src/maglev/maglev-concurrent-dispatcher.h"
+#endif  // V8_ENABLE_MAGLEV
+
 namespace v8 {
 namespace internal {
 
@@ -259,6 +275,31 @@ void TieringManager::RequestOsrAtNextOpportunity(Tagged<JSFunction> function) {
   TryRequestOsrAtNextOpportunity(isolate_, function);
 }
 
+// static
+int TieringManager::CompileQueuePriority(Tagged<JSFunction> function,
+                                         bool is_osr) {
+  if (is_osr) return kOsrCompileQueuePriority;
+  if (!function->has_feedback_vector()) return 0;
+  // Stay below OSR jobs when a queued job is reprioritized.
+  return std::min(function->feedback_vector()->invocation_count(kRelaxedLoad),
+                  kOsrCompileQueuePriority - 1);
+}
+
+void TieringManager::ReprioritizeQueuedJobs(Tagged<JSFunction> function) {
+  DisallowGarbageCollection no_gc;
+  // Only raises priorities, so queued OSR jobs keep theirs.
+  const int priority = CompileQueuePriority(function, false);
+#ifdef V8_ENABLE_MAGLEV
+  if (isolate_->maglev_concurrent_dispatcher()->is_enabled()) {
+    isolate_->maglev_concurrent_dispatcher()->Reprioritize(function, priority);
+  }
+#endif  // V8_ENABLE_MAGLEV
+  if (isolate_->concurrent_recompilation_enabled()) {
+    isolate_->optimizing_compile_dispatcher()->Reprioritize(function,
+                                                             priority);
+  }
+}
+
 void TieringManager::MaybeOptimizeFrame(Tagged<JSFunction> function,
                                         CodeKind current_code_kind) {
   const TieringState tiering_state =
@@ -272,6 +313,9 @@ void TieringManager::MaybeOptimizeFrame(Tagged<JSFunction> function,
     // Note: This effectively disables further tiering actions (e.g. OSR, or
     // tiering up into Maglev) for the function while it is being compiled.
     TraceInOptimizationQueue(function, current_code_kind);
+    // The function exhausted another interrupt budget while its compile job
+    // is waiting; move the job ahead of colder ones.
+    ReprioritizeQueuedJobs(function);
     return;
   }
 
@@ -328,6 +372,15 @@ void TieringManager::MaybeOptimizeFrame(Tagged<JSFunction> function,
     }
   }
 
+  // Skip Maglev for functions that an imported profile saw in Turbofan.
+  if (V8_UNLIKELY(has_profile()) && d.should_optimize() &&
+      d.code_kind == CodeKind::MAGLEV) {
+    const ProfileEntry* entry = FindProfileEntry(function->shared());
+    if (entry && entry->tier == CodeKind::TURBOFAN) {
+      d = ShouldOptimize(function->feedback_vector(), CodeKind::MAGLEV);
+    }
+  }
+
   if (d.should_optimize()) Optimize(function, d);
 }
 
@@ -367,6 +420,15 @@ void TieringManager::NotifyICChanged(Tagged<FeedbackVector> vector) {
     int bytecode_length = shared->GetBytecodeArray(isolate_)->length();
     Tagged<FeedbackCell> cell = vector->parent_feedback_cell();
     int invocations = v8_flags.minimum_invocations_after_ic_update;
+    if (V8_UNLIKELY(has_profile())) {
+      // Feedback of a function that an imported profile saw optimized is
+      // still warming up; don't let that delay the early tier-up.
+      const ProfileEntry* entry = FindProfileEntry(shared);
+      if (entry && entry->tier >= CodeKind::MAGLEV) {
+        invocations = std::min(invocations,
+                               v8_flags.invocation_count_for_profiled_tierup);
+      }
+    }
     int bytecodes = std::min(bytecode_length, (kMaxInt >> 1) / invocations);
     int new_budget = invocations * bytecodes;
     int current_budget = cell->interrupt_budget();
@@ -415,6 +477,7 @@ void TieringManager::OnInterruptTick(Handle<JSFunction> function,
     // OSR. When we OSR functions with lazy feedback allocation we want to have
     // a non zero invocation count so we can inline functions.
     function->feedback_vector()->set_invocation_count(1, kRelaxedStore);
+    ApplyProfile(function);
   }
 
   DCHECK(function->has_feedback_vector());
@@ -477,5 +540,367 @@ void TieringManager::OnInterruptTick(Handle<JSFunction> function,
   function->SetInterruptBudget(isolate_);
 }
 
+namespace {
+
+constexpr char kProfileHeader[] = "v8-jit-profile 1";
+
+std::string ProfileKey(Tagged<String> script_hash,
+                       Tagged<SharedFunctionInfo> shared) {
+  return std::string(script_hash->ToCString().get()) + " " +
+         std::to_string(shared->StartPosition()) + " " +
+         std::to_string(shared->EndPosition());
+}
+
+CodeKind ReachedTier(Tagged<FeedbackVector> vector) {
+  if (vector->has_optimized_code()) return vector->optimized_code()->kind();
+  if (vector->maybe_has_turbofan_code()) return CodeKind::TURBOFAN;
+  if (vector->maybe_has_maglev_code()) return CodeKind::MAGLEV;
+  if (vector->shared_function_info()->HasBaselineCode()) {
+    return CodeKind::BASELINE;
+  }
+  return CodeKind::INTERPRETED_FUNCTION;
+}
+
+bool ParseTier(const std::string& name, CodeKind* tier) {
+  for (CodeKind kind :
+       {CodeKind::INTERPRETED_FUNCTION, CodeKind::BASELINE, CodeKind::MAGLEV,
+        CodeKind::TURBOFAN}) {
+    if (name == CodeKindToString(kind)) {
+      *tier = kind;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t CodeCacheHintKey(Tagged<Script> script,
+                          Tagged<SharedFunctionInfo> shared) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(script->id())) << 32) |
+         static_cast<uint32_t>(shared->function_literal_id());
+}
+
+}  // namespace
+
+const TieringManager::ProfileEntry* TieringManager::FindProfileEntry(
+    Tagged<SharedFunctionInfo> shared) {
+  Tagged<Object> script = shared->script();
+  if (!IsScript(script)) return nullptr;
+  if (!code_cache_hints_.empty()) {
+    auto it =
+        code_cache_hints_.find(CodeCacheHintKey(Script::cast(script), shared));
+    if (it != code_cache_hints_.end()) return &it->second;
+  }
+  if (profile_.empty()) return nullptr;
+  Tagged<Object> hash = Script::cast(script)->source_hash();
+  if (!IsString(hash) || String::cast(hash)->length() == 0) return nullptr;
+  auto it = profile_.find(ProfileKey(String::cast(hash), shared));
+  return it == profile_.end() ? nullptr : &it->second;
+}
+
+void TieringManager::ApplyProfile(Handle<JSFunction> function) {
+  if (V8_LIKELY(!has_profile())) return;
+  if (!IsScript(function->shared()->script())) return;
+  if (!profile_.empty()) {
+    // Computes the script hash once, FindProfileEntry() relies on it.
+    Script::GetScriptHash(
+        isolate_, handle(Script::cast(function->shared()->script()), isolate_),
+        false);
+  }
+
+  DisallowGarbageCollection no_gc;
+  Tagged<SharedFunctionInfo> shared = function->shared();
+  const ProfileEntry* entry = FindProfileEntry(shared);
+  if (!entry || entry->tier < CodeKind::MAGLEV) return;
+  // A different feedback layout means the function changed.
+  if (entry->slot_count != function->feedback_vector()->length()) return;
+  const int bytecode_length = shared->GetBytecodeArray(isolate_)->length();
+  if (bytecode_length > v8_flags.max_optimized_bytecode_size) return;
+
+  const int invocations = v8_flags.invocation_count_for_profiled_tierup;
+  const int budget =
+      invocations * std::min(bytecode_length, (kMaxInt >> 1) / invocations);
+  Tagged<FeedbackCell> cell = function->raw_feedback_cell();
+  if (budget >= cell->interrupt_budget()) return;
+  if (v8_flags.trace_opt_verbose) {
+    PrintF("[shortening interrupt budget of %s, profiled as %s]\n",
+           shared->DebugNameCStr().get(), CodeKindToString(entry->tier));
+  }
+  cell->set_interrupt_budget(budget);
+}
+
+void TieringManager::AddCodeCacheHint(Tagged<Script> script,
+                                      Tagged<SharedFunctionInfo> shared,
+                                      CodeKind tier) {
+  DCHECK(CodeKindIsOptimizedJSFunction(tier));
+  if (!shared->HasFeedbackMetadata()) return;
+  ProfileEntry& entry = code_cache_hints_[CodeCacheHintKey(script, shared)];
+  entry.tier = tier;
+  entry.slot_count = shared->feedback_metadata()->slot_count();
+}
+
+std::string TieringManager::ExportProfile() {
+  HandleScope scope(isolate_);
+  std::vector<Handle<FeedbackVector>> vectors;
+  {
+    HeapObjectIterator iterator(isolate_->heap());
+    for (Tagged<HeapObject> object = iterator.Next(); !object.is_null();
+         object = iterator.Next()) {
+      if (!IsFeedbackVector(object)) continue;
+      vectors.push_back(handle(FeedbackVector::cast(object), isolate_));
+    }
+  }
+
+  // Closures of the same function in different contexts have separate
+  // vectors; merge them. Ordered to keep the output deterministic.
+  std::map<std::string, ProfileEntry> entries;
+  for (Handle<FeedbackVector> vector : vectors) {
+    if (!IsScript(vector->shared_function_info()->script())) continue;
+    Handle<String> script_hash = Script::GetScriptHash(
+        isolate_,
+        handle(Script::cast(vector->shared_function_info()->script()),
+               isolate_),
+        false);
+    if (script_hash->length() == 0) continue;
+
+    DisallowGarbageCollection no_gc;
+    ProfileEntry& entry =
+        entries[ProfileKey(*script_hash, vector->shared_function_info())];
+    entry.tier = std::max(entry.tier, ReachedTier(*vector));
+    entry.invocation_count += vector->invocation_count(kRelaxedLoad);
+    entry.slot_count = vector->length();
+    int monomorphic = 0, polymorphic = 0, megamorphic = 0;
+    FeedbackMetadataIterator iter(vector->metadata());
+    while (iter.HasNext()) {
+      switch (FeedbackNexus(*vector, iter.Next()).ic_state()) {
+        case InlineCacheState::MONOMORPHIC:
+          monomorphic++;
+          break;
+        case InlineCacheState::POLYMORPHIC:
+          polymorphic++;
+          break;
+        case InlineCacheState::MEGAMORPHIC:
+          megamorphic++;
+          break;
+        default:
+          break;
+      }
+    }
+    entry.monomorphic_ics = std::max(entry.monomorphic_ics, monomorphic);
+    entry.polymorphic_ics = std::max(entry.polymorphic_ics, polymorphic);
+    entry.megamorphic_ics = std::max(entry.megamorphic_ics, megamorphic);
+  }
+
+  std::string profile = std::string(kProfileHeader) + "\n";
+  for (const auto& [key, entry] : entries) {
+    profile += std::string(CodeKindToString(entry.tier)) + " " +
+               std::to_string(entry.invocation_count) + " " +
+               std::to_string(entry.slot_count) + " " +
+               std::to_string(entry.monomorphic_ics) + " " +
+               std::to_string(entry.polymorphic_ics) + " " +
+               std::to_string(entry.megamorphic_ics) + " " + key + "\n";
+  }
+  return profile;
+}
+
+bool TieringManager::ImportProfile(const std::string& profile) {
+  std::istringstream lines(profile);
+  std::string line;
+  if (!std::getline(lines, line) || line != kProfileHeader) return false;
+
+  std::unordered_map<std::string, ProfileEntry> entries;
+  while (std::getline(lines, line)) {
+    if (line.empty()) continue;
+    std::istringstream fields(line);
+    std::string tier;
+    ProfileEntry entry;
+    if (!(fields >> tier >> entry.invocation_count >> entry.slot_count >>
+          entry.monomorphic_ics >> entry.polymorphic_ics >>
+          entry.megamorphic_ics) ||
+        !ParseTier(tier, &entry.tier)) {
+      return false;
+    }
+    std::string key;
+    fields >> std::ws;
+    if (!std::getline(fields, key) || key.empty()) return false;
+    entries[key] = entry;
+  }
+  for (const auto& [key, entry] : entries) profile_[key] = entry;
+  return true;
+}
+
+namespace {
+
+std::unique_ptr<Address*> NewWeakHandle(Isolate* isolate,
+                                        Tagged<HeapObject> object) {
+  auto location = std::make_unique<Address*>(
+      isolate->global_handles()->Create(object).location());
+  GlobalHandles::MakeWeak(location.get());
+  return location;
+}
+
+void DestroyWeakHandle(const std::unique_ptr<Address*>& location) {
+  if (*location != nullptr) GlobalHandles::Destroy(*location);
+}
+
+void TraceTierDown(Isolate* isolate, Tagged<JSFunction> function,
+                   Tagged<Code> code, size_t total, size_t budget) {
+  if (v8_flags.trace_opt) {
+    CodeTracer::Scope scope(isolate->GetCodeTracer());
+    PrintF(scope.file(), "[tiering down ");
+    ShortPrint(function, scope.file());
+    PrintF(scope.file(),
+           " from %s, reason: optimized code budget exceeded (%zu > %zu "
+           "bytes)]\n",
+           CodeKindToString(code->kind()), total, budget);
+  }
+}
+
+}  // namespace
+
+TieringManager::~TieringManager() {
+  for (const OptimizedCodeEntry& entry : optimized_code_) {
+    DestroyWeakHandle(entry.function);
+    DestroyWeakHandle(entry.code);
+  }
+  for (const std::unique_ptr<Address*>& function : tiered_down_functions_) {
+    DestroyWeakHandle(function);
+  }
+}
+
+void TieringManager::OnOptimizedCodeInstalled(Tagged<JSFunction> function,
+                                              Tagged<Code> code,
+                                              bool is_osr) {
+  if (optimized_code_budget_ == 0) return;
+  DCHECK(CodeKindIsOptimizedJSFunction(code->kind()));
+  DCHECK(function->has_feedback_vector());
+  OptimizedCodeEntry entry;
+  entry.function = NewWeakHandle(isolate_, function);
+  entry.code = NewWeakHandle(isolate_, code);
+  entry.size = code->SizeIncludingMetadata();
+  entry.is_osr = is_osr;
+  entry.invocation_count =
+      function->feedback_vector()->invocation_count(kRelaxedLoad);
+  entry.interrupt_budget = function->raw_feedback_cell()->interrupt_budget();
+  entry.last_used = optimized_code_clock_;
+  // A function that tiered up again after being deoptimized for the budget is
+  // hot, even if its optimized code shows no sign of use.
+  for (auto it = tiered_down_functions_.begin();
+       it != tiered_down_functions_.end(); ++it) {
+    if (**it != nullptr && *Handle<JSFunction>(**it) == function) {
+      DestroyWeakHandle(*it);
+      tiered_down_functions_.erase(it);
+      entry.reoptimized = true;
+      break;
+    }
+  }
+  optimized_code_.push_back(std::move(entry));
+  EnforceOptimizedCodeBudget(function);
+}
+
+void TieringManager::EnforceOptimizedCodeBudget(Tagged<JSFunction> installed) {
+  DisallowGarbageCollection no_gc;
+  const uint64_t now = ++optimized_code_clock_;
+
+  // Drop entries whose code died or was replaced, and mark functions that ran
+  // since the last check as used. Optimized code does not bump the invocation
+  // count, but lower tiers do, and Maglev code consumes interrupt budget.
+  size_t total = 0;
+  size_t live = 0;
+  for (size_t i = 0; i < optimized_code_.size(); ++i) {
+    OptimizedCodeEntry& entry = optimized_code_[i];
+    bool installed_entry = i == optimized_code_.size() - 1;
+    bool alive = *entry.function != nullptr && *entry.code != nullptr;
+    if (alive) {
+      Tagged<JSFunction> function = *Handle<JSFunction>(*entry.function);
+      Tagged<Code> code = *Handle<Code>(*entry.code);
+      // Non-OSR code is installed on the function by the caller, after this
+      // check for the entry that was just added.
+      alive = !code->marked_for_deoptimization() &&
+              (entry.is_osr || installed_entry || function->code() == code);
+    }
+    if (!alive) {
+      DestroyWeakHandle(entry.function);
+      DestroyWeakHandle(entry.code);
+      continue;
+    }
+    Tagged<JSFunction> function = *Handle<JSFunction>(*entry.function);
+    int invocation_count =
+        function->feedback_vector()->invocation_count(kRelaxedLoad);
+    int interrupt_budget = function->raw_feedback_cell()->interrupt_budget();
+    if (invocation_count != entry.invocation_count ||
+        interrupt_budget != entry.interrupt_budget) {
+      entry.invocation_count = invocation_count;
+      entry.interrupt_budget = interrupt_budget;
+      entry.last_used = now;
+    }
+    total += entry.size;
+    if (live != i) optimized_code_[live] = std::move(entry);
+    ++live;
+  }
+  optimized_code_.erase(optimized_code_.begin() + live, optimized_code_.end());
+  if (total <= optimized_code_budget_) return;
+
+  // TurboFan code neither bumps the invocation count nor consumes interrupt
+  // budget, so sample the functions that are running right now as well. This
+  // walks the stack, so it is only done when code has to be evicted.
+  std::unordered_set<Address> on_stack;
+  for (JavaScriptStackFrameIterator it(isolate_); !it.done(); it.Advance()) {
+    on_stack.insert(it.frame()->function().ptr());
+  }
+  for (OptimizedCodeEntry& entry : optimized_code_) {
+    if (on_stack.count((*Handle<JSFunction>(*entry.function)).ptr()) != 0) {
+      entry.last_used = now;
+    }
+  }
+
+  tiered_down_functions_.erase(
+      std::remove_if(tiered_down_functions_.begin(),
+                     tiered_down_functions_.end(),
+                     [](const std::unique_ptr<Address*>& function) {
+                       return *function == nullptr;
+                     }),
+      tiered_down_functions_.end());
+
+  // Functions that were reoptimized after a tier-down last, then least
+  // recently used first; among those, the least invoked first.
+  std::vector<OptimizedCodeEntry*> candidates;
+  for (OptimizedCodeEntry& entry : optimized_code_) {
+    if (*Handle<JSFunction>(*entry.function) == installed) continue;
+    candidates.push_back(&entry);
+  }
+  std::stable_sort(
+      candidates.begin(), candidates.end(),
+      [](const OptimizedCodeEntry* a, const OptimizedCodeEntry* b) {
+        if (a->reoptimized != b->reoptimized) return !a->reoptimized;
+        if (a->last_used != b->last_used) return a->last_used < b->last_used;
+        return a->invocation_count < b->invocation_count;
+      });
+  // Mark the code of all victims first and deoptimize it together, since
+  // every deoptimization walks the stacks.
+  bool any_marked = false;
+  for (OptimizedCodeEntry* entry : candidates) {
+    if (total <= optimized_code_budget_) break;
+    Tagged<JSFunction> function = *Handle<JSFunction>(*entry->function);
+    Tagged<Code> code = *Handle<Code>(*entry->code);
+    // Closures can share code, which is then only marked once.
+    if (code->marked_for_deoptimization()) {
+      total -= entry->size;
+      continue;
+    }
+    TraceTierDown(isolate_, function, code, total, optimized_code_budget_);
+    code->set_marked_for_deoptimization(true);
+    // The code may also be cached in the feedback vector.
+    function->feedback_vector()->EvictOptimizedCodeMarkedForDeoptimization(
+        isolate_, function->shared(), "evicted for optimized code budget");
+    any_marked = true;
+    total -= entry->size;
+    if (!entry->is_osr) {
+      tiered_down_functions_.push_back(NewWeakHandle(isolate_, function));
+    }
+  }
+  if (any_marked) Deoptimizer::DeoptimizeMarkedCode(isolate_);
+  // Entries of deoptimized code are dropped on the next check.
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -5,20 +5,28 @@
 #ifndef V8_EXECUTION_TIERING_MANAGER_H_
 #define V8_EXECUTION_TIERING_MANAGER_H_
 
+#include <memory>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "src/common/assert-scope.h"
+#include "src/flags/flags.h"
 #include "src/handles/handles.h"
+#include "src/objects/code-kind.h"
 #include "src/utils/allocation.h"
 
 namespace v8 {
 namespace internal {
 
 class BytecodeArray;
+class Code;
 class Isolate;
 class JSFunction;
 class OptimizationDecision;
-enum class CodeKind : uint8_t;
+class Script;
+class SharedFunctionInfo;
 enum class OptimizationReason : uint8_t;
 
 void TraceManualRecompile(Tagged<JSFunction> function, CodeKind code_kind,
@@ -26,7 +34,10 @@ void TraceManualRecompile(Tagged<JSFunction> function, CodeKind code_kind,
 
 class TieringManager {
  public:
-  explicit TieringManager(Isolate* isolate) : isolate_(isolate) {}
+  explicit TieringManager(Isolate* isolate)
+      : isolate_(isolate),
+        optimized_code_budget_(v8_flags.optimized_code_budget * KB) {}
+  ~TieringManager();
 
   void OnInterruptTick(Handle<JSFunction> function, CodeKind code_kind);
 
@@ -42,11 +53,91 @@ class TieringManager {
 
   void MarkForTurboFanOptimization(Tagged<JSFunction> function);
 
+  // Returns the priority of a compile job for |function| in the concurrent
+  // Maglev and TurboFan compile queues: its hotness, so that the hottest
+  // functions compile first. OSR jobs come before all others, as their
+  // function is stuck in a loop and usually has a low invocation count.
+  static int CompileQueuePriority(Tagged<JSFunction> function, bool is_osr);
+  static constexpr int kOsrCompileQueuePriority = kMaxInt;
+
+  // Returns the tier reached, invocation count and IC states of every function
+  // with a feedback vector, keyed by script hash and source range.
+  std::string ExportProfile();
+
+  // Imports a profile returned by ExportProfile(), possibly in an earlier
+  // process. Functions the profile saw optimized tier up early. Returns false
+  // if |profile| is malformed.
+  bool ImportProfile(const std::string& profile);
+
+  // Treats |shared| like a function that an imported profile saw reach |tier|.
+  // Used for functions deserialized from a code cache that was produced while
+  // they were optimized.
+  void AddCodeCacheHint(Tagged<Script> script,
+                        Tagged<SharedFunctionInfo> shared, CodeKind tier);
+
+  // Accounts for optimized |code| that was just installed for |function|
+  // against the optimized code budget. If the budget is exceeded, the least
+  // recently used optimized functions are deoptimized until it is met again.
+  void OnOptimizedCodeInstalled(Tagged<JSFunction> function, Tagged<Code> code,
+                                bool is_osr);
+
+  // Maximum size in bytes of the optimized code installed in this isolate, or
+  // 0 if unlimited. Only code installed while a budget is set is accounted.
+  size_t optimized_code_budget() const { return optimized_code_budget_; }
+  void set_optimized_code_budget(size_t bytes) {
+    optimized_code_budget_ = bytes;
+  }
+
  private:
+  struct ProfileEntry {
+    CodeKind tier = CodeKind::INTERPRETED_FUNCTION;
+    int invocation_count = 0;
+    int slot_count = 0;
+    int monomorphic_ics = 0;
+    int polymorphic_ics = 0;
+    int megamorphic_ics = 0;
+  };
+
+  bool has_profile() const {
+    return !profile_.empty() || !code_cache_hints_.empty();
+  }
+
+  struct OptimizedCodeEntry {
+    // Weak global handles, cleared by the GC when the object dies. Boxed so
+    // that their address stays stable when the entry moves.
+    std::unique_ptr<Address*> function;
+    std::unique_ptr<Address*> code;
+    int size = 0;
+    bool is_osr = false;
+    // Whether |function| got hot again after the budget deoptimized it. Such
+    // functions are only deoptimized when no other candidate is left.
+    bool reoptimized = false;
+    // Invocation count and interrupt budget of |function| when it was last
+    // seen running, and the value of |optimized_code_clock_| at that point.
+    int invocation_count = 0;
+    int interrupt_budget = 0;
+    uint64_t last_used = 0;
+  };
+
+  // Deoptimizes the least recently used optimized functions other than
+  // |installed| until the installed optimized code fits in the budget.
+  void EnforceOptimizedCodeBudget(Tagged<JSFunction> installed);
+
+  // Looks up the code cache hint or imported profile entry of |shared|. Only
+  // finds profiled functions whose script hash has already been computed, see
+  // ApplyProfile().
+  const ProfileEntry* FindProfileEntry(Tagged<SharedFunctionInfo> shared);
+  // Shortens the interrupt budget of a function that just got its feedback
+  // vector if the profile saw it optimized.
+  void ApplyProfile(Handle<JSFunction> function);
+
   // Make the decision whether to optimize the given function, and mark it for
   // optimization if the decision was 'yes'.
   // This function is also responsible for bumping the OSR urgency.
   void MaybeOptimizeFrame(Tagged<JSFunction> function, CodeKind code_kind);
+  // Raises the priority of |function|'s queued concurrent compile jobs to its
+  // current hotness.
+  void ReprioritizeQueuedJobs(Tagged<JSFunction> function);
 
   // After next tick indicates whether we've precremented the ticks before
   // calling this function, or whether we're pretending that we already got the
@@ -65,6 +156,19 @@ class TieringManager {
   };
 
   Isolate* const isolate_;
+
+  std::unordered_map<std::string, ProfileEntry> profile_;
+  // Keyed by script id and function literal id.
+  std::unordered_map<uint64_t, ProfileEntry> code_cache_hints_;
+
+  size_t optimized_code_budget_;
+  // Optimized code installed while a budget was set, in installation order.
+  std::vector<OptimizedCodeEntry> optimized_code_;
+  // Weak handles to the functions the budget deoptimized.
+  std::vector<std::unique_ptr<Address*>> tiered_down_functions_;
+  // Advanced on every budget check; used to order |optimized_code_| by
+  // recency of use.
+  uint64_t optimized_code_clock_ = 0;
 };
 
 }  // namespace internal
@@ -752,6 +752,9 @@ DEFINE_BOOL(trace_pretenuring, false,
             "trace pretenuring decisions of HAllocate instructions")
 DEFINE_BOOL(trace_pretenuring_statistics, false,
             "trace allocation site pretenuring statistics")
+DEFINE_BOOL(allocation_site_lifetime_histograms, false,
+            "record survival histograms of allocation sites for exporting "
+            "pretenuring feedback (see Isolate::ExportPretenuringFeedback)")
 DEFINE_BOOL(track_field_types, true, "track field types")
 DEFINE_BOOL(trace_block_coverage, false,
             "trace collected block coverage information")
@@ -803,6 +806,13 @@ DEFINE_INT(osr_to_tierup, 1,
            "number to decrease the invocation budget by when we follow OSR")
 DEFINE_INT(minimum_invocations_after_ic_update, 500,
            "How long to minimally wait after IC update before tier up")
+DEFINE_INT(invocation_count_for_profiled_tierup, 50,
+           "invocation count required for optimizing functions that an "
+           "imported JIT profile saw optimized")
+DEFINE_SIZE_T(optimized_code_budget, 0,
+              "per-isolate limit in KB on installed optimized code; when it "
+              "is exceeded, the least recently used optimized functions are "
+              "deoptimized (0 means unlimited)")
 DEFINE_INT(minimum_invocations_before_optimization, 2,
            "Minimum number of invocations we need before non-OSR optimization")
 
@@ -830,6 +840,12 @@ DEFINE_VALUE_IMPLICATION(jit_fuzzing, minimum_invocations_after_ic_update, 5)
 // Flags for inline caching and feedback vectors.
 DEFINE_BOOL(use_ic, true, "use inline caching")
 DEFINE_BOOL(lazy_feedback_allocation, true, "Allocate feedback vectors lazily")
+DEFINE_INT(stub_cache_entries, 0,
+           "number of entries of the primary megamorphic stub caches, "
+           "rounded up to a power of two (0 for the default)")
+DEFINE_INT(stub_cache_ways, 1,
+           "number of ways of the sets of the primary megamorphic stub "
+           "caches (1, 2 or 4), replaced in insertion order")
 
 // Flags for Ignition.
 DEFINE_BOOL(ignition_elide_noneffectful_bytecodes, true,
@@ -900,7 +916,6 @@ DEFINE_BOOL_READONLY(concurrent_sparkplug, false,
 #else
 DEFINE_BOOL(concurrent_sparkplug, ENABLE_SPARKPLUG_BY_DEFAULT,
             "compile Sparkplug code in a background thread")
-DEFINE_WEAK_IMPLICATION(future, concurrent_sparkplug)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_sparkplug)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_sparkplug)
 DEFINE_NEG_IMPLICATION(jitless, concurrent_sparkplug)
@@ -1557,6 +1572,15 @@ DEFINE_SIZE_T(max_semi_space_size, 0,
               "max size of a semi-space (in MBytes), the new space consists of "
               "two semi-spaces")
 DEFINE_INT(semi_space_growth_factor, 2, "factor by which to grow the new space")
+DEFINE_BOOL(young_generation_controller, false,
+            "size the young generation for --scavenge-pause-target-ms and "
+            "--young-generation-throughput-target instead of growing it by "
+            "--semi-space-growth-factor")
+DEFINE_FLOAT(scavenge_pause_target_ms, 1.0,
+             "scavenge pause the young generation controller sizes for")
+DEFINE_FLOAT(young_generation_throughput_target, 0.97,
+             "fraction of the time outside of scavenges the young generation "
+             "controller sizes for")
 DEFINE_SIZE_T(max_old_space_size, 0, "max size of the old space (in Mbytes)")
 DEFINE_SIZE_T(
     max_heap_size, 0,
@@ -1671,6 +1695,9 @@ DEFINE_BOOL(concurrent_array_buffer_sweeping, true,
             "concurrently sweep array buffers")
 DEFINE_BOOL(stress_concurrent_allocation, false,
             "start background threads that allocate memory")
+DEFINE_BOOL(concurrent_allocation_free_list_cache, true,
+            "cache free-list memory in background allocators to refill LABs "
+            "without locking the space")
 DEFINE_BOOL(parallel_marking, true, "use parallel marking in atomic pause")
 DEFINE_INT(ephemeron_fixpoint_iterations, 10,
            "number of fixpoint iterations it takes to switch to linear "
@@ -1684,6 +1711,13 @@ DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
 DEFINE_BOOL(parallel_weak_ref_clearing, true,
             "use parallel threads to clear weak refs in the atomic pause.")
+DEFINE_BOOL(numa_aware_heap, false,
+            "prefer memory from the allocating thread's NUMA node for heap "
+            "pages and let parallel scavenging and evacuation prefer pages "
+            "on the worker's own node")
+DEFINE_BOOL(huge_pages, false,
+            "back the code range and the pointer compression cage with "
+            "transparent huge pages where supported")
 DEFINE_BOOL(detect_ineffective_gcs_near_heap_limit, true,
             "trigger out-of-memory failure to avoid GC storm near heap limit")
 DEFINE_BOOL(trace_incremental_marking, false,
@@ -1757,6 +1791,11 @@ DEFINE_BOOL(compact_code_space, true,
             "Perform code space compaction on full collections.")
 DEFINE_BOOL(compact_on_every_full_gc, false,
             "Perform compaction on every full GC")
+DEFINE_INT(compaction_pause_budget_ms, 0,
+           "Limit the time spent evacuating pages in the atomic pause of a "
+           "full GC, based on the measured compaction speed. Fragmented pages "
+           "that do not fit are compacted in later GCs. 0 keeps the default "
+           "limit.")
 DEFINE_BOOL(compact_with_stack, true,
             "Perform compaction when finalizing a full GC with stack")
 DEFINE_BOOL(
@@ -2154,6 +2193,13 @@ DEFINE_BOOL(log_maps, false, "Log map creation")
 DEFINE_BOOL(log_maps_details, true, "Also log map details")
 DEFINE_IMPLICATION(log_maps, log_code)
 
+// json-stringifier.cc
+DEFINE_BOOL(parallel_json_stringify, false,
+            "serialize large arrays of plain data on background threads in "
+            "JSON.stringify")
+DEFINE_UINT(parallel_json_stringify_min_length, 8192,
+            "minimum array length for parallel JSON.stringify")
+
 // parser.cc
 DEFINE_BOOL(allow_natives_syntax, false, "allow natives syntax")
 DEFINE_BOOL(allow_natives_for_differential_fuzzing, false,
@@ -2281,6 +2327,11 @@ DEFINE_BOOL(profile_deserialization, false,
             "Print the time it takes to deserialize the snapshot.")
 DEFINE_BOOL(serialization_statistics, false,
             "Collect statistics on serialized objects.")
+DEFINE_BOOL(code_cache_tiering_hints, false,
+            "Record which functions were optimized in code caches and tier "
+            "them up early after deserialization. Creating a cache walks the "
+            "heap. Only the protectors the optimized code depended on are "
+            "revalidated, not its other dependencies such as maps.")
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
 DEFINE_BOOL(regexp_interpret_all, false, "interpret all regexp code")
@@ -2778,6 +2829,7 @@ DEFINE_NEG_IMPLICATION(single_threaded, lazy_compile_dispatcher)
 DEFINE_NEG_IMPLICATION(single_threaded,
                        parallel_compile_tasks_for_eager_toplevel)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_compile_tasks_for_lazy)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_json_stringify)
 #ifdef V8_ENABLE_MAGLEV
 DEFINE_NEG_IMPLICATION(single_threaded, maglev_deopt_data_on_background)
 DEFINE_NEG_IMPLICATION(single_threaded, maglev_build_code_on_background)
@@ -6,12 +6,22 @@
 #define V8_HEAP_BASE_BASIC_SLOT_SET_H_
 
 #include <cstddef>
+#include <cstring>
 #include <memory>
 
 #include "src/base/atomic-utils.h"
 #include "src/base/bits.h"
 #include "src/base/platform/memory.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define V8_SLOT_SET_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define V8_SLOT_SET_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace heap {
 namespace base {
 
@@ -318,6 +328,22 @@ class BasicSlotSet {
       v8::base::AsAtomic32::Release_Store(cell(cell_index), value);
     }
 
+    // Returns a mask with bit i set if cell i is not empty. In ATOMIC mode the
+    // cells are first copied with relaxed loads, so cells that concurrent
+    // writers fill in afterwards may be missed, as they may be when loading
+    // the cells one by one.
+    template <AccessMode access_mode = AccessMode::ATOMIC>
+    uint32_t NonEmptyCells() const {
+      if constexpr (access_mode == AccessMode::ATOMIC) {
+        uint32_t cells[kCellsPerBucket];
+        for (int i = 0; i < kCellsPerBucket; i++) {
+          cells[i] = v8::base::AsAtomic32::Relaxed_Load(cell(i));
+        }
+        return NonEmptyCellsIn(cells);
+      }
+      return NonEmptyCellsIn(cells_);
+    }
+
     bool IsEmpty() const {
       for (int i = 0; i < kCellsPerBucket; i++) {
         if (cells_[i] != 0) {
@@ -326,6 +352,41 @@ class BasicSlotSet {
       }
       return true;
     }
+
+   private:
+    // Tests several cells at once, so |cells| must not change concurrently.
+    static uint32_t NonEmptyCellsIn(const uint32_t* cells) {
+      uint32_t mask = 0;
+#if defined(V8_SLOT_SET_USE_SSE2)
+      const __m128i zero = _mm_setzero_si128();
+      for (int i = 0; i < kCellsPerBucket; i += 4) {
+        const __m128i values =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + i));
+        // One bit per cell that is zero.
+        const int empty = _mm_movemask_ps(
+            _mm_castsi128_ps(_mm_cmpeq_epi32(values, zero)));
+        mask |= static_cast<uint32_t>(~empty & 0xf) << i;
+      }
+#elif defined(V8_SLOT_SET_USE_NEON)
+      static constexpr uint32_t kLaneBits[] = {1, 2, 4, 8};
+      const uint32x4_t lane_bits = vld1q_u32(kLaneBits);
+      for (int i = 0; i < kCellsPerBucket; i += 4) {
+        const uint32x4_t values = vld1q_u32(cells + i);
+        const uint32x4_t non_empty =
+            vandq_u32(vtstq_u32(values, values), lane_bits);
+        mask |= vaddvq_u32(non_empty) << i;
+      }
+#else
+      for (int i = 0; i < kCellsPerBucket; i += 2) {
+        uint64_t pair;
+        memcpy(&pair, cells + i, sizeof(pair));
+        if (pair == 0) continue;
+        mask |= static_cast<uint32_t>(cells[i] != 0) << i;
+        mask |= static_cast<uint32_t>(cells[i + 1] != 0) << (i + 1);
+      }
+#endif
+      return mask;
+    }
   };
 
  protected:
@@ -339,28 +400,16 @@ class BasicSlotSet {
       Bucket* bucket = LoadBucket<access_mode>(bucket_index);
       if (bucket != nullptr) {
         size_t in_bucket_count = 0;
-        size_t cell_offset = bucket_index << kBitsPerBucketLog2;
-        for (int i = 0; i < kCellsPerBucket; i++, cell_offset += kBitsPerCell) {
-          uint32_t cell = bucket->template LoadCell<access_mode>(i);
-          if (cell) {
-            uint32_t old_cell = cell;
-            uint32_t mask = 0;
-            while (cell) {
-              int bit_offset = v8::base::bits::CountTrailingZeros(cell);
-              uint32_t bit_mask = 1u << bit_offset;
-              Address slot = (cell_offset + bit_offset) * SlotGranularity;
-              if (callback(chunk_start + slot) == KEEP_SLOT) {
-                ++in_bucket_count;
-              } else {
-                mask |= bit_mask;
-              }
-              cell ^= bit_mask;
-            }
-            uint32_t new_cell = old_cell & ~mask;
-            if (old_cell != new_cell) {
-              bucket->template ClearCellBits<access_mode>(i, mask);
-            }
-          }
+        size_t bucket_offset = bucket_index << kBitsPerBucketLog2;
+        // Only visit the cells that have slots, which makes iterating sparse
+        // sets cheap.
+        uint32_t non_empty_cells =
+            bucket->template NonEmptyCells<access_mode>();
+        while (non_empty_cells) {
+          int i = v8::base::bits::CountTrailingZeros(non_empty_cells);
+          non_empty_cells &= non_empty_cells - 1;
+          in_bucket_count += IterateCell<access_mode>(
+              chunk_start, bucket, bucket_offset, i, callback);
         }
         if (in_bucket_count == 0) {
           empty_bucket_callback(bucket_index);
@@ -371,6 +420,34 @@ class BasicSlotSet {
     return new_count;
   }
 
+  // Invokes the callback on the slots of a cell and returns the number of
+  // slots that are kept.
+  template <AccessMode access_mode, typename Callback>
+  static size_t IterateCell(Address chunk_start, Bucket* bucket,
+                            size_t bucket_offset, int cell_index,
+                            Callback& callback) {
+    uint32_t cell = bucket->template LoadCell<access_mode>(cell_index);
+    if (!cell) return 0;
+    const size_t cell_offset = bucket_offset + cell_index * kBitsPerCell;
+    size_t in_cell_count = 0;
+    uint32_t mask = 0;
+    while (cell) {
+      int bit_offset = v8::base::bits::CountTrailingZeros(cell);
+      uint32_t bit_mask = 1u << bit_offset;
+      Address slot = (cell_offset + bit_offset) * SlotGranularity;
+      if (callback(chunk_start + slot) == KEEP_SLOT) {
+        ++in_cell_count;
+      } else {
+        mask |= bit_mask;
+      }
+      cell ^= bit_mask;
+    }
+    if (mask) {
+      bucket->template ClearCellBits<access_mode>(cell_index, mask);
+    }
+    return in_cell_count;
+  }
+
   bool FreeBucketIfEmpty(size_t bucket_index) {
     Bucket* bucket = LoadBucket<AccessMode::NON_ATOMIC>(bucket_index);
     if (bucket != nullptr) {
@@ -465,4 +542,7 @@ class BasicSlotSet {
 }  // namespace base
 }  // namespace heap
 
+#undef V8_SLOT_SET_USE_SSE2
+#undef V8_SLOT_SET_USE_NEON
+
 #endif  // V8_HEAP_BASE_BASIC_SLOT_SET_H_
@@ -4,9 +4,12 @@
 
 #include "src/heap/code-range.h"
 
+#include <algorithm>
+
 #include "src/base/bits.h"
 #include "src/base/lazy-instance.h"
 #include "src/base/once.h"
+#include "src/base/platform/huge-pages.h"
 #include "src/codegen/constants-arch.h"
 #include "src/common/globals.h"
 #include "src/flags/flags.h"
@@ -113,9 +116,15 @@ bool CodeRange::InitReservation(v8::PageAllocator* page_allocator,
   // not cross the 4Gb boundary and thus the default compression scheme of
   // truncating the InstructionStream pointers to 32-bits still works. It's
   // achieved by specifying base_alignment parameter.
-  const size_t base_alignment = V8_EXTERNAL_CODE_SPACE_BOOL
-                                    ? base::bits::RoundUpToPowerOfTwo(requested)
-                                    : kPageSize;
+  // With --huge-pages the code range is also aligned to the huge page size so
+  // that code pages can be backed by transparent huge pages.
+  const size_t huge_page_size =
+      v8_flags.huge_pages ? base::HugePages::PageSize() : 0;
+  const size_t min_alignment = std::max(kPageSize, huge_page_size);
+  const size_t base_alignment =
+      V8_EXTERNAL_CODE_SPACE_BOOL
+          ? std::max(base::bits::RoundUpToPowerOfTwo(requested), min_alignment)
+          : min_alignment;
 
   DCHECK_IMPLIES(kPlatformRequiresCodeRange,
                  requested <= kMaximalCodeRangeSize);
@@ -151,7 +160,7 @@ bool CodeRange::InitReservation(v8::PageAllocator* page_allocator,
   if (kShouldTryHarder) {
     // Relax alignment requirement while trying to allocate code range inside
     // preferred region.
-    params.base_alignment = kPageSize;
+    params.base_alignment = min_alignment;
 
     // TODO(v8:11880): consider using base::OS::GetFreeMemoryRangesWithin()
     // to avoid attempts that's going to fail anyway.
@@ -162,9 +171,9 @@ bool CodeRange::InitReservation(v8::PageAllocator* page_allocator,
     // towards the start in steps.
     const int kAllocationTries = 16;
     params.requested_start_hint =
-        RoundDown(preferred_region.end() - requested, kPageSize);
+        RoundDown(preferred_region.end() - requested, min_alignment);
     Address step =
-        RoundDown(preferred_region.size() / kAllocationTries, kPageSize);
+        RoundDown(preferred_region.size() / kAllocationTries, min_alignment);
     for (int i = 0; i < kAllocationTries; i++) {
       TRACE("=== Attempt #%d, hint=%p\n", i,
             reinterpret_cast<void*>(params.requested_start_hint));
@@ -202,6 +211,10 @@ bool CodeRange::InitReservation(v8::PageAllocator* page_allocator,
     FATAL("Failed to allocate code range close to the .text section");
   }
 
+  if (huge_page_size > 0) {
+    base::HugePages::Enable(reinterpret_cast<void*>(base()), size());
+  }
+
   // On some platforms, specifically Win64, we need to reserve some pages at
   // the beginning of an executable space. See
   //   https://cs.chromium.org/chromium/src/components/crash/content/
@@ -29,7 +29,10 @@ AllocationResult ConcurrentAllocator::AllocateRaw(int size_in_bytes,
   if (local_heap_) local_heap_->VerifyCurrent();
 #endif  // DEBUG
 
-  if (size_in_bytes > kMaxLabObjectSize) {
+  // Large objects only end up in the LAB if it was reserved for them, see
+  // ReserveLab().
+  const bool large_object = size_in_bytes > kMaxLabObjectSize;
+  if (large_object && !IsLabReserved()) {
     return AllocateOutsideLab(size_in_bytes, alignment, origin);
   }
 
@@ -39,9 +42,9 @@ AllocationResult ConcurrentAllocator::AllocateRaw(int size_in_bytes,
   } else {
     result = AllocateInLabFastUnaligned(size_in_bytes);
   }
-  return result.IsFailure()
-             ? AllocateInLabSlow(size_in_bytes, alignment, origin)
-             : result;
+  if (!result.IsFailure()) return result;
+  if (large_object) return AllocateOutsideLab(size_in_bytes, alignment, origin);
+  return AllocateInLabSlow(size_in_bytes, alignment, origin);
 }
 
 AllocationResult ConcurrentAllocator::AllocateInLabFastUnaligned(
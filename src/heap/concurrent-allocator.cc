@@ -4,6 +4,8 @@
 
 #include "src/heap/concurrent-allocator.h"
 
+#include <algorithm>
+
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
 #include "src/handles/persistent-handles.h"
@@ -16,10 +18,35 @@
 #include "src/heap/marking.h"
 #include "src/heap/memory-chunk.h"
 #include "src/heap/parked-scope.h"
+#include "src/logging/counters.h"
 
 namespace v8 {
 namespace internal {
 
+namespace {
+
+// Locks the mutex of a space like base::MutexGuard and counts the acquisitions
+// that had to wait for another thread.
+class V8_NODISCARD SpaceMutexGuard final {
+ public:
+  SpaceMutexGuard(PagedSpace* space, Counters* counters)
+      : mutex_(space->mutex()) {
+    counters->concurrent_allocator_space_locks()->Increment();
+    if (!mutex_->TryLock()) {
+      counters->concurrent_allocator_contended_space_locks()->Increment();
+      mutex_->Lock();
+    }
+  }
+  ~SpaceMutexGuard() { mutex_->Unlock(); }
+  SpaceMutexGuard(const SpaceMutexGuard&) = delete;
+  SpaceMutexGuard& operator=(const SpaceMutexGuard&) = delete;
+
+ private:
+  base::Mutex* const mutex_;
+};
+
+}  // namespace
+
 void StressConcurrentAllocatorTask::RunInternal() {
   Heap* heap = isolate_->heap();
   LocalHeap local_heap(heap, ThreadKind::kBackground);
@@ -100,6 +127,11 @@ void ConcurrentAllocator::Verify() const {
 #endif  // DEBUG
 
 void ConcurrentAllocator::FreeLinearAllocationArea() {
+  FreeLab();
+  ReleaseFreeListCache();
+}
+
+void ConcurrentAllocator::FreeLab() {
   if (IsLabValid() && lab_.top() != lab_.limit()) {
     base::Optional<CodePageHeaderModificationScope> optional_scope;
     if (space_->identity() == CODE_SPACE) {
@@ -116,14 +148,136 @@ void ConcurrentAllocator::FreeLinearAllocationArea() {
     // candidates. So for evacuation candidates we just make the free memory
     // iterable.
     CHECK(!page->IsEvacuationCandidate());
-    base::MutexGuard guard(space_->mutex());
-    space_->Free(lab_.top(), lab_.limit() - lab_.top(),
-                 SpaceAccountingMode::kSpaceAccounted);
+    if (UsesFreeListCache()) {
+      AddToFreeListCache(lab_.top(), lab_.limit() - lab_.top());
+    } else {
+      SpaceMutexGuard guard(space_, owning_heap()->isolate()->counters());
+      space_->Free(lab_.top(), lab_.limit() - lab_.top(),
+                   SpaceAccountingMode::kSpaceAccounted);
+    }
   }
 
   ResetLab();
 }
 
+bool ConcurrentAllocator::UsesFreeListCache() const {
+  // Code pages need write scopes for fillers, and LABs in the shared space
+  // are kept across the start of marking, so only the other spaces cache
+  // free memory.
+  return v8_flags.concurrent_allocation_free_list_cache &&
+         context_ == Context::kNotGC &&
+         (identity() == OLD_SPACE || identity() == TRUSTED_SPACE);
+}
+
+base::Optional<std::pair<Address, size_t>>
+ConcurrentAllocator::TryFreeListCacheAllocation(size_t min_size_in_bytes,
+                                                size_t max_size_in_bytes) {
+  for (int i = 0; i < cached_ranges_count_; i++) {
+    FreeRange& range = cached_ranges_[i];
+    if (range.size < min_size_in_bytes) continue;
+    const Address start = range.start;
+    const size_t used_size_in_bytes = std::min(range.size, max_size_in_bytes);
+    const size_t remaining_size_in_bytes = range.size - used_size_in_bytes;
+    if (remaining_size_in_bytes >= static_cast<size_t>(kMinLabSize)) {
+      range = {start + used_size_in_bytes, remaining_size_in_bytes};
+      owning_heap()->CreateFillerObjectAtBackground(
+          range.start, static_cast<int>(range.size));
+    } else {
+      range = cached_ranges_[--cached_ranges_count_];
+      if (remaining_size_in_bytes > 0) {
+        AddToFreeListCache(start + used_size_in_bytes,
+                           remaining_size_in_bytes);
+      }
+    }
+    return std::make_pair(start, used_size_in_bytes);
+  }
+  return {};
+}
+
+bool ConcurrentAllocator::RefillFreeListCache(size_t min_size_in_bytes,
+                                              AllocationOrigin origin) {
+  SpaceMutexGuard guard(space_, owning_heap()->isolate()->counters());
+  ReturnFreeRangesLocked();
+  if (cached_ranges_count_ == kFreeListCacheCapacity) {
+    // None of the cached ranges fits the request.
+    ReleaseCachedRangesLocked();
+  }
+  size_t cached_bytes = 0;
+  for (int i = 0; i < cached_ranges_count_; i++) {
+    cached_bytes += cached_ranges_[i].size;
+  }
+  bool refilled = false;
+  while (!refilled || (cached_ranges_count_ < kFreeListCacheCapacity &&
+                       cached_bytes < kFreeListCacheRefillBytes)) {
+    size_t node_size = 0;
+    Tagged<FreeSpace> node =
+        space_->free_list_->Allocate(min_size_in_bytes, &node_size, origin);
+    if (node.is_null()) break;
+    DCHECK(!MarkCompactCollector::IsOnEvacuationCandidate(node));
+    // The cached memory is accounted like a LAB.
+    Page* page = Page::FromHeapObject(node);
+    space_->IncreaseAllocatedBytes(node_size, page);
+    space_->AddRangeToActiveSystemPages(page, node.address(),
+                                        node.address() + node_size);
+    cached_ranges_[cached_ranges_count_++] = {node.address(), node_size};
+    cached_bytes += node_size;
+    refilled = true;
+    // Only the first node needs to fit the current request.
+    min_size_in_bytes = kMinLabSize;
+  }
+  return refilled;
+}
+
+void ConcurrentAllocator::AddToFreeListCache(Address start, size_t size) {
+  DCHECK(UsesFreeListCache());
+  owning_heap()->CreateFillerObjectAtBackground(start, static_cast<int>(size));
+  if (size >= static_cast<size_t>(kMinLabSize) &&
+      cached_ranges_count_ < kFreeListCacheCapacity) {
+    cached_ranges_[cached_ranges_count_++] = {start, size};
+    return;
+  }
+  returned_ranges_[returned_ranges_count_++] = {start, size};
+  if (returned_ranges_count_ == kFreeListCacheCapacity) {
+    SpaceMutexGuard guard(space_, owning_heap()->isolate()->counters());
+    ReturnFreeRangesLocked();
+  }
+}
+
+void ConcurrentAllocator::ReleaseFreeListCache() {
+  if (cached_ranges_count_ == 0 && returned_ranges_count_ == 0) return;
+  SpaceMutexGuard guard(space_, owning_heap()->isolate()->counters());
+  ReleaseCachedRangesLocked();
+  ReturnFreeRangesLocked();
+}
+
+void ConcurrentAllocator::ReleaseCachedRangesLocked() {
+  space_->mutex()->AssertHeld();
+  for (int i = 0; i < cached_ranges_count_; i++) {
+    const FreeRange& range = cached_ranges_[i];
+    DCHECK(!Page::FromAddress(range.start)->IsEvacuationCandidate());
+    space_->Free(range.start, range.size,
+                 SpaceAccountingMode::kSpaceAccounted);
+  }
+  cached_ranges_count_ = 0;
+}
+
+void ConcurrentAllocator::ReturnFreeRangesLocked() {
+  space_->mutex()->AssertHeld();
+  for (int i = 0; i < returned_ranges_count_; i++) {
+    space_->Free(returned_ranges_[i].start, returned_ranges_[i].size,
+                 SpaceAccountingMode::kSpaceAccounted);
+  }
+  returned_ranges_count_ = 0;
+}
+
+size_t ConcurrentAllocator::FreeListCacheSizeForTesting() const {
+  size_t size = 0;
+  for (int i = 0; i < cached_ranges_count_; i++) {
+    size += cached_ranges_[i].size;
+  }
+  return size;
+}
+
 void ConcurrentAllocator::MakeLinearAllocationAreaIterable() {
   MakeLabIterable();
 }
@@ -169,13 +323,28 @@ AllocationResult ConcurrentAllocator::AllocateInLabSlow(
   return allocation;
 }
 
-bool ConcurrentAllocator::AllocateLab(AllocationOrigin origin) {
-  auto result = AllocateFromSpaceFreeList(kMinLabSize, kMaxLabSize, origin);
+base::Optional<base::AddressRegion> ConcurrentAllocator::ReserveLab(
+    int size_in_bytes, AllocationOrigin origin) {
+  DCHECK_EQ(origin == AllocationOrigin::kGC, context_ == Context::kGC);
+  const size_t size = ALIGN_TO_ALLOCATION_ALIGNMENT(size_in_bytes);
+  if (!IsLabValid() || lab_.limit() - lab_.top() < size) {
+    if (!AllocateLab(origin, std::max<size_t>(size, kMinLabSize),
+                     std::max<size_t>(size, kMaxLabSize))) {
+      return {};
+    }
+  }
+  reserved_lab_limit_ = lab_.limit();
+  return base::AddressRegion(lab_.top(), lab_.limit() - lab_.top());
+}
+
+bool ConcurrentAllocator::AllocateLab(AllocationOrigin origin, size_t min_size,
+                                      size_t max_size) {
+  auto result = AllocateFromSpaceFreeList(min_size, max_size, origin);
   if (!result) return false;
 
   owning_heap()->StartIncrementalMarkingIfAllocationLimitIsReachedBackground();
 
-  FreeLinearAllocationArea();
+  FreeLab();
 
   Address lab_start = result->first;
   Address lab_end = lab_start + result->second;
@@ -203,8 +372,18 @@ ConcurrentAllocator::AllocateFromSpaceFreeList(size_t min_size_in_bytes,
          origin == AllocationOrigin::kGC);
   DCHECK_IMPLIES(!local_heap_, origin == AllocationOrigin::kGC);
 
-  base::Optional<std::pair<Address, size_t>> result =
-      TryFreeListAllocation(min_size_in_bytes, max_size_in_bytes, origin);
+  base::Optional<std::pair<Address, size_t>> result;
+  if (UsesFreeListCache()) {
+    result = TryFreeListCacheAllocation(min_size_in_bytes, max_size_in_bytes);
+    if (!result && RefillFreeListCache(min_size_in_bytes, origin)) {
+      result =
+          TryFreeListCacheAllocation(min_size_in_bytes, max_size_in_bytes);
+      DCHECK(result);
+    }
+  } else {
+    result =
+        TryFreeListAllocation(min_size_in_bytes, max_size_in_bytes, origin);
+  }
   if (result) return result;
 
   uint64_t trace_flow_id = owning_heap()->sweeper()->GetTraceIdForFlowEvent(
@@ -278,7 +457,7 @@ base::Optional<std::pair<Address, size_t>>
 ConcurrentAllocator::TryFreeListAllocation(size_t min_size_in_bytes,
                                            size_t max_size_in_bytes,
                                            AllocationOrigin origin) {
-  base::MutexGuard lock(&space_->space_mutex_);
+  SpaceMutexGuard guard(space_, owning_heap()->isolate()->counters());
   DCHECK_LE(min_size_in_bytes, max_size_in_bytes);
   DCHECK(identity() == OLD_SPACE || identity() == CODE_SPACE ||
          identity() == SHARED_SPACE || identity() == TRUSTED_SPACE);
@@ -5,6 +5,9 @@
 #ifndef V8_HEAP_CONCURRENT_ALLOCATOR_H_
 #define V8_HEAP_CONCURRENT_ALLOCATOR_H_
 
+#include <array>
+
+#include "src/base/address-region.h"
 #include "src/base/optional.h"
 #include "src/common/globals.h"
 #include "src/heap/heap.h"
@@ -33,6 +36,13 @@ class StressConcurrentAllocatorTask : public CancelableTask {
 
 // Concurrent allocator for allocation from background threads/tasks.
 // Allocations are served from a TLAB if possible.
+//
+// With --concurrent-allocation-free-list-cache, LABs are refilled from a small
+// cache of free ranges that are taken from the free list of the space in a
+// batch. Freed LABs and unused parts of ranges are kept in the cache or
+// returned to the space in a batch. Like the LAB, cached memory is accounted
+// as allocated and is given back to the space whenever the LAB is freed, e.g.
+// before a GC.
 class ConcurrentAllocator {
  public:
   enum class Context {
@@ -44,6 +54,11 @@ class ConcurrentAllocator {
   static constexpr int kMaxLabSize = 32 * KB;
   static constexpr int kMaxLabObjectSize = 2 * KB;
 
+  // Number of free ranges that the free-list cache holds and the number of
+  // bytes that a refill aims for.
+  static constexpr int kFreeListCacheCapacity = 8;
+  static constexpr size_t kFreeListCacheRefillBytes = 4 * kMaxLabSize;
+
   ConcurrentAllocator(LocalHeap* local_heap, PagedSpace* space,
                       Context context);
 
@@ -51,6 +66,17 @@ class ConcurrentAllocator {
                                       AllocationAlignment alignment,
                                       AllocationOrigin origin);
 
+  // Makes sure that the LAB has at least |size_in_bytes| bytes left, so that
+  // subsequent allocations of up to that many bytes in total are contiguous,
+  // even for objects larger than kMaxLabObjectSize. Returns the free part of
+  // the LAB, or nothing if no large enough area is available, in which case
+  // allocations take the regular paths. Objects larger than
+  // kMaxLabObjectSize are allocated in the LAB until EndLabReservation() is
+  // called or the LAB is replaced.
+  V8_EXPORT_PRIVATE base::Optional<base::AddressRegion> ReserveLab(
+      int size_in_bytes, AllocationOrigin origin);
+  void EndLabReservation() { reserved_lab_limit_ = kNullAddress; }
+
   void FreeLinearAllocationArea();
   void MakeLinearAllocationAreaIterable();
   void MarkLinearAllocationAreaBlack();
@@ -63,7 +89,14 @@ class ConcurrentAllocator {
   // Checks whether the LAB is currently in use.
   V8_INLINE bool IsLabValid() { return lab_.top() != kNullAddress; }
 
+  V8_EXPORT_PRIVATE size_t FreeListCacheSizeForTesting() const;
+
  private:
+  struct FreeRange {
+    Address start;
+    size_t size;
+  };
+
   static_assert(
       kMinLabSize > kMaxLabObjectSize,
       "LAB size must be larger than max LAB object size as the fast "
@@ -80,7 +113,8 @@ class ConcurrentAllocator {
   V8_EXPORT_PRIVATE AllocationResult
   AllocateInLabSlow(int size_in_bytes, AllocationAlignment alignment,
                     AllocationOrigin origin);
-  bool AllocateLab(AllocationOrigin origin);
+  bool AllocateLab(AllocationOrigin origin, size_t min_size = kMinLabSize,
+                   size_t max_size = kMaxLabSize);
 
   base::Optional<std::pair<Address, size_t>> AllocateFromSpaceFreeList(
       size_t min_size_in_bytes, size_t max_size_in_bytes,
@@ -90,6 +124,24 @@ class ConcurrentAllocator {
       size_t min_size_in_bytes, size_t max_size_in_bytes,
       AllocationOrigin origin);
 
+  bool UsesFreeListCache() const;
+  base::Optional<std::pair<Address, size_t>> TryFreeListCacheAllocation(
+      size_t min_size_in_bytes, size_t max_size_in_bytes);
+  // Takes a batch of free-list nodes of at least |min_size_in_bytes| for the
+  // first one from the space. Returns whether any node was taken.
+  bool RefillFreeListCache(size_t min_size_in_bytes, AllocationOrigin origin);
+  // Keeps the free range in the cache if it is large enough for a LAB, and
+  // returns it to the space with the next batch otherwise.
+  void AddToFreeListCache(Address start, size_t size);
+  // Gives all cached and returned ranges back to the space.
+  void ReleaseFreeListCache();
+  // Require the space mutex.
+  void ReleaseCachedRangesLocked();
+  void ReturnFreeRangesLocked();
+
+  // Frees the LAB without releasing the free-list cache.
+  void FreeLab();
+
   V8_EXPORT_PRIVATE AllocationResult
   AllocateOutsideLab(int size_in_bytes, AllocationAlignment alignment,
                      AllocationOrigin origin);
@@ -97,7 +149,16 @@ class ConcurrentAllocator {
   bool IsBlackAllocationEnabled() const;
 
   // Resets the LAB.
-  void ResetLab() { lab_ = LinearAllocationArea(kNullAddress, kNullAddress); }
+  void ResetLab() {
+    lab_ = LinearAllocationArea(kNullAddress, kNullAddress);
+    EndLabReservation();
+  }
+
+  // Whether the current LAB was reserved by ReserveLab().
+  bool IsLabReserved() const {
+    return reserved_lab_limit_ != kNullAddress &&
+           lab_.limit() == reserved_lab_limit_;
+  }
 
   // Installs a filler object between the LABs top and limit pointers.
   void MakeLabIterable();
@@ -112,7 +173,13 @@ class ConcurrentAllocator {
   PagedSpace* const space_;
   Heap* const owning_heap_;
   LinearAllocationArea lab_;
+  // Limit of the LAB while it is reserved, see ReserveLab().
+  Address reserved_lab_limit_ = kNullAddress;
   const Context context_;
+  std::array<FreeRange, kFreeListCacheCapacity> cached_ranges_;
+  int cached_ranges_count_ = 0;
+  std::array<FreeRange, kFreeListCacheCapacity> returned_ranges_;
+  int returned_ranges_count_ = 0;
 };
 
 }  // namespace internal
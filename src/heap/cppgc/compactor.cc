@@ -4,6 +4,7 @@
 
 #include "src/heap/cppgc/compactor.h"
 
+#include <algorithm>
 #include <map>
 #include <numeric>
 #include <unordered_map>
@@ -28,6 +29,16 @@ namespace {
 // should be considered.
 static constexpr size_t kFreeListSizeThreshold = 512 * kKB;
 
+// Only pages that are at most half full are evacuated. Moving the objects of
+// denser pages costs more pause time than the memory they would give back.
+static constexpr size_t kMaxLiveBytesOfEvacuatedPage = kPageSize / 2;
+
+// Upper bound for the live bytes that are moved in a single garbage
+// collection. Spaces that are more fragmented than that are compacted
+// incrementally over several garbage collections, starting with their
+// sparsest pages, which keeps the atomic pause bounded.
+static constexpr size_t kMaxLiveBytesToMovePerGC = 2 * kMB;
+
 // The real worker behind heap compaction, recording references to movable
 // objects ("slots".) When the objects end up being compacted and moved,
 // relocate() will adjust the slots to point to the new location of the
@@ -333,13 +344,15 @@ class CompactionState final {
   Pages available_pages_;
 };
 
-enum class StickyBits : uint8_t {
-  kDisabled,
-  kEnabled,
-};
+size_t LiveBytes(const NormalPage& page) {
+  size_t live_bytes = 0;
+  for (const HeapObjectHeader& header : page) {
+    if (header.IsMarked()) live_bytes += header.AllocatedSize();
+  }
+  return live_bytes;
+}
 
-void CompactPage(NormalPage* page, CompactionState& compaction_state,
-                 StickyBits sticky_bits) {
+void CompactPage(NormalPage* page, CompactionState& compaction_state) {
   compaction_state.AddPage(page);
 
   page->object_start_bitmap().Clear();
@@ -376,12 +389,8 @@ void CompactPage(NormalPage* page, CompactionState& compaction_state,
       continue;
     }
 
-    // Object is marked.
-#if defined(CPPGC_YOUNG_GENERATION)
-    if (sticky_bits == StickyBits::kDisabled) header->Unmark();
-#else   // !defined(CPPGC_YOUNG_GENERATION)
-    header->Unmark();
-#endif  // !defined(CPPGC_YOUNG_GENERATION)
+    // Object is marked. It stays marked until the Sweeper processes the
+    // page, which also takes care of sticky mark bits.
 
     // Potentially unpoison the live object as well as it is the source of
     // the copy.
@@ -394,7 +403,7 @@ void CompactPage(NormalPage* page, CompactionState& compaction_state,
 }
 
 void CompactSpace(NormalPageSpace* space, MovableReferences& movable_references,
-                  StickyBits sticky_bits) {
+                  size_t& remaining_live_bytes_to_move) {
   using Pages = NormalPageSpace::Pages;
 
 #ifdef V8_USE_ADDRESS_SANITIZER
@@ -431,16 +440,44 @@ void CompactSpace(NormalPageSpace* space, MovableReferences& movable_references,
   // To ease the passing of the compaction state when iterating over an
   // arena's pages, package it up into a |CompactionState|.
 
+  // Only the sparsest pages of the space are evacuated, within the budget of
+  // live bytes that may be moved in this garbage collection. All other pages
+  // are put back into the space and left to the Sweeper. The evacuated pages
+  // are compacted in their original order which preserves the address order
+  // of the moved objects.
+
   Pages pages = space->RemoveAllPages();
   if (pages.empty()) return;
 
+  std::vector<std::pair<size_t, size_t>> candidates;
+  for (size_t i = 0; i < pages.size(); ++i) {
+    const size_t live_bytes = LiveBytes(*NormalPage::From(pages[i]));
+    if (live_bytes <= kMaxLiveBytesOfEvacuatedPage) {
+      candidates.emplace_back(live_bytes, i);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  std::vector<bool> evacuate(pages.size(), false);
+  for (const auto& [live_bytes, index] : candidates) {
+    if (live_bytes > remaining_live_bytes_to_move) break;
+    remaining_live_bytes_to_move -= live_bytes;
+    evacuate[index] = true;
+  }
+
   CompactionState compaction_state(space, movable_references);
-  for (BasePage* page : pages) {
+  bool evacuated_any_page = false;
+  for (size_t i = 0; i < pages.size(); ++i) {
+    if (!evacuate[i]) {
+      space->AddPage(pages[i]);
+      continue;
+    }
     // Large objects do not belong to this arena.
-    CompactPage(NormalPage::From(page), compaction_state, sticky_bits);
+    CompactPage(NormalPage::From(pages[i]), compaction_state);
+    evacuated_any_page = true;
   }
 
-  compaction_state.FinishCompactingSpace();
+  // Without evacuated pages there is no page to compact into.
+  if (evacuated_any_page) compaction_state.FinishCompactingSpace();
   // Sweeping will verify object start bitmap of compacted space.
 }
 
@@ -523,17 +560,16 @@ Compactor::CompactableSpaceHandling Compactor::CompactSpacesIfEnabled() {
   }
   compaction_worklists_.reset();
 
-  const bool young_gen_enabled = heap_.heap()->generational_gc_supported();
-
+  size_t remaining_live_bytes_to_move = kMaxLiveBytesToMovePerGC;
   for (NormalPageSpace* space : compactable_spaces_) {
-    CompactSpace(
-        space, movable_references,
-        young_gen_enabled ? StickyBits::kEnabled : StickyBits::kDisabled);
+    CompactSpace(space, movable_references, remaining_live_bytes_to_move);
   }
 
   enable_for_next_gc_for_testing_ = false;
   is_enabled_ = false;
-  return CompactableSpaceHandling::kIgnore;
+  // Compacted objects are still marked and the spaces may contain pages that
+  // were not evacuated.
+  return CompactableSpaceHandling::kSweep;
 }
 
 void Compactor::EnableForNextGCForTesting() {
@@ -26,8 +26,9 @@ class V8_EXPORT_PRIVATE Compactor final {
 
   void InitializeIfShouldCompact(GCConfig::MarkingType, StackState);
   void CancelIfShouldNotCompact(GCConfig::MarkingType, StackState);
-  // Returns whether spaces need to be processed by the Sweeper after
-  // compaction.
+  // Evacuates the sparsest pages of the compactable spaces, moving a bounded
+  // amount of live bytes per garbage collection. Returns whether spaces need
+  // to be processed by the Sweeper after compaction.
   CompactableSpaceHandling CompactSpacesIfEnabled();
 
   CompactionWorklists* compaction_worklists() {
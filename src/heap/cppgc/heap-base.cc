@@ -183,6 +183,12 @@ void HeapBase::EnableGenerationalGC() {
   object_allocator_.MarkAllPagesAsYoung();
 }
 
+void HeapBase::DisableGenerationalGC() {
+  if (!generational_gc_supported()) return;
+  HeapHandle::is_young_generation_enabled_ = false;
+  YoungGenerationEnabler::Disable();
+}
+
 void HeapBase::ResetRememberedSet() {
   DCHECK(in_atomic_pause());
   class AllLABsAreEmpty final : protected HeapVisitor<AllLABsAreEmpty> {
@@ -228,11 +234,7 @@ void HeapBase::Terminate() {
   sweeper().FinishIfRunning();
 
 #if defined(CPPGC_YOUNG_GENERATION)
-  if (generational_gc_supported()) {
-    DCHECK(is_young_generation_enabled());
-    HeapHandle::is_young_generation_enabled_ = false;
-    YoungGenerationEnabler::Disable();
-  }
+  DisableGenerationalGC();
 #endif  // defined(CPPGC_YOUNG_GENERATION)
 
   constexpr size_t kMaxTerminationGCs = 20;
@@ -267,6 +267,7 @@ class V8_EXPORT_PRIVATE HeapBase : public cppgc::HeapHandle {
 
 #if defined(CPPGC_YOUNG_GENERATION)
   void EnableGenerationalGC();
+  void DisableGenerationalGC();
   void ResetRememberedSet();
 #endif  // defined(CPPGC_YOUNG_GENERATION)
 
@@ -11,11 +11,7 @@
 namespace cppgc::internal {
 
 using StackState = cppgc::Heap::StackState;
-
-enum class CollectionType : uint8_t {
-  kMinor,
-  kMajor,
-};
+using CollectionType = cppgc::Heap::CollectionType;
 
 struct MarkingConfig {
   using MarkingType = cppgc::Heap::MarkingType;
@@ -32,7 +32,7 @@ class HeapGrowing::HeapGrowingImpl final
  public:
   HeapGrowingImpl(GarbageCollector*, StatsCollector*,
                   cppgc::Heap::ResourceConstraints, cppgc::Heap::MarkingType,
-                  cppgc::Heap::SweepingType);
+                  cppgc::Heap::SweepingType, bool young_generation_enabled);
   ~HeapGrowingImpl();
 
   HeapGrowingImpl(const HeapGrowingImpl&) = delete;
@@ -45,11 +45,13 @@ class HeapGrowing::HeapGrowingImpl final
 
   size_t limit_for_atomic_gc() const { return limit_for_atomic_gc_; }
   size_t limit_for_incremental_gc() const { return limit_for_incremental_gc_; }
+  size_t limit_for_minor_gc() const { return limit_for_minor_gc_; }
 
   void DisableForTesting();
 
  private:
   void ConfigureLimit(size_t allocated_object_size);
+  void ConfigureLimitForMinorGC(size_t allocated_object_size);
 
   GarbageCollector* collector_;
   StatsCollector* stats_collector_;
@@ -57,6 +59,10 @@ class HeapGrowing::HeapGrowingImpl final
   size_t initial_heap_size_ = 1 * kMB;
   size_t limit_for_atomic_gc_ = 0;       // See ConfigureLimit().
   size_t limit_for_incremental_gc_ = 0;  // See ConfigureLimit().
+  // Bytes that can be allocated between minor GCs. 0 if the limit is derived
+  // from the limits for major GCs.
+  size_t young_generation_size_ = 0;
+  size_t limit_for_minor_gc_ = 0;  // See ConfigureLimitForMinorGC().
 
   SingleThreadedHandle gc_task_handle_;
 
@@ -64,21 +70,24 @@ class HeapGrowing::HeapGrowingImpl final
 
   const cppgc::Heap::MarkingType marking_support_;
   const cppgc::Heap::SweepingType sweeping_support_;
+  const bool young_generation_enabled_;
 };
 
 HeapGrowing::HeapGrowingImpl::HeapGrowingImpl(
     GarbageCollector* collector, StatsCollector* stats_collector,
     cppgc::Heap::ResourceConstraints constraints,
     cppgc::Heap::MarkingType marking_support,
-    cppgc::Heap::SweepingType sweeping_support)
+    cppgc::Heap::SweepingType sweeping_support, bool young_generation_enabled)
     : collector_(collector),
       stats_collector_(stats_collector),
       gc_task_handle_(SingleThreadedHandle::NonEmptyTag{}),
       marking_support_(marking_support),
-      sweeping_support_(sweeping_support) {
+      sweeping_support_(sweeping_support),
+      young_generation_enabled_(young_generation_enabled) {
   if (constraints.initial_heap_size_bytes > 0) {
     initial_heap_size_ = constraints.initial_heap_size_bytes;
   }
+  young_generation_size_ = constraints.young_generation_size_bytes;
   constexpr size_t kNoAllocatedBytes = 0;
   ConfigureLimit(kNoAllocatedBytes);
   stats_collector->RegisterObserver(this);
@@ -95,16 +104,32 @@ void HeapGrowing::HeapGrowingImpl::AllocatedObjectSizeIncreased(size_t) {
     collector_->CollectGarbage(
         {CollectionType::kMajor, StackState::kMayContainHeapPointers,
          GCConfig::MarkingType::kAtomic, sweeping_support_});
-  } else if (allocated_object_size > limit_for_incremental_gc_) {
-    if (marking_support_ == cppgc::Heap::MarkingType::kAtomic) return;
+    return;
+  }
+  if (allocated_object_size > limit_for_incremental_gc_ &&
+      marking_support_ != cppgc::Heap::MarkingType::kAtomic) {
     collector_->StartIncrementalGarbageCollection(
         {CollectionType::kMajor, StackState::kMayContainHeapPointers,
          marking_support_, sweeping_support_});
+    return;
+  }
+  if (young_generation_enabled_ &&
+      allocated_object_size > limit_for_minor_gc_) {
+    collector_->CollectGarbage(
+        {CollectionType::kMinor, StackState::kMayContainHeapPointers,
+         GCConfig::MarkingType::kAtomic, sweeping_support_});
   }
 }
 
 void HeapGrowing::HeapGrowingImpl::ResetAllocatedObjectSize(
     size_t allocated_object_size) {
+  // Minor GCs do not reclaim old objects, so the limits for major GCs are kept
+  // to eventually trigger a major GC when the old generation grows.
+  if (stats_collector_->collection_type_on_current_cycle() ==
+      CollectionType::kMinor) {
+    ConfigureLimitForMinorGC(allocated_object_size);
+    return;
+  }
   ConfigureLimit(allocated_object_size);
 }
 
@@ -137,6 +162,22 @@ void HeapGrowing::HeapGrowingImpl::ConfigureLimit(
       std::max(minimum_limit_incremental_gc,
                std::min(maximum_limit_incremental_gc,
                         limit_incremental_gc_based_on_allocation_rate));
+  ConfigureLimitForMinorGC(allocated_object_size);
+}
+
+void HeapGrowing::HeapGrowingImpl::ConfigureLimitForMinorGC(
+    size_t allocated_object_size) {
+  // By default, the young generation takes half of the bytes that can still be
+  // allocated before starting a major GC.
+  const size_t young_generation_size =
+      young_generation_size_ > 0
+          ? young_generation_size_
+          : std::max(kMinLimitIncrease,
+                     (limit_for_incremental_gc_ -
+                      std::min(allocated_object_size,
+                               limit_for_incremental_gc_)) /
+                         2);
+  limit_for_minor_gc_ = allocated_object_size + young_generation_size;
 }
 
 void HeapGrowing::HeapGrowingImpl::DisableForTesting() {
@@ -147,10 +188,11 @@ HeapGrowing::HeapGrowing(GarbageCollector* collector,
                          StatsCollector* stats_collector,
                          cppgc::Heap::ResourceConstraints constraints,
                          cppgc::Heap::MarkingType marking_support,
-                         cppgc::Heap::SweepingType sweeping_support)
+                         cppgc::Heap::SweepingType sweeping_support,
+                         bool young_generation_enabled)
     : impl_(std::make_unique<HeapGrowing::HeapGrowingImpl>(
           collector, stats_collector, constraints, marking_support,
-          sweeping_support)) {}
+          sweeping_support, young_generation_enabled)) {}
 
 HeapGrowing::~HeapGrowing() = default;
 
@@ -160,6 +202,9 @@ size_t HeapGrowing::limit_for_atomic_gc() const {
 size_t HeapGrowing::limit_for_incremental_gc() const {
   return impl_->limit_for_incremental_gc();
 }
+size_t HeapGrowing::limit_for_minor_gc() const {
+  return impl_->limit_for_minor_gc();
+}
 
 void HeapGrowing::DisableForTesting() { impl_->DisableForTesting(); }
 
@@ -23,7 +23,9 @@ class StatsCollector;
 // on allocation statistics provided by StatsCollector and ResourceConstraints.
 //
 // Implements a fixed-ratio growing strategy with an initial heap size that the
-// GC can ignore to avoid excessive GCs for smaller heaps.
+// GC can ignore to avoid excessive GCs for smaller heaps. With the young
+// generation enabled, minor GCs are triggered after allocating a fixed number
+// of bytes while the limits for major GCs are only updated by major GCs.
 class V8_EXPORT_PRIVATE HeapGrowing final {
  public:
   // Constant growing factor for growing the heap limit.
@@ -35,7 +37,7 @@ class V8_EXPORT_PRIVATE HeapGrowing final {
 
   HeapGrowing(GarbageCollector*, StatsCollector*,
               cppgc::Heap::ResourceConstraints, cppgc::Heap::MarkingType,
-              cppgc::Heap::SweepingType);
+              cppgc::Heap::SweepingType, bool young_generation_enabled = false);
   ~HeapGrowing();
 
   HeapGrowing(const HeapGrowing&) = delete;
@@ -43,6 +45,7 @@ class V8_EXPORT_PRIVATE HeapGrowing final {
 
   size_t limit_for_atomic_gc() const;
   size_t limit_for_incremental_gc() const;
+  size_t limit_for_minor_gc() const;
 
   void DisableForTesting();
 
@@ -44,11 +44,14 @@ std::unique_ptr<Heap> Heap::Create(std::shared_ptr<cppgc::Platform> platform,
 }
 
 void Heap::ForceGarbageCollectionSlow(const char* source, const char* reason,
-                                      Heap::StackState stack_state) {
+                                      Heap::StackState stack_state,
+                                      Heap::CollectionType collection_type) {
   internal::Heap::From(this)->CollectGarbage(
-      {internal::CollectionType::kMajor, stack_state, MarkingType::kAtomic,
+      {collection_type, stack_state, MarkingType::kAtomic,
        SweepingType::kAtomic,
-       internal::GCConfig::FreeMemoryHandling::kDiscardWherePossible,
+       collection_type == CollectionType::kMajor
+           ? internal::GCConfig::FreeMemoryHandling::kDiscardWherePossible
+           : internal::GCConfig::FreeMemoryHandling::kDoNotDiscard,
        internal::GCConfig::IsForcedGC::kForced});
 }
 
@@ -70,6 +73,14 @@ void CheckConfig(GCConfig config, HeapBase::MarkingType marking_support,
            static_cast<int>(sweeping_support));
 }
 
+bool YoungGenerationEnabled(const cppgc::Heap::HeapOptions& options) {
+#if defined(CPPGC_YOUNG_GENERATION)
+  return options.enable_young_generation;
+#else   // !defined(CPPGC_YOUNG_GENERATION)
+  return false;
+#endif  // !defined(CPPGC_YOUNG_GENERATION)
+}
+
 }  // namespace
 
 Heap::Heap(std::shared_ptr<cppgc::Platform> platform,
@@ -79,11 +90,14 @@ Heap::Heap(std::shared_ptr<cppgc::Platform> platform,
       gc_invoker_(this, platform_.get(), options.stack_support),
       growing_(&gc_invoker_, stats_collector_.get(),
                options.resource_constraints, options.marking_support,
-               options.sweeping_support) {
+               options.sweeping_support, YoungGenerationEnabled(options)) {
   CHECK_IMPLIES(options.marking_support != HeapBase::MarkingType::kAtomic,
                 platform_->GetForegroundTaskRunner());
   CHECK_IMPLIES(options.sweeping_support != HeapBase::SweepingType::kAtomic,
                 platform_->GetForegroundTaskRunner());
+  if (YoungGenerationEnabled(options)) {
+    EnableGenerationalGC();
+  }
 }
 
 Heap::~Heap() {
@@ -96,6 +110,11 @@ Heap::~Heap() {
     subtle::NoGarbageCollectionScope no_gc(*this);
     sweeper_.FinishIfRunning();
   }
+#if defined(CPPGC_YOUNG_GENERATION)
+  // The write barrier is enabled globally as long as any heap uses the young
+  // generation.
+  DisableGenerationalGC();
+#endif  // defined(CPPGC_YOUNG_GENERATION)
 }
 
 void Heap::CollectGarbage(GCConfig config) {
@@ -106,6 +125,17 @@ void Heap::CollectGarbage(GCConfig config) {
     return;
   }
 
+  if (config.collection_type == CollectionType::kMinor) {
+    // A major garbage collection that is already in progress also reclaims
+    // young objects.
+    if (IsMarking()) return;
+    // The young generation is only set up by the first garbage collection
+    // after enabling it. Until then all objects are considered young.
+    if (!generational_gc_supported()) {
+      config.collection_type = CollectionType::kMajor;
+    }
+  }
+
   config_ = config;
 
   if (!IsMarking()) {
@@ -118,6 +148,8 @@ void Heap::CollectGarbage(GCConfig config) {
 void Heap::StartIncrementalGarbageCollection(GCConfig config) {
   DCHECK_NE(GCConfig::MarkingType::kAtomic, config.marking_type);
   DCHECK_NE(marking_support_, GCConfig::MarkingType::kAtomic);
+  // Minor garbage collections are always atomic.
+  DCHECK_EQ(CollectionType::kMajor, config.collection_type);
   CheckConfig(config, marking_support_, sweeping_support_);
 
   if (IsMarking() || in_no_gc_scope()) return;
@@ -158,6 +190,11 @@ void Heap::StartGarbageCollection(GCConfig config) {
   }
 #endif  // defined(CPPGC_YOUNG_GENERATION)
 
+  if (config.collection_type == CollectionType::kMajor) {
+    compactor_.InitializeIfShouldCompact(config.marking_type,
+                                         config.stack_state);
+  }
+
   const MarkingConfig marking_config{config.collection_type, config.stack_state,
                                      config.marking_type, config.is_forced_gc};
   marker_ = std::make_unique<Marker>(AsBase(), platform_.get(), marking_config);
@@ -188,6 +225,8 @@ void Heap::FinalizeGarbageCollectionImpl(StackState stack_state) {
     // This guards atomic pause marking, meaning that no internal method or
     // external callbacks are allowed to allocate new objects.
     cppgc::subtle::DisallowGarbageCollectionScope no_gc_scope(*this);
+    compactor_.CancelIfShouldNotCompact(GCConfig::MarkingType::kAtomic,
+                                        config_.stack_state);
     marker_->FinishMarking(config_.stack_state);
   }
   marker_.reset();
@@ -208,9 +247,9 @@ void Heap::FinalizeGarbageCollectionImpl(StackState stack_state) {
 #endif  // defined(CPPGC_YOUNG_GENERATION)
 
   subtle::NoGarbageCollectionScope no_gc(*this);
-  const SweepingConfig sweeping_config{
-      config_.sweeping_type, SweepingConfig::CompactableSpaceHandling::kSweep,
-      config_.free_memory_handling};
+  const SweepingConfig sweeping_config{config_.sweeping_type,
+                                       compactor_.CompactSpacesIfEnabled(),
+                                       config_.free_memory_handling};
   sweeper_.Start(sweeping_config);
   if (config_.sweeping_type == SweepingConfig::SweepingType::kAtomic) {
     sweeper_.FinishIfRunning();
@@ -159,6 +159,11 @@ void StatsCollector::NotifyMarkingCompleted(size_t marked_bytes) {
   time_of_last_end_of_marking_ = v8::base::TimeTicks::Now();
 }
 
+CollectionType StatsCollector::collection_type_on_current_cycle() const {
+  DCHECK_NE(GarbageCollectionState::kNotRunning, gc_state_);
+  return current_.collection_type;
+}
+
 double StatsCollector::GetRecentAllocationSpeedInBytesPerMs() const {
   v8::base::TimeTicks current_time = v8::base::TimeTicks::Now();
   DCHECK_LE(time_of_last_end_of_marking_, current_time);
@@ -269,6 +274,16 @@ void StatsCollector::NotifySweepingCompleted(SweepingType sweeping_type) {
   DCHECK_IMPLIES(
       previous_.sweeping_type == StatsCollector::SweepingType::kAtomic,
       previous_.scope_data[kIncrementalSweep].IsZero());
+  CollectionTypeStats& stats =
+      previous_.collection_type == CollectionType::kMinor ? minor_gc_stats_
+                                                          : major_gc_stats_;
+  stats.cycles++;
+  stats.marked_bytes += previous_.marked_bytes;
+  stats.freed_object_bytes +=
+      previous_.object_size_before_sweep_bytes - marked_bytes_so_far_;
+  for (int i = 0; i < kNumHistogramScopeIds; ++i) {
+    stats.main_thread_time += previous_.scope_data[i];
+  }
   if (metric_recorder_) {
     MetricRecorder::GCCycle event = GetCycleEventForMetricRecorder(
         previous_.collection_type, previous_.marking_type,
@@ -122,6 +122,16 @@ class V8_EXPORT_PRIVATE StatsCollector final {
     size_t memory_size_before_sweep_bytes = -1;
   };
 
+  // Statistics accumulated over all completed cycles of one collection type.
+  struct CollectionTypeStats final {
+    size_t cycles = 0;
+    // For minor GCs, these are the bytes promoted to the old generation.
+    size_t marked_bytes = 0;
+    size_t freed_object_bytes = 0;
+    // Atomic and incremental time on the mutator thread.
+    v8::base::TimeDelta main_thread_time;
+  };
+
  private:
 #if defined(CPPGC_CASE)
   static_assert(false, "CPPGC_CASE macro is already defined");
@@ -308,8 +318,16 @@ class V8_EXPORT_PRIVATE StatsCollector final {
   // be called during marking.
   v8::base::TimeDelta marking_time() const;
 
+  // Returns the collection type of the current cycle. Should only be called
+  // within GC cycle.
+  CollectionType collection_type_on_current_cycle() const;
+
   double GetRecentAllocationSpeedInBytesPerMs() const;
 
+  const CollectionTypeStats& GetCollectionTypeStats(CollectionType type) const {
+    return type == CollectionType::kMinor ? minor_gc_stats_ : major_gc_stats_;
+  }
+
   const Event& GetPreviousEventForTesting() const { return previous_; }
 
   void NotifyAllocatedMemory(int64_t);
@@ -382,6 +400,9 @@ class V8_EXPORT_PRIVATE StatsCollector final {
   // The previous GC event which is populated at NotifySweepingFinished.
   Event previous_;
 
+  CollectionTypeStats minor_gc_stats_;
+  CollectionTypeStats major_gc_stats_;
+
   std::unique_ptr<MetricRecorder> metric_recorder_;
 
   // |platform_| is used by the TRACE_EVENT_* macros.
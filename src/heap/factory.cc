@@ -224,7 +224,8 @@ MaybeHandle<Code> Factory::CodeBuilder::BuildInternal(
       // directly to the actual heap objects. These pointers can include
       // references to the code object itself, through the self_reference
       // parameter.
-      istream->Finalize(*code, *reloc_info, code_desc_, isolate_->heap());
+      istream->Finalize(*code, *reloc_info, code_desc_, isolate_->heap(),
+                        !skip_icache_flush_);
 
 #ifdef VERIFY_HEAP
       if (v8_flags.verify_heap) {
@@ -1055,6 +1055,14 @@ class V8_EXPORT_PRIVATE Factory : public FactoryBase<Factory> {
       return *this;
     }
 
+    // Leaves flushing the instruction cache to the caller, which can then
+    // flush the code of several builders at once. The code must not run
+    // before it is flushed.
+    CodeBuilder& set_skip_icache_flush() {
+      skip_icache_flush_ = true;
+      return *this;
+    }
+
    private:
     MaybeHandle<Code> BuildInternal(bool retry_allocation_or_fail);
 
@@ -1082,6 +1090,7 @@ class V8_EXPORT_PRIVATE Factory : public FactoryBase<Factory> {
     BasicBlockProfilerData* profiler_data_ = nullptr;
     bool is_turbofanned_ = false;
     int stack_slots_ = 0;
+    bool skip_icache_flush_ = false;
   };
 
  private:
@@ -662,6 +662,16 @@ void GCTracer::AddCompactionEvent(double duration,
       live_bytes_compacted, base::TimeDelta::FromMillisecondsD(duration)));
 }
 
+void GCTracer::NotifyCompaction(size_t pages, size_t live_bytes) {
+  current_.compacted_pages = pages;
+  current_.compacted_bytes = live_bytes;
+}
+
+void GCTracer::NotifyPinnedPages(size_t pages, size_t free_bytes) {
+  current_.pinned_pages = pages;
+  current_.pinned_free_bytes = free_bytes;
+}
+
 void GCTracer::AddSurvivalRatio(double promotion_ratio) {
   recorded_survival_ratios_.Push(promotion_ratio);
 }
@@ -965,19 +975,24 @@ void GCTracer::PrintNVP() const {
           "clear.join_job=%.1f "
           "complete.sweep_array_buffers=%.1f "
           "complete.sweeping=%.1f "
+          "complete.unmapping=%.1f "
           "epilogue=%.1f "
           "evacuate=%.1f "
           "evacuate.candidates=%.1f "
           "evacuate.clean_up=%.1f "
           "evacuate.copy=%.1f "
+          "evacuate.copy.parallel=%.1f "
           "evacuate.prologue=%.1f "
           "evacuate.epilogue=%.1f "
           "evacuate.rebalance=%.1f "
           "evacuate.update_pointers=%.1f "
           "evacuate.update_pointers.to_new_roots=%.1f "
           "evacuate.update_pointers.slots.main=%.1f "
+          "evacuate.update_pointers.parallel=%.1f "
+          "evacuate.update_pointers.client_heaps=%.1f "
           "evacuate.update_pointers.weak=%.1f "
           "finish=%.1f "
+          "finish.shrink_large_pages=%.1f "
           "finish.sweep_array_buffers=%.1f "
           "mark=%.1f "
           "mark.finish_incremental=%.1f "
@@ -991,10 +1006,14 @@ void GCTracer::PrintNVP() const {
           "prologue=%.1f "
           "sweep=%.1f "
           "sweep.code=%.1f "
+          "sweep.code_lo=%.1f "
+          "sweep.lo=%.1f "
           "sweep.map=%.1f "
           "sweep.new=%.1f "
           "sweep.new_lo=%.1f "
           "sweep.old=%.1f "
+          "sweep.shared_lo=%.1f "
+          "sweep.trusted_lo=%.1f "
           "sweep.start_jobs=%.1f "
           "incremental=%.1f "
           "incremental.finalize=%.1f "
@@ -1032,7 +1051,12 @@ void GCTracer::PrintNVP() const {
           "new_space_survive_rate=%.1f%% "
           "new_space_allocation_throughput=%.1f "
           "unmapper_chunks=%d "
-          "compaction_speed=%.f\n",
+          "compaction_speed=%.f "
+          "compacted_pages=%zu "
+          "compacted_bytes=%zu "
+          "compaction_pause_budget=%d "
+          "pinned_pages=%zu "
+          "pinned_free_bytes=%zu\n",
           duration.InMillisecondsF(), spent_in_mutator.InMillisecondsF(),
           ToString(current_.type, true), current_.reduce_memory,
           current_scope(Scope::TIME_TO_SAFEPOINT),
@@ -1056,18 +1080,23 @@ void GCTracer::PrintNVP() const {
           current_scope(Scope::MC_CLEAR_JOIN_JOB),
           current_scope(Scope::MC_COMPLETE_SWEEP_ARRAY_BUFFERS),
           current_scope(Scope::MC_COMPLETE_SWEEPING),
+          current_scope(Scope::MC_COMPLETE_UNMAPPING),
           current_scope(Scope::MC_EPILOGUE), current_scope(Scope::MC_EVACUATE),
           current_scope(Scope::MC_EVACUATE_CANDIDATES),
           current_scope(Scope::MC_EVACUATE_CLEAN_UP),
           current_scope(Scope::MC_EVACUATE_COPY),
+          current_scope(Scope::MC_EVACUATE_COPY_PARALLEL),
           current_scope(Scope::MC_EVACUATE_PROLOGUE),
           current_scope(Scope::MC_EVACUATE_EPILOGUE),
           current_scope(Scope::MC_EVACUATE_REBALANCE),
           current_scope(Scope::MC_EVACUATE_UPDATE_POINTERS),
           current_scope(Scope::MC_EVACUATE_UPDATE_POINTERS_TO_NEW_ROOTS),
           current_scope(Scope::MC_EVACUATE_UPDATE_POINTERS_SLOTS_MAIN),
+          current_scope(Scope::MC_EVACUATE_UPDATE_POINTERS_PARALLEL),
+          current_scope(Scope::MC_EVACUATE_UPDATE_POINTERS_CLIENT_HEAPS),
           current_scope(Scope::MC_EVACUATE_UPDATE_POINTERS_WEAK),
           current_scope(Scope::MC_FINISH),
+          current_scope(Scope::MC_FINISH_SHRINK_LARGE_PAGES),
           current_scope(Scope::MC_FINISH_SWEEP_ARRAY_BUFFERS),
           current_scope(Scope::MC_MARK),
           current_scope(Scope::MC_MARK_FINISH_INCREMENTAL),
@@ -1080,10 +1109,14 @@ void GCTracer::PrintNVP() const {
           current_scope(Scope::MC_MARK_EMBEDDER_TRACING),
           current_scope(Scope::MC_PROLOGUE), current_scope(Scope::MC_SWEEP),
           current_scope(Scope::MC_SWEEP_CODE),
+          current_scope(Scope::MC_SWEEP_CODE_LO),
+          current_scope(Scope::MC_SWEEP_LO),
           current_scope(Scope::MC_SWEEP_MAP),
           current_scope(Scope::MC_SWEEP_NEW),
           current_scope(Scope::MC_SWEEP_NEW_LO),
           current_scope(Scope::MC_SWEEP_OLD),
+          current_scope(Scope::MC_SWEEP_SHARED_LO),
+          current_scope(Scope::MC_SWEEP_TRUSTED_LO),
           current_scope(Scope::MC_SWEEP_START_JOBS),
           current_scope(Scope::MC_INCREMENTAL),
           current_scope(Scope::MC_INCREMENTAL_FINALIZE),
@@ -1117,7 +1150,9 @@ void GCTracer::PrintNVP() const {
           heap_->new_space_surviving_rate_,
           NewSpaceAllocationThroughputInBytesPerMillisecond(),
           heap_->memory_allocator()->unmapper()->NumberOfChunks(),
-          CompactionSpeedInBytesPerMillisecond());
+          CompactionSpeedInBytesPerMillisecond(), current_.compacted_pages,
+          current_.compacted_bytes, v8_flags.compaction_pause_budget_ms,
+          current_.pinned_pages, current_.pinned_free_bytes);
       break;
     case Event::Type::START:
       break;
@@ -223,6 +223,16 @@ class V8_EXPORT_PRIVATE GCTracer {
     // INCREMENTAL_MARK_COMPACTOR.
     base::TimeDelta incremental_marking_duration;
 
+    // Number of evacuation candidates and their live bytes that were
+    // compacted in the atomic pause.
+    size_t compacted_pages = 0;
+    size_t compacted_bytes = 0;
+
+    // Number of regular pages with pinned objects and their free bytes, which
+    // could not be compacted.
+    size_t pinned_pages = 0;
+    size_t pinned_free_bytes = 0;
+
     // Start/end of atomic/safepoint pause.
     base::TimeTicks start_atomic_pause_time;
     base::TimeTicks end_atomic_pause_time;
@@ -326,6 +336,12 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   void AddCompactionEvent(double duration, size_t live_bytes_compacted);
 
+  // Records the old generation pages evacuated in the current atomic pause.
+  void NotifyCompaction(size_t pages, size_t live_bytes);
+
+  // Records the pages that were not evacuated because of pinned objects.
+  void NotifyPinnedPages(size_t pages, size_t free_bytes);
+
   void AddSurvivalRatio(double survival_ratio);
 
   // Log an incremental marking step.
@@ -19,6 +19,7 @@
 #include "src/base/macros.h"
 #include "src/base/once.h"
 #include "src/base/optional.h"
+#include "src/base/platform/huge-pages.h"
 #include "src/base/platform/memory.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/utils/random-number-generator.h"
@@ -93,6 +94,7 @@
 #include "src/heap/stress-scavenge-observer.h"
 #include "src/heap/sweeper.h"
 #include "src/heap/trusted-range.h"
+#include "src/heap/young-generation-controller.h"
 #include "src/heap/zapping.h"
 #include "src/init/bootstrapper.h"
 #include "src/init/v8.h"
@@ -120,6 +122,8 @@
 #include "src/strings/string-stream.h"
 #include "src/strings/unicode-decoder.h"
 #include "src/strings/unicode-inl.h"
+#include "src/tasks/cancelable-task.h"
+#include "src/tasks/task-utils.h"
 #include "src/tracing/trace-event.h"
 #include "src/utils/utils-inl.h"
 #include "src/utils/utils.h"
@@ -566,6 +570,13 @@ GarbageCollector Heap::SelectGarbageCollector(AllocationSpace space,
     return GarbageCollector::MARK_COMPACTOR;
   }
 
+  // The scavenger moves all live young objects, whereas the full GC promotes
+  // pages with pinned objects in place. MinorMS does not move objects.
+  if (!v8_flags.minor_ms && HasPinnedYoungPages()) {
+    *reason = "young objects are pinned";
+    return GarbageCollector::MARK_COMPACTOR;
+  }
+
   DCHECK(!v8_flags.single_generation);
   DCHECK(!v8_flags.gc_global);
   // Default
@@ -1368,6 +1379,10 @@ void Heap::GarbageCollectionEpilogueInSafepoint(GarbageCollector collector) {
 #undef UPDATE_FRAGMENTATION_FOR_SPACE
 #undef UPDATE_COUNTERS_AND_FRAGMENTATION_FOR_SPACE
 
+  if (collector == GarbageCollector::MARK_COMPACTOR) {
+    ScheduleHugePageCountersUpdate();
+  }
+
 #ifdef DEBUG
   if (v8_flags.print_global_handles) isolate_->global_handles()->Print();
   if (v8_flags.print_handles) PrintHandles();
@@ -1414,6 +1429,43 @@ void Heap::GarbageCollectionEpilogueInSafepoint(GarbageCollector collector) {
   collection_barrier_->ResumeThreadsAwaitingCollection();
 }
 
+void Heap::ScheduleHugePageCountersUpdate() {
+  if (!v8_flags.huge_pages) return;
+  Counters* counters = isolate_->counters();
+  if (!counters->huge_pages_heap()->Enabled() &&
+      !counters->huge_pages_code()->Enabled()) {
+    return;
+  }
+  if (IsTearingDown()) return;
+  // Reading /proc/self/smaps is slow, so keep it out of the GC pause. At most
+  // one update is in flight at a time.
+  if (huge_page_counters_update_pending_.exchange(true)) return;
+  V8::GetCurrentPlatform()->CallOnWorkerThread(
+      MakeCancelableTask(isolate(), [this] {
+        UpdateHugePageCounters();
+        huge_page_counters_update_pending_.store(false);
+      }));
+}
+
+void Heap::UpdateHugePageCounters() {
+  const size_t huge_page_size = base::HugePages::PageSize();
+  auto huge_pages_in = [huge_page_size](Address base, size_t size) {
+    return static_cast<int>(
+        base::HugePages::BackedBytes(reinterpret_cast<void*>(base), size) /
+        huge_page_size);
+  };
+#ifdef V8_COMPRESS_POINTERS
+  // All regular heap pages are allocated in the pointer compression cage.
+  const VirtualMemoryCage* cage = isolate()->GetPtrComprCage();
+  isolate_->counters()->huge_pages_heap()->Set(
+      huge_pages_in(cage->base(), cage->size()));
+#endif  // V8_COMPRESS_POINTERS
+  if (code_range_ != nullptr) {
+    isolate_->counters()->huge_pages_code()->Set(
+        huge_pages_in(code_range_->base(), code_range_->size()));
+  }
+}
+
 void Heap::GarbageCollectionEpilogue(GarbageCollector collector) {
   TRACE_GC(tracer(), GCTracer::Scope::HEAP_EPILOGUE);
   AllowGarbageCollection for_the_rest_of_the_epilogue;
@@ -2329,6 +2381,7 @@ void Heap::PerformGarbageCollection(GarbageCollector collector,
     DCHECK_EQ(GarbageCollector::MARK_COMPACTOR, collector);
     CompleteSweepingFull();
 
+    TRACE_GC(tracer(), GCTracer::Scope::MC_COMPLETE_UNMAPPING);
     memory_allocator()->unmapper()->EnsureUnmappingCompleted();
   }
 
@@ -3922,11 +3975,25 @@ void Heap::ActivateMemoryReducerIfNeededOnMainThread() {
 }
 
 Heap::ResizeNewSpaceMode Heap::ShouldResizeNewSpace() {
+  new_space_resize_target_ = initial_semispace_size_;
   if (ShouldReduceMemory()) {
     return (v8_flags.predictable) ? ResizeNewSpaceMode::kNone
                                   : ResizeNewSpaceMode::kShrink;
   }
 
+  if (young_generation_controller_ && !v8_flags.predictable) {
+    // Shrinking uncommits memory that growing has to commit again, so small
+    // reductions are not worth it.
+    static constexpr double kMinShrinkingFactor = 0.75;
+    const size_t capacity = new_space_->TotalCapacity();
+    new_space_resize_target_ = young_generation_controller_->ComputeCapacity();
+    if (new_space_resize_target_ > capacity) return ResizeNewSpaceMode::kGrow;
+    if (new_space_resize_target_ < kMinShrinkingFactor * capacity) {
+      return ResizeNewSpaceMode::kShrink;
+    }
+    return ResizeNewSpaceMode::kNone;
+  }
+
   static const size_t kLowAllocationThroughput = 1000;
   const double allocation_throughput =
       tracer_->CurrentAllocationThroughputInBytesPerMillisecond();
@@ -3938,7 +4005,12 @@ Heap::ResizeNewSpaceMode Heap::ShouldResizeNewSpace() {
       (new_space_->TotalCapacity() < new_space_->MaximumCapacity()) &&
       (survived_since_last_expansion_ > new_space_->TotalCapacity());
 
-  if (should_grow) survived_since_last_expansion_ = 0;
+  if (should_grow) {
+    survived_since_last_expansion_ = 0;
+    new_space_resize_target_ =
+        static_cast<size_t>(v8_flags.semi_space_growth_factor) *
+        new_space_->TotalCapacity();
+  }
 
   if (should_grow == should_shrink) return ResizeNewSpaceMode::kNone;
   return should_grow ? ResizeNewSpaceMode::kGrow : ResizeNewSpaceMode::kShrink;
@@ -3947,14 +4019,14 @@ Heap::ResizeNewSpaceMode Heap::ShouldResizeNewSpace() {
 void Heap::ExpandNewSpaceSize() {
   // Grow the size of new space if there is room to grow, and enough data
   // has survived scavenge since the last expansion.
-  new_space_->Grow();
+  new_space_->GrowTo(new_space_resize_target_);
   new_lo_space()->SetCapacity(new_space()->TotalCapacity());
 }
 
 void Heap::ReduceNewSpaceSize() {
   // MinorMS shrinks new space as part of sweeping.
   if (!v8_flags.minor_ms) {
-    SemiSpaceNewSpace::From(new_space())->Shrink();
+    SemiSpaceNewSpace::From(new_space())->Shrink(new_space_resize_target_);
   } else {
     paged_new_space()->FinishShrinking();
   }
@@ -4323,6 +4395,85 @@ void Heap::MemoryPressureNotification(MemoryPressureLevel level,
   }
 }
 
+void Heap::SetYoungGenerationTargets(double scavenge_pause_target_ms,
+                                     double throughput_target) {
+  if (!new_space_) return;
+  if (young_generation_controller_) {
+    young_generation_controller_->SetTargets(scavenge_pause_target_ms,
+                                             throughput_target);
+  } else {
+    young_generation_controller_ = std::make_unique<YoungGenerationController>(
+        this, scavenge_pause_target_ms, throughput_target);
+  }
+}
+
+void Heap::PinObject(Tagged<HeapObject> object) {
+  BasicMemoryChunk* basic_chunk = BasicMemoryChunk::FromHeapObject(object);
+  // Read-only objects are never moved.
+  if (basic_chunk->InReadOnlySpace()) return;
+  MemoryChunk* chunk = MemoryChunk::cast(basic_chunk);
+  DCHECK(!chunk->IsFlagSet(MemoryChunk::IS_EXECUTABLE));
+  Heap* heap = chunk->heap();
+  base::MutexGuard guard(&heap->pinned_pages_mutex_);
+  heap->pinned_objects_[object.address()]++;
+  if (heap->pinned_pages_[chunk]++ == 0) {
+    chunk->SetFlag(MemoryChunk::PINNED);
+    if (chunk->InYoungGeneration() && !chunk->IsLargePage()) {
+      heap->pinned_young_pages_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void Heap::UnpinObject(Tagged<HeapObject> object) {
+  BasicMemoryChunk* basic_chunk = BasicMemoryChunk::FromHeapObject(object);
+  if (basic_chunk->InReadOnlySpace()) return;
+  MemoryChunk* chunk = MemoryChunk::cast(basic_chunk);
+  Heap* heap = chunk->heap();
+  base::MutexGuard guard(&heap->pinned_pages_mutex_);
+  auto object_it = heap->pinned_objects_.find(object.address());
+  DCHECK(object_it != heap->pinned_objects_.end());
+  if (--object_it->second == 0) heap->pinned_objects_.erase(object_it);
+  auto it = heap->pinned_pages_.find(chunk);
+  DCHECK(it != heap->pinned_pages_.end());
+  DCHECK(chunk->IsPinned());
+  if (--it->second == 0) {
+    chunk->ClearFlag(MemoryChunk::PINNED);
+    heap->pinned_pages_.erase(it);
+    if (chunk->InYoungGeneration() && !chunk->IsLargePage()) {
+      DCHECK_LT(0, heap->pinned_young_pages_.load(std::memory_order_relaxed));
+      heap->pinned_young_pages_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+// static
+bool Heap::IsPinned(Tagged<HeapObject> object) {
+  BasicMemoryChunk* basic_chunk = BasicMemoryChunk::FromHeapObject(object);
+  if (!basic_chunk->IsPinned()) return false;
+  Heap* heap = basic_chunk->heap();
+  base::MutexGuard guard(&heap->pinned_pages_mutex_);
+  return heap->pinned_objects_.count(object.address()) != 0;
+}
+
+void Heap::NotifyPinnedPagePromoted() {
+  DCHECK_LT(0, pinned_young_pages_.load(std::memory_order_relaxed));
+  pinned_young_pages_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Heap::ReportPinnedPages() {
+  size_t pages = 0;
+  size_t free_bytes = 0;
+  {
+    base::MutexGuard guard(&pinned_pages_mutex_);
+    for (const auto& [chunk, count] : pinned_pages_) {
+      if (chunk->IsLargePage()) continue;
+      pages++;
+      free_bytes += chunk->area_size() - chunk->live_bytes();
+    }
+  }
+  tracer()->NotifyPinnedPages(pages, free_bytes);
+}
+
 void Heap::EagerlyFreeExternalMemory() {
   CompleteArrayBufferSweeping(this);
   memory_allocator()->unmapper()->EnsureUnmappingCompleted();
@@ -5756,6 +5907,12 @@ void Heap::SetUpSpaces(LinearAllocationArea& new_allocation_info,
   if (v8_flags.memory_balancer) {
     mb_.reset(new MemoryBalancer(this, startup_time));
   }
+
+  if (v8_flags.young_generation_controller && new_space_) {
+    young_generation_controller_ = std::make_unique<YoungGenerationController>(
+        this, v8_flags.scavenge_pause_target_ms,
+        v8_flags.young_generation_throughput_target);
+  }
 }
 
 void Heap::InitializeHashSeed() {
@@ -134,6 +134,7 @@ class TrustedLargeObjectSpace;
 class TrustedRange;
 class TrustedSpace;
 class WeakObjectRetainer;
+class YoungGenerationController;
 
 enum class ClearRecordedSlots { kYes, kNo };
 
@@ -606,6 +607,30 @@ class Heap final {
       v8::MemoryPressureLevel level, bool is_isolate_locked);
   void CheckMemoryPressure();
 
+  V8_EXPORT_PRIVATE void SetYoungGenerationTargets(
+      double scavenge_pause_target_ms, double throughput_target);
+
+  // Pinned objects are not moved by the GC until they are unpinned, see
+  // v8::PinnedContentsScope. Pins are counted per page and the pages are
+  // flagged as MemoryChunk::PINNED: they are not selected for evacuation and
+  // young pages are promoted as a whole. Objects on pages of another heap,
+  // e.g. in the shared space, are pinned in the owning heap.
+  V8_EXPORT_PRIVATE void PinObject(Tagged<HeapObject> object);
+  V8_EXPORT_PRIVATE void UnpinObject(Tagged<HeapObject> object);
+  // Whether |object| is pinned. Objects that hold pinned contents must not
+  // change their layout, e.g. by becoming thin or external strings.
+  V8_EXPORT_PRIVATE static bool IsPinned(Tagged<HeapObject> object);
+  // Whether objects on regular young generation pages are pinned, which
+  // the scavenger cannot handle.
+  bool HasPinnedYoungPages() const {
+    return pinned_young_pages_.load(std::memory_order_relaxed) > 0;
+  }
+  // Called when a young page with pinned objects is promoted in place.
+  void NotifyPinnedPagePromoted();
+  // Reports the number of pinned pages and the free memory on them, which
+  // compaction could not reclaim, to the tracer.
+  void ReportPinnedPages();
+
   V8_EXPORT_PRIVATE void AddNearHeapLimitCallback(v8::NearHeapLimitCallback,
                                                   void* data);
   V8_EXPORT_PRIVATE void RemoveNearHeapLimitCallback(
@@ -1796,6 +1821,11 @@ class Heap final {
   void ExpandNewSpaceSize();
   void ReduceNewSpaceSize();
 
+  // Updates the counters for the huge pages backing the heap (--huge-pages)
+  // on a background thread, if they are enabled.
+  void ScheduleHugePageCountersUpdate();
+  void UpdateHugePageCounters();
+
   GCIdleTimeHeapState ComputeHeapState();
 
   bool PerformIdleTimeAction(GCIdleTimeAction action,
@@ -2103,6 +2133,9 @@ class Heap final {
   // scavenge since last new space expansion.
   size_t survived_since_last_expansion_ = 0;
 
+  // The capacity that ShouldResizeNewSpace() chose for new space.
+  size_t new_space_resize_target_ = 0;
+
   // This is not the depth of nested AlwaysAllocateScope's but rather a single
   // count, as scopes can be acquired from multiple tasks (read: threads).
   std::atomic<size_t> always_allocate_scope_count_{0};
@@ -2324,6 +2357,7 @@ class Heap final {
 
   bool is_current_gc_forced_ = false;
   bool is_current_gc_for_heap_profiler_ = false;
+  std::atomic<bool> huge_page_counters_update_pending_{false};
   GarbageCollector current_or_last_garbage_collector_ =
       GarbageCollector::SCAVENGER;
 
@@ -2377,6 +2411,16 @@ class Heap final {
 
   std::unique_ptr<MemoryBalancer> mb_;
 
+  std::unique_ptr<YoungGenerationController> young_generation_controller_;
+
+  // Number of pins per pinned object and per page with pinned objects, see
+  // PinObject(). Pinned objects never move, so they are keyed by address.
+  mutable base::Mutex pinned_pages_mutex_;
+  std::unordered_map<Address, int> pinned_objects_;
+  std::unordered_map<MemoryChunk*, int> pinned_pages_;
+  // Number of regular young generation pages in |pinned_pages_|.
+  std::atomic<int> pinned_young_pages_{0};
+
   // Classes in "heap" can be friends.
   friend class ActivateMemoryReducerTask;
   friend class AlwaysAllocateScope;
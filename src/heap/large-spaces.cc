@@ -261,7 +261,8 @@ void LargeObjectSpace::ShrinkPageToObjectSize(LargePage* page,
     // Object shrunk enough that we can even free some OS pages.
     if (used_committed_size < page->size()) {
       const size_t bytes_to_free = page->size() - used_committed_size;
-      heap()->memory_allocator()->PartialFreeMemory(
+      // Only update the page here and leave the system calls to the Unmapper.
+      heap()->memory_allocator()->PartialFreeMemoryConcurrently(
           page, page->address() + used_committed_size, bytes_to_free,
           new_area_end);
       size_ -= bytes_to_free;
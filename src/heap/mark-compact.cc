@@ -51,6 +51,7 @@
 #include "src/heap/memory-measurement-inl.h"
 #include "src/heap/memory-measurement.h"
 #include "src/heap/new-spaces.h"
+#include "src/heap/numa-work-items.h"
 #include "src/heap/object-stats.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/page-inl.h"
@@ -508,6 +509,14 @@ void MarkCompactCollector::ComputeEvacuationHeuristics(
       *target_fragmentation_percent = kTargetFragmentationPercent;
     }
     *max_evacuated_bytes = kMaxEvacuatedBytes;
+    if (v8_flags.compaction_pause_budget_ms > 0 &&
+        estimated_compaction_speed != 0) {
+      // The speed is measured per evacuator, and evacuators copy pages in
+      // parallel.
+      *max_evacuated_bytes = static_cast<size_t>(
+          v8_flags.compaction_pause_budget_ms * estimated_compaction_speed *
+          NumberOfParallelCompactionTasks(heap_));
+    }
   }
 }
 
@@ -553,11 +562,8 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
   for (Page* p : *space) {
     if (p->NeverEvacuate() || !p->CanAllocate()) continue;
 
-    if (p->IsPinned()) {
-      DCHECK(
-          !p->IsFlagSet(MemoryChunk::FORCE_EVACUATION_CANDIDATE_FOR_TESTING));
-      continue;
-    }
+    // Pages with pinned objects are never evacuated, see Heap::PinObject.
+    if (p->IsPinned()) continue;
 
     // Invariant: Evacuation candidates are just created when marking is
     // started. This means that sweeping has finished. Furthermore, at the end
@@ -837,7 +843,10 @@ void MarkCompactCollector::Finish() {
   DCHECK(!heap_->memory_allocator()->unmapper()->IsRunning());
 
   // Shrink pages if possible after processing and filtering slots.
-  ShrinkPagesToObjectSizes(heap_, heap_->lo_space());
+  {
+    TRACE_GC(heap_->tracer(), GCTracer::Scope::MC_FINISH_SHRINK_LARGE_PAGES);
+    ShrinkPagesToObjectSizes(heap_, heap_->lo_space());
+  }
 
 #ifdef DEBUG
   DCHECK(state_ == SWEEP_SPACES || state_ == RELOCATE_OBJECTS);
@@ -1078,7 +1087,8 @@ class MarkCompactCollector::SharedHeapObjectVisitor final
 
 class InternalizedStringTableCleaner final : public RootVisitor {
  public:
-  explicit InternalizedStringTableCleaner(Heap* heap) : heap_(heap) {}
+  InternalizedStringTableCleaner(Heap* heap, StringTable* string_table)
+      : heap_(heap), string_table_(string_table) {}
 
   void VisitRootPointers(Root root, const char* description,
                          FullObjectSlot start, FullObjectSlot end) override {
@@ -1100,8 +1110,7 @@ class InternalizedStringTableCleaner final : public RootVisitor {
         if (!heap_object.InReadOnlySpace() &&
             marking_state->IsUnmarked(heap_object)) {
           pointers_removed_++;
-          // Set the entry to the_hole_value (as deleted).
-          p.store(StringTable::deleted_element());
+          string_table_->DeleteElement(p);
         }
       }
     }
@@ -1111,6 +1120,7 @@ class InternalizedStringTableCleaner final : public RootVisitor {
 
  private:
   Heap* heap_;
+  StringTable* const string_table_;
   int pointers_removed_ = 0;
 };
 
@@ -2569,7 +2579,8 @@ class ClearStringTableJobItem final : public ParallelClearingJob::ClearingItem {
       // string table.  Cannot use string_table() here because the string
       // table is marked.
       StringTable* string_table = isolate_->string_table();
-      InternalizedStringTableCleaner internalized_visitor(isolate_->heap());
+      InternalizedStringTableCleaner internalized_visitor(isolate_->heap(),
+                                                          string_table);
       string_table->DropOldData();
       string_table->IterateElements(&internalized_visitor);
       string_table->NotifyElementsRemoved(
@@ -2672,6 +2683,12 @@ class FullStringForwardingTableCleaner final
       return;
     }
 
+    // Pinned strings must keep their characters, see v8::PinnedContentsScope.
+    if (Heap::IsPinned(original_string)) {
+      DisposeExternalResource(record);
+      return;
+    }
+
     bool is_one_byte;
     v8::String::ExternalStringResourceBase* external_resource =
         record->external_resource(&is_one_byte);
@@ -2692,6 +2709,9 @@ class FullStringForwardingTableCleaner final
   void TryInternalize(Tagged<String> original_string,
                       StringForwardingTable::Record* record) {
     if (IsInternalizedString(original_string)) return;
+    // Pinned strings must keep their characters, see v8::PinnedContentsScope.
+    // TransitionStrings still restores their hash.
+    if (Heap::IsPinned(original_string)) return;
     Tagged<Object> forward = record->ForwardStringObjectOrHash(isolate_);
     if (!IsHeapObject(forward)) {
       return;
@@ -4150,7 +4170,9 @@ class PageEvacuationJob : public v8::JobTask {
         generator_(evacuation_items_.size()),
         tracer_(isolate->heap()->tracer()),
         trace_id_(reinterpret_cast<uint64_t>(this) ^
-                  tracer_->CurrentEpoch(GCTracer::Scope::MC_EVACUATE)) {}
+                  tracer_->CurrentEpoch(GCTracer::Scope::MC_EVACUATE)) {
+    if (NumaWorkItems::IsEnabled()) NumaWorkItems::Sort(evacuation_items_);
+  }
 
   void Run(JobDelegate* delegate) override {
     // In case multi-cage pointer compression mode is enabled ensure that
@@ -4172,6 +4194,16 @@ class PageEvacuationJob : public v8::JobTask {
   }
 
   void ProcessItems(JobDelegate* delegate, Evacuator* evacuator) {
+    if (NumaWorkItems::IsEnabled()) {
+      auto evacuate_page = [evacuator](MemoryChunk* chunk) {
+        evacuator->EvacuatePage(chunk);
+      };
+      if (!NumaWorkItems::ProcessItemsOnNode(
+              evacuation_items_, delegate->GetNumaNode(),
+              &remaining_evacuation_items_, evacuate_page)) {
+        return;
+      }
+    }
     while (remaining_evacuation_items_.load(std::memory_order_relaxed) > 0) {
       base::Optional<size_t> index = generator_.GetNext();
       if (!index) return;
@@ -4312,7 +4344,7 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
         heap_->ShouldReduceMemory() ? MemoryReductionMode::kShouldReduceMemory
                                     : MemoryReductionMode::kNone;
     if (ShouldMovePage(page, live_bytes_on_page, memory_reduction_mode) ||
-        force_page_promotion) {
+        force_page_promotion || page->IsPinned()) {
       EvacuateNewToOldSpacePageVisitor::Move(page);
       page->SetFlag(Page::PAGE_NEW_OLD_PROMOTION);
       DCHECK_EQ(heap_->old_space(), page->owner());
@@ -4335,6 +4367,15 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
     }
   }
 
+  // Objects may have been pinned after the evacuation candidates were
+  // selected.
+  for (Page* page : old_space_evacuation_pages_) {
+    if (page->IsPinned() && !page->IsFlagSet(Page::COMPACTION_WAS_ABORTED)) {
+      ReportAbortedEvacuationCandidateDueToFlags(page->area_start(), page);
+    }
+  }
+  heap_->ReportPinnedPages();
+
   if (v8_flags.stress_compaction || v8_flags.stress_compaction_random) {
     // Stress aborting of evacuation by aborting ~10% of evacuation candidates
     // when stress testing.
@@ -4349,12 +4390,17 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
     }
   }
 
+  size_t compacted_pages = 0;
+  size_t compacted_bytes = 0;
   for (Page* page : old_space_evacuation_pages_) {
     if (page->IsFlagSet(Page::COMPACTION_WAS_ABORTED)) continue;
 
     live_bytes += page->live_bytes();
+    compacted_pages++;
+    compacted_bytes += page->live_bytes();
     evacuation_items.emplace_back(ParallelWorkItem{}, page);
   }
+  heap_->tracer()->NotifyCompaction(compacted_pages, compacted_bytes);
 
   // Promote young generation large objects.
   if (auto* new_lo_space = heap_->new_lo_space()) {
@@ -4646,8 +4692,9 @@ class RememberedSetUpdatingItem : public UpdatingItem {
       const PtrComprCageBase cage_base = heap_->isolate();
       // Marking bits are cleared already when the page is already swept. This
       // is fine since in that case the sweeper has already removed dead invalid
-      // objects as well.
-      RememberedSet<old_to_new_type>::Iterate(
+      // objects as well. The slot set is owned by this item and no slots are
+      // inserted concurrently, so it can be scanned non-atomically.
+      RememberedSet<old_to_new_type>::template Iterate<AccessMode::NON_ATOMIC>(
           chunk_,
           [this, cage_base](MaybeObjectSlot slot) {
             CheckAndUpdateOldToNewSlot(slot, cage_base);
@@ -5075,7 +5122,7 @@ void MarkCompactCollector::StartSweepNewSpace() {
   DCHECK_EQ(Heap::ResizeNewSpaceMode::kNone, resize_new_space_);
   resize_new_space_ = heap_->ShouldResizeNewSpace();
   if (resize_new_space_ == Heap::ResizeNewSpaceMode::kShrink) {
-    paged_space->StartShrinking();
+    paged_space->StartShrinking(heap_->new_space_resize_target_);
   }
 
   DCHECK(empty_new_space_pages_to_be_swept_.empty());
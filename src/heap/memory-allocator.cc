@@ -4,9 +4,12 @@
 
 #include "src/heap/memory-allocator.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 #include "src/base/address-region.h"
+#include "src/base/platform/huge-pages.h"
+#include "src/base/platform/numa.h"
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
 #include "src/flags/flags.h"
@@ -30,6 +33,7 @@ namespace internal {
 
 size_t MemoryAllocator::commit_page_size_ = 0;
 size_t MemoryAllocator::commit_page_size_bits_ = 0;
+size_t MemoryAllocator::huge_page_size_ = 0;
 
 MemoryAllocator::MemoryAllocator(Isolate* isolate,
                                  v8::PageAllocator* code_page_allocator,
@@ -155,8 +159,27 @@ void MemoryAllocator::Unmapper::EnsureUnmappingCompleted() {
   PerformFreeMemoryOnQueuedChunks(FreeMode::kFreePooled);
 }
 
+void MemoryAllocator::Unmapper::PerformQueuedPartialFrees(
+    JobDelegate* delegate) {
+  while (true) {
+    PartialFree partial_free;
+    {
+      base::MutexGuard guard(&mutex_);
+      if (partial_frees_.empty()) return;
+      partial_free = partial_frees_.back();
+      partial_frees_.pop_back();
+    }
+    const size_t released_bytes =
+        partial_free.chunk->reserved_memory()->Release(partial_free.start_free);
+    DCHECK_GE(allocator_->size_, released_bytes);
+    allocator_->size_ -= released_bytes;
+    if (delegate && delegate->ShouldYield()) return;
+  }
+}
+
 void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedNonRegularChunks(
     JobDelegate* delegate) {
+  PerformQueuedPartialFrees(delegate);
   MemoryChunk* chunk = nullptr;
   while ((chunk = GetMemoryChunkSafe(ChunkQueueType::kNonRegular)) != nullptr) {
     allocator_->PerformFreeMemory(chunk);
@@ -177,33 +200,92 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
   while ((chunk = GetMemoryChunkSafe(ChunkQueueType::kRegular)) != nullptr) {
     bool pooled = chunk->IsFlagSet(MemoryChunk::POOLED);
     allocator_->PerformFreeMemory(chunk);
-    if (pooled) AddMemoryChunkSafe(ChunkQueueType::kPooled, chunk);
+    if (pooled) {
+      AddMemoryChunkSafe(UsesHugePages() ? ChunkQueueType::kPooledCommitted
+                                         : ChunkQueueType::kPooled,
+                         chunk);
+    }
     if (delegate && delegate->ShouldYield()) return;
   }
   if (mode == MemoryAllocator::Unmapper::FreeMode::kFreePooled) {
     // The previous loop uncommitted any pages marked as pooled and added them
     // to the pooled list. In case of kFreePooled we need to free them though as
     // well.
+    while ((chunk = GetMemoryChunkSafe(ChunkQueueType::kPooledCommitted)) !=
+           nullptr) {
+      allocator_->FreePooledChunk(chunk);
+      if (delegate && delegate->ShouldYield()) return;
+    }
     while ((chunk = GetMemoryChunkSafe(ChunkQueueType::kPooled)) != nullptr) {
       allocator_->FreePooledChunk(chunk);
       if (delegate && delegate->ShouldYield()) return;
     }
+  } else if (UsesHugePages()) {
+    UncommitPooledHugePages();
   }
   PerformFreeMemoryOnQueuedNonRegularChunks();
 }
 
+void MemoryAllocator::Unmapper::UncommitPooledHugePages() {
+  // Pooled chunks are aligned to their size within the pointer compression
+  // cage, so the chunks of a huge page are found by grouping them by the huge
+  // page that contains them.
+  const size_t huge_page_size =
+      std::max(huge_page_size_, static_cast<size_t>(MemoryChunk::kPageSize));
+  const size_t chunks_per_huge_page = huge_page_size / MemoryChunk::kPageSize;
+  std::vector<MemoryChunk*> uncommit;
+  {
+    base::MutexGuard guard(&mutex_);
+    std::vector<MemoryChunk*>& committed =
+        chunks_[ChunkQueueType::kPooledCommitted];
+    if (committed.size() < chunks_per_huge_page) return;
+    std::sort(committed.begin(), committed.end());
+    std::vector<MemoryChunk*> keep;
+    for (size_t begin = 0; begin < committed.size();) {
+      const Address huge_page =
+          RoundDown(committed[begin]->address(), huge_page_size);
+      size_t end = begin + 1;
+      while (end < committed.size() &&
+             RoundDown(committed[end]->address(), huge_page_size) ==
+                 huge_page) {
+        end++;
+      }
+      std::vector<MemoryChunk*>& target =
+          end - begin == chunks_per_huge_page ? uncommit : keep;
+      target.insert(target.end(), committed.begin() + begin,
+                    committed.begin() + end);
+      begin = end;
+    }
+    committed.swap(keep);
+  }
+  // The chunks taken out of the pool are sorted, so every run of
+  // |chunks_per_huge_page| chunks covers one whole huge page.
+  for (size_t i = 0; i < uncommit.size(); i += chunks_per_huge_page) {
+    const Address huge_page = uncommit[i]->address();
+    const bool uncommitted = allocator_->data_page_allocator()->SetPermissions(
+        reinterpret_cast<void*>(huge_page), huge_page_size,
+        PageAllocator::kNoAccess);
+    for (size_t j = i; j < i + chunks_per_huge_page; j++) {
+      AddMemoryChunkSafe(uncommitted ? ChunkQueueType::kPooled
+                                     : ChunkQueueType::kPooledCommitted,
+                         uncommit[j]);
+    }
+  }
+}
+
 void MemoryAllocator::Unmapper::TearDown() {
   CHECK(!job_handle_ || !job_handle_->IsValid());
   PerformFreeMemoryOnQueuedChunks(FreeMode::kFreePooled);
   for (int i = 0; i < ChunkQueueType::kNumberOfChunkQueues; i++) {
     DCHECK(chunks_[i].empty());
   }
+  DCHECK(partial_frees_.empty());
 }
 
 size_t MemoryAllocator::Unmapper::NumberOfCommittedChunks() {
   base::MutexGuard guard(&mutex_);
   return chunks_[ChunkQueueType::kRegular].size() +
-         chunks_[ChunkQueueType::kNonRegular].size();
+         chunks_[ChunkQueueType::kNonRegular].size() + partial_frees_.size();
 }
 
 int MemoryAllocator::Unmapper::NumberOfChunks() {
@@ -212,6 +294,7 @@ int MemoryAllocator::Unmapper::NumberOfChunks() {
   for (int i = 0; i < ChunkQueueType::kNumberOfChunkQueues; i++) {
     result += chunks_[i].size();
   }
+  result += partial_frees_.size();
   return static_cast<int>(result);
 }
 
@@ -220,13 +303,18 @@ size_t MemoryAllocator::Unmapper::CommittedBufferedMemory() {
 
   size_t sum = 0;
   // kPooled chunks are already uncommited. We only have to account for
-  // kRegular and kNonRegular chunks.
+  // kRegular, kPooledCommitted and kNonRegular chunks.
   for (auto& chunk : chunks_[ChunkQueueType::kRegular]) {
     sum += chunk->size();
   }
+  sum += chunks_[ChunkQueueType::kPooledCommitted].size() *
+         MemoryChunk::kPageSize;
   for (auto& chunk : chunks_[ChunkQueueType::kNonRegular]) {
     sum += chunk->size();
   }
+  for (auto& partial_free : partial_frees_) {
+    sum += partial_free.bytes_to_free;
+  }
   return sum;
 }
 
@@ -387,6 +475,8 @@ MemoryAllocator::AllocateUninitializedChunkAt(BaseSpace* space,
       chunk_size, area_size, MemoryChunk::kAlignment, space->identity(),
       executable, reinterpret_cast<void*>(hint), &reservation);
   if (base == kNullAddress) return {};
+  // None of the chunk has been touched yet, so all of it is placed.
+  const int numa_node = PlaceOnCurrentNumaNode(base, chunk_size);
 
   size_ += reservation.size();
 
@@ -430,7 +520,7 @@ MemoryAllocator::AllocateUninitializedChunkAt(BaseSpace* space,
 
   return MemoryChunkAllocationResult{
       reinterpret_cast<void*>(base), chunk_size, area_start, area_end,
-      std::move(reservation),
+      std::move(reservation), numa_node,
   };
 }
 
@@ -465,6 +555,17 @@ void MemoryAllocator::PartialFreeMemory(BasicMemoryChunk* chunk,
   size_ -= released_bytes;
 }
 
+void MemoryAllocator::PartialFreeMemoryConcurrently(MemoryChunk* chunk,
+                                                    Address start_free,
+                                                    size_t bytes_to_free,
+                                                    Address new_area_end) {
+  DCHECK(chunk->reserved_memory()->IsReserved());
+  DCHECK(!chunk->IsFlagSet(MemoryChunk::IS_EXECUTABLE));
+  chunk->set_size(chunk->size() - bytes_to_free);
+  chunk->set_area_end(new_area_end);
+  unmapper()->AddPartialFreeSafe(chunk, start_free, bytes_to_free);
+}
+
 void MemoryAllocator::UnregisterSharedBasicMemoryChunk(
     BasicMemoryChunk* chunk) {
   VirtualMemory* reservation = chunk->reserved_memory();
@@ -552,7 +653,10 @@ void MemoryAllocator::PerformFreeMemory(MemoryChunk* chunk) {
 
   VirtualMemory* reservation = chunk->reserved_memory();
   if (chunk->IsFlagSet(MemoryChunk::POOLED)) {
-    UncommitMemory(reservation);
+    // Uncommitting a single page would split the huge page backing it. Pooled
+    // pages are kept committed instead and uncommitted together once all
+    // pages of a huge page are pooled, see UncommitPooledHugePages().
+    if (!UsesHugePages()) UncommitMemory(reservation);
   } else {
     DCHECK(reservation->IsReserved());
     reservation->Free();
@@ -618,6 +722,7 @@ Page* MemoryAllocator::AllocatePage(MemoryAllocator::AllocationMode alloc_mode,
   if (page->executable()) RegisterExecutableMemoryChunk(page);
 #endif  // DEBUG
 
+  page->set_numa_node(chunk_info->numa_node);
   space->InitializePage(page);
   RecordNormalPageCreated(*page);
   return page;
@@ -659,13 +764,15 @@ LargePage* MemoryAllocator::AllocateLargePage(LargeObjectSpace* space,
   if (page->executable()) RegisterExecutableMemoryChunk(page);
 #endif  // DEBUG
 
+  page->set_numa_node(chunk_info->numa_node);
   RecordLargePageCreated(*page);
   return page;
 }
 
 base::Optional<MemoryAllocator::MemoryChunkAllocationResult>
 MemoryAllocator::AllocateUninitializedPageFromPool(Space* space) {
-  void* chunk = unmapper()->TryGetPooledMemoryChunkSafe();
+  bool committed;
+  void* chunk = unmapper()->TryGetPooledMemoryChunkSafe(&committed);
   if (chunk == nullptr) return {};
   const int size = MemoryChunk::kPageSize;
   const Address start = reinterpret_cast<Address>(chunk);
@@ -678,13 +785,17 @@ MemoryAllocator::AllocateUninitializedPageFromPool(Space* space) {
   DCHECK_NE(TRUSTED_SPACE, space->identity());
   VirtualMemory reservation(data_page_allocator(), start, size);
   if (!CommitMemory(&reservation, NOT_EXECUTABLE)) return {};
+  // Only chunks whose memory was uncommitted are faulted in afresh. The pages
+  // of other chunks stay where they are, so those chunks are not placed.
+  const int numa_node = committed ? base::Numa::kNoNode
+                                  : PlaceOnCurrentNumaNode(start, size);
   if (heap::ShouldZapGarbage()) {
     heap::ZapBlock(start, size, kZapValue);
   }
 
   size_ += size;
   return MemoryChunkAllocationResult{
-      chunk, size, area_start, area_end, std::move(reservation),
+      chunk, size, area_start, area_end, std::move(reservation), numa_node,
   };
 }
 
@@ -694,11 +805,15 @@ void MemoryAllocator::InitializeOncePerProcess() {
                           : CommitPageSize();
   CHECK(base::bits::IsPowerOfTwo(commit_page_size_));
   commit_page_size_bits_ = base::bits::WhichPowerOfTwo(commit_page_size_);
+  huge_page_size_ = v8_flags.huge_pages ? base::HugePages::PageSize() : 0;
 }
 
 base::AddressRegion MemoryAllocator::ComputeDiscardMemoryArea(Address addr,
                                                               size_t size) {
-  size_t page_size = GetCommitPageSize();
+  // Discarding part of a huge page would split it, so only whole huge pages
+  // are discarded when heap memory is backed by huge pages.
+  size_t page_size = std::max(static_cast<size_t>(GetCommitPageSize()),
+                              UsesHugePages() ? huge_page_size_ : 0);
   if (size < page_size + FreeSpace::kSize) {
     return base::AddressRegion(0, 0);
   }
@@ -840,6 +955,21 @@ const BasicMemoryChunk* MemoryAllocator::LookupChunkContainingAddress(
 
 #endif  // V8_ENABLE_CONSERVATIVE_STACK_SCANNING || DEBUG
 
+int MemoryAllocator::PlaceOnCurrentNumaNode(Address start, size_t size) {
+  if (!v8_flags.numa_aware_heap || base::Numa::NumberOfNodes() < 2) {
+    return base::Numa::kNoNode;
+  }
+  int node = base::Numa::GetCurrentNode();
+  if (node == base::Numa::kNoNode) return base::Numa::kNoNode;
+  // The policy only applies to pages that are faulted in from now on; pages
+  // that are already present are not moved.
+  if (!base::Numa::SetPreferredNode(reinterpret_cast<void*>(start), size,
+                                    node)) {
+    return base::Numa::kNoNode;
+  }
+  return node;
+}
+
 void MemoryAllocator::RecordNormalPageCreated(const Page& page) {
 #ifdef V8_ENABLE_CONSERVATIVE_STACK_SCANNING
   base::MutexGuard guard(&pages_mutex_);
@@ -17,6 +17,7 @@
 #include "src/base/functional.h"
 #include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/numa.h"
 #include "src/base/platform/semaphore.h"
 #include "src/common/globals.h"
 #include "src/heap/basic-memory-chunk.h"
@@ -64,15 +65,35 @@ class MemoryAllocator {
       }
     }
 
-    MemoryChunk* TryGetPooledMemoryChunkSafe() {
+    // Queues the release of the memory behind |start_free| of a chunk whose
+    // size was already reduced by |bytes_to_free|, see
+    // MemoryAllocator::PartialFreeMemoryConcurrently.
+    void AddPartialFreeSafe(MemoryChunk* chunk, Address start_free,
+                            size_t bytes_to_free) {
+      base::MutexGuard guard(&mutex_);
+      partial_frees_.push_back({chunk, start_free, bytes_to_free});
+    }
+
+    // Returns a chunk of kPageSize for reuse, or nullptr. |committed| is set
+    // when the chunk's memory was not uncommitted in the meantime, i.e. its
+    // pages may still be present.
+    MemoryChunk* TryGetPooledMemoryChunkSafe(bool* committed) {
       // Procedure:
-      // (1) Try to get a chunk that was declared as pooled and already has
+      // (1) Try to get a pooled chunk that is still committed because heap
+      // memory is backed by huge pages.
+      // (2) Try to get a chunk that was declared as pooled and already has
       // been uncommitted.
-      // (2) Try to steal any memory chunk of kPageSize that would've been
+      // (3) Try to steal any memory chunk of kPageSize that would've been
       // uncommitted.
-      MemoryChunk* chunk = GetMemoryChunkSafe(ChunkQueueType::kPooled);
+      MemoryChunk* chunk = GetMemoryChunkSafe(ChunkQueueType::kPooledCommitted);
+      *committed = true;
+      if (chunk == nullptr) {
+        chunk = GetMemoryChunkSafe(ChunkQueueType::kPooled);
+        *committed = false;
+      }
       if (chunk == nullptr) {
         chunk = GetMemoryChunkSafe(ChunkQueueType::kRegular);
+        *committed = true;
         if (chunk != nullptr) {
           // For stolen chunks we need to manually free any allocated memory.
           chunk->ReleaseAllAllocatedMemory();
@@ -102,6 +123,8 @@ class MemoryAllocator {
                     // TrustedRange and can thus be used for stealing.
       kNonRegular,  // Large chunks and executable chunks.
       kPooled,      // Pooled chunks, already freed and ready for reuse.
+      kPooledCommitted,  // Pooled chunks that are kept committed because
+                         // uncommitting them alone would split a huge page.
       kNumberOfChunkQueues,
     };
 
@@ -126,18 +149,33 @@ class MemoryAllocator {
       return chunk;
     }
 
+    struct PartialFree {
+      MemoryChunk* chunk;
+      Address start_free;
+      size_t bytes_to_free;
+    };
+
     bool MakeRoomForNewTasks();
 
+    void PerformQueuedPartialFrees(JobDelegate* delegate = nullptr);
+
     void PerformFreeMemoryOnQueuedChunks(FreeMode mode,
                                          JobDelegate* delegate = nullptr);
 
     void PerformFreeMemoryOnQueuedNonRegularChunks(
         JobDelegate* delegate = nullptr);
 
+    // Uncommits the committed pooled chunks that together cover whole huge
+    // pages and moves them to the uncommitted pool.
+    void UncommitPooledHugePages();
+
     Heap* const heap_;
     MemoryAllocator* const allocator_;
     base::Mutex mutex_;
     std::vector<MemoryChunk*> chunks_[ChunkQueueType::kNumberOfChunkQueues];
+    // Tails of shrunk large pages. The pages are live, and the queues are
+    // drained before the next GC can free them.
+    std::vector<PartialFree> partial_frees_;
     std::unique_ptr<v8::JobHandle> job_handle_;
 
     friend class MemoryAllocator;
@@ -177,6 +215,13 @@ class MemoryAllocator {
     return commit_page_size_bits_;
   }
 
+  // Returns whether heap memory is backed by transparent huge pages, see
+  // --huge-pages. Only the pointer compression cage aligns regular pages to
+  // huge pages; without it only the code range uses them.
+  static bool UsesHugePages() {
+    return COMPRESS_POINTERS_BOOL && huge_page_size_ > 0;
+  }
+
   // Computes the memory area of discardable memory within a given memory area
   // [addr, addr+size) and returns the result as base::AddressRegion. If the
   // memory is not discardable base::AddressRegion is an empty region.
@@ -251,6 +296,13 @@ class MemoryAllocator {
   void PartialFreeMemory(BasicMemoryChunk* chunk, Address start_free,
                          size_t bytes_to_free, Address new_area_end);
 
+  // Like PartialFreeMemory, but the size and area of |chunk| are updated right
+  // away while the memory is released by the Unmapper, which is started with
+  // Unmapper::FreeQueuedChunks. Only for non-executable chunks.
+  void PartialFreeMemoryConcurrently(MemoryChunk* chunk, Address start_free,
+                                     size_t bytes_to_free,
+                                     Address new_area_end);
+
 #ifdef DEBUG
   // Checks if an allocated MemoryChunk was intended to be used for executable
   // memory.
@@ -310,6 +362,11 @@ class MemoryAllocator {
   void RecordLargePageDestroyed(const LargePage& page);
 
  private:
+  // With --numa-aware-heap, makes the not yet faulted in memory range
+  // [start, start+size) prefer memory from the NUMA node of the current thread.
+  // Returns that node, or kNoNode if the range was not placed.
+  int PlaceOnCurrentNumaNode(Address start, size_t size);
+
   // Used to store all data about MemoryChunk allocation, e.g. in
   // AllocateUninitializedChunk.
   struct MemoryChunkAllocationResult {
@@ -318,6 +375,9 @@ class MemoryAllocator {
     size_t area_start;
     size_t area_end;
     VirtualMemory reservation;
+    // The NUMA node the chunk's memory is placed on, see
+    // PlaceOnCurrentNumaNode().
+    int numa_node = base::Numa::kNoNode;
   };
 
   // Computes the size of a MemoryChunk from the size of the object_area and
@@ -517,6 +577,8 @@ class MemoryAllocator {
 
   V8_EXPORT_PRIVATE static size_t commit_page_size_;
   V8_EXPORT_PRIVATE static size_t commit_page_size_bits_;
+  // Size of the huge pages backing heap memory, or 0 if not using huge pages.
+  static size_t huge_page_size_;
 
   friend class heap::TestCodePageAllocatorScope;
   friend class heap::TestMemoryAllocatorScope;
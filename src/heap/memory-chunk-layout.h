@@ -69,6 +69,7 @@ class V8_EXPORT_PRIVATE MemoryChunkLayout {
     FIELD(ActiveSystemPages*, ActiveSystemPages),
     FIELD(size_t, AllocatedLabSize),
     FIELD(size_t, AgeInNewSpace),
+    FIELD(intptr_t, NumaNode),
     FIELD(MarkingBitmap, MarkingBitmap),
     kEndOfMarkingBitmap,
     kMemoryChunkHeaderSize =
@@ -331,6 +331,8 @@ void MemoryChunk::ValidateOffsets(MemoryChunk* chunk) {
   DCHECK_EQ(
       reinterpret_cast<Address>(&chunk->age_in_new_space_) - chunk->address(),
       MemoryChunkLayout::kAgeInNewSpaceOffset);
+  DCHECK_EQ(reinterpret_cast<Address>(&chunk->numa_node_) - chunk->address(),
+            MemoryChunkLayout::kNumaNodeOffset);
 }
 #endif
 
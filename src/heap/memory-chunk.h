@@ -9,6 +9,7 @@
 
 #include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/numa.h"
 #include "src/common/globals.h"
 #include "src/heap/base/active-system-pages.h"
 #include "src/heap/basic-memory-chunk.h"
@@ -233,6 +234,11 @@ class MemoryChunk : public BasicMemoryChunk {
   void ResetAgeInNewSpace() { age_in_new_space_ = 0; }
   size_t AgeInNewSpace() const { return age_in_new_space_; }
 
+  // The NUMA node that the chunk's memory prefers, or base::Numa::kNoNode.
+  // Only set with --numa-aware-heap.
+  int numa_node() const { return static_cast<int>(numa_node_); }
+  void set_numa_node(int node) { numa_node_ = node; }
+
   void ResetAllocationStatistics() {
     BasicMemoryChunk::ResetAllocationStatistics();
     allocated_lab_size_ = 0;
@@ -342,6 +348,8 @@ class MemoryChunk : public BasicMemoryChunk {
   // counter is reset to 0 whenever the page is empty.
   size_t age_in_new_space_ = 0;
 
+  intptr_t numa_node_ = base::Numa::kNoNode;
+
   MarkingBitmap marking_bitmap_;
 
  private:
@@ -245,8 +245,11 @@ class NewSpace : NON_EXPORTED_BASE(public SpaceWithLinearArea) {
   virtual size_t MaximumCapacity() const = 0;
   virtual size_t AllocatedSinceLastGC() const = 0;
 
-  // Grow the capacity of the space.
+  // Grow the capacity of the space by --semi-space-growth-factor.
   virtual void Grow() = 0;
+  // Grow the capacity of the space to |new_capacity|, rounded up to the page
+  // size and limited to the maximum capacity.
+  virtual void GrowTo(size_t new_capacity) = 0;
 
   virtual void MakeIterable() = 0;
 
@@ -300,9 +303,12 @@ class V8_EXPORT_PRIVATE SemiSpaceNewSpace final : public NewSpace {
   // Grow the capacity of the semispaces.  Assumes that they are not at
   // their maximum capacity.
   void Grow() final;
+  void GrowTo(size_t new_capacity) final;
 
-  // Shrink the capacity of the semispaces.
-  void Shrink();
+  // Shrink the capacity of the semispaces to |target_capacity|, but not below
+  // twice the size of the objects in them.
+  void Shrink(size_t target_capacity);
+  void Shrink() { Shrink(InitialTotalCapacity()); }
 
   // Return the allocated bytes in the active semispace.
   size_t Size() const final;
@@ -514,9 +520,12 @@ class V8_EXPORT_PRIVATE PagedSpaceForNewSpace final : public PagedSpaceBase {
 
   // Grow the capacity of the space.
   void Grow();
+  void GrowTo(size_t new_capacity);
 
-  // Shrink the capacity of the space.
-  bool StartShrinking();
+  // Shrink the capacity of the space to |target_capacity|, but not below twice
+  // the size of the objects in it.
+  bool StartShrinking(size_t target_capacity);
+  bool StartShrinking() { return StartShrinking(initial_capacity_); }
   void FinishShrinking();
 
   size_t AllocatedSinceLastGC() const;
@@ -621,8 +630,12 @@ class V8_EXPORT_PRIVATE PagedNewSpace final : public NewSpace {
 
   // Grow the capacity of the space.
   void Grow() final { paged_space_.Grow(); }
+  void GrowTo(size_t new_capacity) final { paged_space_.GrowTo(new_capacity); }
 
   // Shrink the capacity of the space.
+  bool StartShrinking(size_t target_capacity) {
+    return paged_space_.StartShrinking(target_capacity);
+  }
   bool StartShrinking() { return paged_space_.StartShrinking(); }
   void FinishShrinking() { paged_space_.FinishShrinking(); }
 
@@ -0,0 +1,76 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_NUMA_WORK_ITEMS_H_
+#define V8_HEAP_NUMA_WORK_ITEMS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "src/base/platform/numa.h"
+#include "src/flags/flags.h"
+#include "src/heap/memory-chunk.h"
+#include "src/heap/parallel-work-item.h"
+
+namespace v8 {
+namespace internal {
+
+// Lets parallel GC jobs whose work items are memory chunks have every worker
+// first process the chunks on its own NUMA node (see --numa-aware-heap) before
+// it helps with the remaining chunks. Work items are either chunks or refer to
+// a chunk in their |chunk| field.
+class NumaWorkItems final {
+ public:
+  template <typename Item>
+  using Items = std::vector<std::pair<ParallelWorkItem, Item>>;
+
+  static bool IsEnabled() {
+    return v8_flags.numa_aware_heap && base::Numa::NumberOfNodes() > 1;
+  }
+
+  // Groups |items| by NUMA node. Must be called before the job starts.
+  template <typename Item>
+  static void Sort(Items<Item>& items) {
+    std::stable_sort(items.begin(), items.end(),
+                     [](const auto& a, const auto& b) {
+                       return NodeOf(a.second) < NodeOf(b.second);
+                     });
+  }
+
+  // Acquires the not yet acquired items on |node| of |items|, which must have
+  // been sorted, and calls |callback| on them. Returns false if
+  // |remaining_items| dropped to zero, i.e. there is no work left at all.
+  template <typename Item, typename Callback>
+  static bool ProcessItemsOnNode(Items<Item>& items, int node,
+                                 std::atomic<size_t>* remaining_items,
+                                 Callback callback) {
+    if (node == base::Numa::kNoNode) return true;
+    auto it = std::lower_bound(items.begin(), items.end(), node,
+                               [](const auto& item, int node) {
+                                 return NodeOf(item.second) < node;
+                               });
+    for (; it != items.end() && NodeOf(it->second) == node; ++it) {
+      if (!it->first.TryAcquire()) continue;
+      callback(it->second);
+      if (remaining_items->fetch_sub(1, std::memory_order_relaxed) <= 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static int NodeOf(const MemoryChunk* chunk) { return chunk->numa_node(); }
+  template <typename Item>
+  static int NodeOf(const Item& item) {
+    return item.chunk->numa_node();
+  }
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_NUMA_WORK_ITEMS_H_
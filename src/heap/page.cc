@@ -64,8 +64,14 @@ Page* Page::ConvertNewToOld(Page* old_page) {
   old_page->ResetAgeInNewSpace();
   OldSpace* old_space = old_page->heap()->old_space();
   old_page->set_owner(old_space);
+  // Pinned objects stay pinned when their page is promoted.
+  const bool pinned = old_page->IsPinned();
   old_page->ClearFlags(Page::kAllFlagsMask);
   Page* new_page = old_space->InitializePage(old_page);
+  if (pinned) {
+    new_page->SetFlag(Page::PINNED);
+    new_page->heap()->NotifyPinnedPagePromoted();
+  }
   old_space->AddPromotedPage(new_page);
   return new_page;
 }
@@ -4,13 +4,20 @@
 
 #include "src/heap/pretenuring-handler.h"
 
+#include <algorithm>
+#include <sstream>
+
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
 #include "src/flags/flags.h"
 #include "src/handles/global-handles-inl.h"
 #include "src/heap/gc-tracer-inl.h"
+#include "src/heap/heap.h"
 #include "src/heap/new-spaces.h"
 #include "src/objects/allocation-site-inl.h"
+#include "src/objects/feedback-vector-inl.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/shared-function-info-inl.h"
 
 namespace v8 {
 namespace internal {
@@ -129,6 +136,29 @@ bool PretenureAllocationSiteManually(Isolate* isolate,
   return deopt;
 }
 
+constexpr char kFeedbackHeader[] = "v8-pretenuring-feedback 1";
+
+// Identifies a function across processes by its position in a named script.
+// Returns false for functions in scripts without a name.
+bool GetFunctionKey(Tagged<SharedFunctionInfo> shared, std::string* key) {
+  Tagged<Object> script = shared->script();
+  if (!IsScript(script)) return false;
+  Tagged<Object> name = Script::cast(script)->name();
+  if (!IsString(name)) return false;
+  std::unique_ptr<char[]> name_chars = String::cast(name)->ToCString();
+  if (strchr(name_chars.get(), '\n')) return false;
+  *key = std::to_string(shared->StartPosition()) + " " +
+         std::to_string(shared->EndPosition()) + " " + name_chars.get();
+  return true;
+}
+
+// Nested sites of a literal are identified by their position in the
+// |nested_site| list of the top-level site.
+std::string GetSiteKey(int slot, int depth, const std::string& function_key) {
+  return std::to_string(slot) + " " + std::to_string(depth) + " " +
+         function_key;
+}
+
 }  // namespace
 
 // static
@@ -200,6 +230,8 @@ void PretenuringHandler::ProcessPretenuringFeedback(
   bool new_space_was_above_pretenuring_threshold =
       new_space_capacity_before_gc >= min_new_space_capacity_for_pretenuring;
 
+  if (v8_flags.allocation_site_lifetime_histograms) UpdateLifetimeIndex();
+
   for (auto& site_and_count : global_pretenuring_feedback_) {
     allocation_sites++;
     site = site_and_count.first;
@@ -213,6 +245,7 @@ void PretenuringHandler::ProcessPretenuringFeedback(
       DCHECK(IsAllocationSite(site));
       active_allocation_sites++;
       allocation_mementos_found += found_count;
+      if (v8_flags.allocation_site_lifetime_histograms) RecordLifetime(site);
       if (DigestPretenuringFeedback(heap_->isolate(), site,
                                     new_space_was_above_pretenuring_threshold,
                                     new_space_capacity_before_gc)) {
@@ -275,6 +308,162 @@ void PretenuringHandler::ProcessPretenuringFeedback(
 
   global_pretenuring_feedback_.clear();
   global_pretenuring_feedback_.reserve(kInitialFeedbackCapacity);
+  // Sites may move before the next GC.
+  lifetime_index_.clear();
+}
+
+void PretenuringHandler::UpdateLifetimeIndex() {
+  DCHECK(lifetime_index_.empty());
+  lifetimes_.erase(
+      std::remove_if(
+          lifetimes_.begin(), lifetimes_.end(),
+          [](const std::unique_ptr<AllocationSiteLifetime>& lifetime) {
+            return lifetime->site == nullptr;
+          }),
+      lifetimes_.end());
+  for (const std::unique_ptr<AllocationSiteLifetime>& lifetime : lifetimes_) {
+    lifetime_index_.emplace(*lifetime->site, lifetime.get());
+  }
+}
+
+void PretenuringHandler::RecordLifetime(Tagged<AllocationSite> site) {
+  const int create_count = site->memento_create_count();
+  const int found_count = site->memento_found_count();
+  if (create_count < kMinMementoCount) return;
+
+  AllocationSiteLifetime*& lifetime = lifetime_index_[site.ptr()];
+  if (!lifetime) {
+    lifetimes_.push_back(std::make_unique<AllocationSiteLifetime>());
+    lifetime = lifetimes_.back().get();
+    lifetime->site =
+        heap_->isolate()->global_handles()->Create(site).location();
+    GlobalHandles::MakeWeak(&lifetime->site);
+  }
+  lifetime->mementos_created += create_count;
+  lifetime->mementos_found += found_count;
+  const double ratio =
+      std::min(1.0, static_cast<double>(found_count) / create_count);
+  const int bucket =
+      std::min(kSurvivalHistogramBuckets - 1,
+               static_cast<int>(ratio * kSurvivalHistogramBuckets));
+  lifetime->survival_histogram[bucket]++;
+}
+
+void PretenuringHandler::ClearLifetimes() {
+  for (const std::unique_ptr<AllocationSiteLifetime>& lifetime : lifetimes_) {
+    if (lifetime->site) GlobalHandles::Destroy(lifetime->site);
+  }
+  lifetimes_.clear();
+  lifetime_index_.clear();
+}
+
+std::string PretenuringHandler::ExportPretenuringFeedback(size_t max_sites) {
+  // Sites do not know which literal they belong to. Find them through the
+  // feedback vectors that hold them.
+  std::unordered_map<Address, std::string> site_keys;
+  {
+    HeapObjectIterator iterator(heap_);
+    for (Tagged<HeapObject> object = iterator.Next(); !object.is_null();
+         object = iterator.Next()) {
+      if (!IsFeedbackVector(object)) continue;
+      Tagged<FeedbackVector> vector = FeedbackVector::cast(object);
+      std::string function_key;
+      if (!GetFunctionKey(vector->shared_function_info(), &function_key)) {
+        continue;
+      }
+      for (int i = 0; i < vector->length(); ++i) {
+        Tagged<HeapObject> feedback;
+        if (!vector->Get(FeedbackSlot(i)).GetHeapObjectIfStrong(&feedback)) {
+          continue;
+        }
+        int depth = 0;
+        for (Tagged<Object> site = feedback; IsAllocationSite(site);
+             site = AllocationSite::cast(site)->nested_site()) {
+          site_keys.emplace(site.ptr(), GetSiteKey(i, depth++, function_key));
+        }
+      }
+    }
+  }
+
+  DisallowGarbageCollection no_gc;
+  std::vector<std::pair<const AllocationSiteLifetime*, const std::string*>>
+      sites;
+  for (const std::unique_ptr<AllocationSiteLifetime>& lifetime : lifetimes_) {
+    if (!lifetime->site) continue;
+    auto it = site_keys.find(*lifetime->site);
+    if (it == site_keys.end()) continue;
+    sites.emplace_back(lifetime.get(), &it->second);
+  }
+  std::sort(sites.begin(), sites.end(), [](const auto& a, const auto& b) {
+    return a.first->mementos_found > b.first->mementos_found;
+  });
+  if (sites.size() > max_sites) sites.resize(max_sites);
+
+  std::string feedback = std::string(kFeedbackHeader) + "\n";
+  for (const auto& [lifetime, key] : sites) {
+    Tagged<AllocationSite> site =
+        AllocationSite::cast(Tagged<Object>(*lifetime->site));
+    feedback += std::to_string(site->pretenure_decision()) + " " +
+                std::to_string(lifetime->mementos_created) + " " +
+                std::to_string(lifetime->mementos_found);
+    for (uint32_t count : lifetime->survival_histogram) {
+      feedback += " " + std::to_string(count);
+    }
+    feedback += " " + *key + "\n";
+  }
+  return feedback;
+}
+
+bool PretenuringHandler::ImportPretenuringFeedback(
+    const std::string& feedback) {
+  std::istringstream lines(feedback);
+  std::string line;
+  if (!std::getline(lines, line) || line != kFeedbackHeader) return false;
+
+  std::unordered_map<std::string, AllocationSite::PretenureDecision> decisions;
+  while (std::getline(lines, line)) {
+    if (line.empty()) continue;
+    std::istringstream fields(line);
+    int decision;
+    size_t mementos_created, mementos_found;
+    if (!(fields >> decision >> mementos_created >> mementos_found)) {
+      return false;
+    }
+    for (int i = 0; i < kSurvivalHistogramBuckets; ++i) {
+      uint32_t count;
+      if (!(fields >> count)) return false;
+    }
+    std::string key;
+    fields >> std::ws;
+    if (!std::getline(fields, key) || key.empty()) return false;
+    // Sites without a final decision collect feedback as usual.
+    if (decision != AllocationSite::kDontTenure &&
+        decision != AllocationSite::kTenure) {
+      continue;
+    }
+    decisions[key] = static_cast<AllocationSite::PretenureDecision>(decision);
+  }
+  for (const auto& [key, decision] : decisions) {
+    imported_decisions_[key] = decision;
+  }
+  return true;
+}
+
+void PretenuringHandler::ApplyImportedPretenuringFeedback(
+    Tagged<FeedbackVector> vector, FeedbackSlot slot,
+    Tagged<AllocationSite> site) {
+  if (imported_decisions_.empty()) return;
+  std::string function_key;
+  if (!GetFunctionKey(vector->shared_function_info(), &function_key)) return;
+  int depth = 0;
+  for (Tagged<Object> current = site; IsAllocationSite(current);
+       current = AllocationSite::cast(current)->nested_site()) {
+    auto it = imported_decisions_.find(
+        GetSiteKey(slot.ToInt(), depth++, function_key));
+    if (it == imported_decisions_.end()) continue;
+    // The site was just created, so no code depends on its decision yet.
+    AllocationSite::cast(current)->set_pretenure_decision(it->second);
+  }
 }
 
 void PretenuringHandler::PretenureAllocationSiteOnNextCollection(
@@ -286,7 +475,10 @@ void PretenuringHandler::PretenureAllocationSiteOnNextCollection(
   allocation_sites_to_pretenure_->Push(site);
 }
 
-void PretenuringHandler::reset() { allocation_sites_to_pretenure_.reset(); }
+void PretenuringHandler::reset() {
+  allocation_sites_to_pretenure_.reset();
+  ClearLifetimes();
+}
 
 }  // namespace internal
 }  // namespace v8
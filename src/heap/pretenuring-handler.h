@@ -5,7 +5,11 @@
 #ifndef V8_HEAP_PRETENURING_HANDLER_H_
 #define V8_HEAP_PRETENURING_HANDLER_H_
 
+#include <array>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "src/objects/allocation-site.h"
 #include "src/objects/heap-object.h"
@@ -14,6 +18,8 @@
 namespace v8 {
 namespace internal {
 
+class FeedbackSlot;
+class FeedbackVector;
 template <typename T>
 class GlobalHandleVector;
 class Heap;
@@ -75,9 +81,48 @@ class PretenuringHandler final {
     return !global_pretenuring_feedback_.empty();
   }
 
+  // ===========================================================================
+  // Feedback export and import. ===============================================
+  // ===========================================================================
+
+  // Bucket i of a survival histogram counts the GCs in which the fraction of
+  // the site's objects that survived was in [i / kBuckets, (i + 1) / kBuckets).
+  static constexpr int kSurvivalHistogramBuckets = 4;
+
+  // Returns the decisions and survival histograms of the |max_sites| sites
+  // with the most surviving objects. Sites are identified by the script,
+  // function and feedback slot that own them, which stay the same across
+  // processes running the same scripts.
+  std::string ExportPretenuringFeedback(size_t max_sites);
+
+  // Imports decisions returned by ExportPretenuringFeedback(). They are
+  // applied to matching literal sites when these are created. Returns false
+  // if |feedback| is malformed.
+  bool ImportPretenuringFeedback(const std::string& feedback);
+
+  // Applies imported decisions to |site| and its nested sites, which were just
+  // created for the literal in |slot|.
+  void ApplyImportedPretenuringFeedback(Tagged<FeedbackVector> vector,
+                                        FeedbackSlot slot,
+                                        Tagged<AllocationSite> site);
+
   V8_EXPORT_PRIVATE static int GetMinMementoCountForTesting();
 
  private:
+  struct AllocationSiteLifetime {
+    // Weak global handle. Cleared when the site dies.
+    Address* site = nullptr;
+    size_t mementos_created = 0;
+    size_t mementos_found = 0;
+    std::array<uint32_t, kSurvivalHistogramBuckets> survival_histogram{};
+  };
+
+  // Drops lifetimes of dead sites and indexes the others by address, which
+  // may have changed in the last GC.
+  void UpdateLifetimeIndex();
+  void RecordLifetime(Tagged<AllocationSite> site);
+  void ClearLifetimes();
+
   Heap* const heap_;
 
   // The feedback storage is used to store allocation sites (keys) and how often
@@ -89,6 +134,16 @@ class PretenuringHandler final {
 
   std::unique_ptr<GlobalHandleVector<AllocationSite>>
       allocation_sites_to_pretenure_;
+
+  // Survival statistics of sites that produced feedback, see
+  // --allocation-site-lifetime-histograms. The index is only valid during
+  // ProcessPretenuringFeedback().
+  std::vector<std::unique_ptr<AllocationSiteLifetime>> lifetimes_;
+  std::unordered_map<Address, AllocationSiteLifetime*> lifetime_index_;
+
+  // Imported decisions keyed by site, see ImportPretenuringFeedback().
+  std::unordered_map<std::string, AllocationSite::PretenureDecision>
+      imported_decisions_;
 };
 
 }  // namespace internal
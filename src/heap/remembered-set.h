@@ -204,15 +204,29 @@ class RememberedSet : public AllStatic {
   static int IterateAndTrackEmptyBuckets(
       MemoryChunk* chunk, Callback callback,
       ::heap::base::Worklist<MemoryChunk*, 64>::Local* empty_chunks) {
+    return IterateAndTrackEmptyBuckets(chunk, 0, chunk->buckets(), callback,
+                                       empty_chunks);
+  }
+
+  // Iterates the buckets [start_bucket, end_bucket). The range that starts at
+  // bucket 0 is responsible for pushing the chunk to |empty_chunks|.
+  template <typename Callback>
+  static int IterateAndTrackEmptyBuckets(
+      MemoryChunk* chunk, size_t start_bucket, size_t end_bucket,
+      Callback callback,
+      ::heap::base::Worklist<MemoryChunk*, 64>::Local* empty_chunks) {
+    DCHECK_LE(end_bucket, chunk->buckets());
     SlotSet* slot_set = chunk->slot_set<type>();
     int slots = 0;
     if (slot_set != nullptr) {
       PossiblyEmptyBuckets* possibly_empty_buckets =
           chunk->possibly_empty_buckets();
-      slots += slot_set->IterateAndTrackEmptyBuckets(chunk->address(), 0,
-                                                     chunk->buckets(), callback,
-                                                     possibly_empty_buckets);
-      if (!possibly_empty_buckets->IsEmpty()) empty_chunks->Push(chunk);
+      slots += slot_set->IterateAndTrackEmptyBuckets(
+          chunk->address(), start_bucket, end_bucket, callback,
+          possibly_empty_buckets);
+      if (start_bucket == 0 && !possibly_empty_buckets->IsEmpty()) {
+        empty_chunks->Push(chunk);
+      }
     }
     return slots;
   }
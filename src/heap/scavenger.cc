@@ -19,6 +19,7 @@
 #include "src/heap/memory-chunk-inl.h"
 #include "src/heap/memory-chunk-layout.h"
 #include "src/heap/memory-chunk.h"
+#include "src/heap/numa-work-items.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/pretenuring-handler.h"
 #include "src/heap/remembered-set-inl.h"
@@ -184,7 +185,8 @@ bool IsUnscavengedHeapObjectSlot(Heap* heap, FullObjectSlot p) {
 ScavengerCollector::JobTask::JobTask(
     ScavengerCollector* outer,
     std::vector<std::unique_ptr<Scavenger>>* scavengers,
-    std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks,
+    std::vector<std::pair<ParallelWorkItem, Scavenger::PageRange>>
+        memory_chunks,
     Scavenger::CopiedList* copied_list,
     Scavenger::PromotionList* promotion_list)
     : outer_(outer),
@@ -196,7 +198,9 @@ ScavengerCollector::JobTask::JobTask(
       promotion_list_(promotion_list),
       trace_id_(
           reinterpret_cast<uint64_t>(this) ^
-          outer_->heap_->tracer()->CurrentEpoch(GCTracer::Scope::SCAVENGER)) {}
+          outer_->heap_->tracer()->CurrentEpoch(GCTracer::Scope::SCAVENGER)) {
+  if (NumaWorkItems::IsEnabled()) NumaWorkItems::Sort(memory_chunks_);
+}
 
 void ScavengerCollector::JobTask::Run(JobDelegate* delegate) {
   DCHECK_LT(delegate->GetTaskId(), scavengers_->size());
@@ -237,7 +241,7 @@ void ScavengerCollector::JobTask::ProcessItems(JobDelegate* delegate,
   double scavenging_time = 0.0;
   {
     TimedScope scope(&scavenging_time);
-    ConcurrentScavengePages(scavenger);
+    ConcurrentScavengePages(delegate, scavenger);
     scavenger->Process(delegate);
   }
   if (v8_flags.trace_parallel_scavenge) {
@@ -249,7 +253,17 @@ void ScavengerCollector::JobTask::ProcessItems(JobDelegate* delegate,
 }
 
 void ScavengerCollector::JobTask::ConcurrentScavengePages(
-    Scavenger* scavenger) {
+    JobDelegate* delegate, Scavenger* scavenger) {
+  if (NumaWorkItems::IsEnabled()) {
+    auto scavenge_page = [scavenger](const Scavenger::PageRange& range) {
+      scavenger->ScavengePage(range);
+    };
+    if (!NumaWorkItems::ProcessItemsOnNode(
+            memory_chunks_, delegate->GetNumaNode(), &remaining_memory_chunks_,
+            scavenge_page)) {
+      return;
+    }
+  }
   while (remaining_memory_chunks_.load(std::memory_order_relaxed) > 0) {
     base::Optional<size_t> index = generator_.GetNext();
     if (!index) return;
@@ -270,6 +284,33 @@ ScavengerCollector::ScavengerCollector(Heap* heap)
 
 namespace {
 
+// Large pages are split into ranges of the buckets of a regular page. The
+// ranges of a page set bits in different words of its possibly empty buckets.
+constexpr size_t kBucketsPerPageRange =
+    RoundUp<PossiblyEmptyBuckets::kBucketsPerWord>(
+        static_cast<size_t>(SlotSet::kBucketsRegularPage));
+
+void AddPageRanges(
+    MemoryChunk* chunk,
+    std::vector<std::pair<ParallelWorkItem, Scavenger::PageRange>>* items) {
+  const size_t buckets = chunk->buckets();
+  // Code pages are not split, as they are made writable while they are
+  // scavenged.
+  if (buckets <= kBucketsPerPageRange ||
+      chunk->IsFlagSet(MemoryChunk::IS_EXECUTABLE)) {
+    items->emplace_back(ParallelWorkItem{},
+                        Scavenger::PageRange{chunk, 0, buckets});
+    return;
+  }
+  chunk->possibly_empty_buckets()->AllocateForConcurrentInsertion(buckets);
+  for (size_t start = 0; start < buckets; start += kBucketsPerPageRange) {
+    items->emplace_back(
+        ParallelWorkItem{},
+        Scavenger::PageRange{chunk, start,
+                             std::min(buckets, start + kBucketsPerPageRange)});
+  }
+}
+
 // Helper class for updating weak global handles. There's no additional scavenge
 // processing required here as this phase runs after actual scavenge.
 class GlobalHandlesWeakRootsUpdatingVisitor final : public RootVisitor {
@@ -344,13 +385,14 @@ void ScavengerCollector::CollectGarbage() {
                         &promotion_list, &ephemeron_table_list, i));
     }
 
-    std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks;
+    std::vector<std::pair<ParallelWorkItem, Scavenger::PageRange>>
+        memory_chunks;
     OldGenerationMemoryChunkIterator::ForAll(
         heap_, [&memory_chunks](MemoryChunk* chunk) {
           if (chunk->slot_set<OLD_TO_NEW>() ||
               chunk->typed_slot_set<OLD_TO_NEW>() ||
               chunk->slot_set<OLD_TO_NEW_BACKGROUND>()) {
-            memory_chunks.emplace_back(ParallelWorkItem{}, chunk);
+            AddPageRanges(chunk, &memory_chunks);
           }
         });
 
@@ -681,13 +723,14 @@ void Scavenger::RememberPromotedEphemeron(Tagged<EphemeronHashTable> table,
   indices.first->second.insert(index);
 }
 
-void Scavenger::ScavengePage(MemoryChunk* page) {
+void Scavenger::ScavengePage(const PageRange& range) {
+  MemoryChunk* page = range.chunk;
   CodePageMemoryModificationScope memory_modification_scope(page);
   const bool record_old_to_shared_slots = heap_->isolate()->has_shared_space();
 
   if (page->slot_set<OLD_TO_NEW, AccessMode::ATOMIC>() != nullptr) {
     RememberedSet<OLD_TO_NEW>::IterateAndTrackEmptyBuckets(
-        page,
+        page, range.start_bucket, range.end_bucket,
         [this, page, record_old_to_shared_slots](MaybeObjectSlot slot) {
           SlotCallbackResult result = CheckAndScavengeObject(heap_, slot);
           // A new space string might have been promoted into the shared heap
@@ -700,27 +743,31 @@ void Scavenger::ScavengePage(MemoryChunk* page) {
         &empty_chunks_local_);
   }
 
-  RememberedSet<OLD_TO_NEW>::IterateTyped(
-      page, [this, page, record_old_to_shared_slots](SlotType slot_type,
-                                                     Address slot_address) {
-        return UpdateTypedSlotHelper::UpdateTypedSlot(
-            heap_, slot_type, slot_address,
-            [this, page, slot_type, slot_address,
-             record_old_to_shared_slots](FullMaybeObjectSlot slot) {
-              SlotCallbackResult result = CheckAndScavengeObject(heap(), slot);
-              // A new space string might have been promoted into the shared
-              // heap during GC.
-              if (result == REMOVE_SLOT && record_old_to_shared_slots) {
-                CheckOldToNewSlotForSharedTyped(page, slot_type, slot_address,
-                                                *slot);
-              }
-              return result;
-            });
-      });
+  // Typed slots are not split into ranges.
+  if (range.start_bucket == 0) {
+    RememberedSet<OLD_TO_NEW>::IterateTyped(
+        page, [this, page, record_old_to_shared_slots](SlotType slot_type,
+                                                       Address slot_address) {
+          return UpdateTypedSlotHelper::UpdateTypedSlot(
+              heap_, slot_type, slot_address,
+              [this, page, slot_type, slot_address,
+               record_old_to_shared_slots](FullMaybeObjectSlot slot) {
+                SlotCallbackResult result =
+                    CheckAndScavengeObject(heap(), slot);
+                // A new space string might have been promoted into the
+                // shared heap during GC.
+                if (result == REMOVE_SLOT && record_old_to_shared_slots) {
+                  CheckOldToNewSlotForSharedTyped(page, slot_type,
+                                                  slot_address, *slot);
+                }
+                return result;
+              });
+        });
+  }
 
   if (page->slot_set<OLD_TO_NEW_BACKGROUND, AccessMode::ATOMIC>() != nullptr) {
     RememberedSet<OLD_TO_NEW_BACKGROUND>::IterateAndTrackEmptyBuckets(
-        page,
+        page, range.start_bucket, range.end_bucket,
         [this, page, record_old_to_shared_slots](MaybeObjectSlot slot) {
           SlotCallbackResult result = CheckAndScavengeObject(heap_, slot);
           // A new space string might have been promoted into the shared heap
@@ -95,9 +95,18 @@ class Scavenger {
             EphemeronRememberedSet::TableList* ephemeron_table_list,
             int task_id);
 
+  // The buckets [start_bucket, end_bucket) of the remembered sets of an old
+  // generation page. Large pages are split into several ranges, so that they
+  // can be scavenged in parallel.
+  struct PageRange {
+    MemoryChunk* chunk;
+    size_t start_bucket;
+    size_t end_bucket;
+  };
+
   // Entry point for scavenging an old generation page. For scavenging single
   // objects see RootScavengingVisitor and ScavengeVisitor below.
-  void ScavengePage(MemoryChunk* page);
+  void ScavengePage(const PageRange& range);
 
   // Processes remaining work (=objects) after single objects have been
   // manually scavenged using ScavengeObject or CheckAndScavengeObject.
@@ -259,7 +268,8 @@ class ScavengerCollector {
     explicit JobTask(
         ScavengerCollector* outer,
         std::vector<std::unique_ptr<Scavenger>>* scavengers,
-        std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks,
+        std::vector<std::pair<ParallelWorkItem, Scavenger::PageRange>>
+            memory_chunks,
         Scavenger::CopiedList* copied_list,
         Scavenger::PromotionList* promotion_list);
 
@@ -270,12 +280,13 @@ class ScavengerCollector {
 
    private:
     void ProcessItems(JobDelegate* delegate, Scavenger* scavenger);
-    void ConcurrentScavengePages(Scavenger* scavenger);
+    void ConcurrentScavengePages(JobDelegate* delegate, Scavenger* scavenger);
 
     ScavengerCollector* outer_;
 
     std::vector<std::unique_ptr<Scavenger>>* scavengers_;
-    std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks_;
+    std::vector<std::pair<ParallelWorkItem, Scavenger::PageRange>>
+        memory_chunks_;
     std::atomic<size_t> remaining_memory_chunks_{0};
     IndexGenerator generator_;
 
@@ -78,6 +78,14 @@ class PossiblyEmptyBuckets {
 
   bool IsEmpty() const { return bitmap_ == kNullAddress; }
 
+  // Allocates the bitmap upfront, after which buckets whose bits are in
+  // different words can be inserted concurrently.
+  void AllocateForConcurrentInsertion(size_t buckets) {
+    if (!IsAllocated()) Allocate(buckets);
+  }
+
+  static constexpr size_t kBucketsPerWord = sizeof(uintptr_t) * kBitsPerByte;
+
  private:
   static constexpr Address kPointerTag = 1;
   static constexpr int kWordSize = sizeof(uintptr_t);
@@ -0,0 +1,105 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/young-generation-controller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap.h"
+#include "src/heap/memory-chunk.h"
+#include "src/heap/new-spaces.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Keeps a few percent of the time for the mutator even if the embedder asks
+// for a throughput of 1.
+constexpr double kMaxThroughputTarget = 0.99;
+
+}  // namespace
+
+YoungGenerationController::YoungGenerationController(
+    Heap* heap, double pause_target_ms, double throughput_target)
+    : heap_(heap) {
+  SetTargets(pause_target_ms, throughput_target);
+}
+
+void YoungGenerationController::SetTargets(double pause_target_ms,
+                                           double throughput_target) {
+  pause_target_ms_ = std::max(0.0, pause_target_ms);
+  throughput_target_ = std::clamp(throughput_target, 0.0, kMaxThroughputTarget);
+}
+
+size_t YoungGenerationController::ComputeCapacity() const {
+  NewSpace* new_space = heap_->new_space();
+  GCTracer* tracer = heap_->tracer();
+  const size_t current_capacity = new_space->TotalCapacity();
+  const double scavenge_speed =
+      tracer->ScavengeSpeedInBytesPerMillisecond(kForSurvivedObjects);
+  if (!tracer->SurvivalEventsRecorded() || scavenge_speed == 0) {
+    return current_capacity;
+  }
+  const double survival_ratio = tracer->AverageSurvivalRatio() / 100;
+  const double allocation_throughput =
+      tracer->NewSpaceAllocationThroughputInBytesPerMillisecond();
+  const size_t capacity = ComputeCapacity(
+      current_capacity, heap_->InitialSemiSpaceSize(),
+      new_space->MaximumCapacity(), survival_ratio, scavenge_speed,
+      allocation_throughput, pause_target_ms_, throughput_target_);
+  if (v8_flags.trace_gc_verbose) {
+    heap_->isolate()->PrintWithTimestamp(
+        "[YoungGenerationController] capacity %zuKB -> %zuKB based on "
+        "survival=%.2f scavenge_speed=%.f allocation_throughput=%.f "
+        "(pause_target=%.1fms, throughput_target=%.2f)\n",
+        current_capacity / KB, capacity / KB, survival_ratio, scavenge_speed,
+        allocation_throughput, pause_target_ms_, throughput_target_);
+  }
+  return capacity;
+}
+
+// static
+size_t YoungGenerationController::ComputeCapacity(
+    size_t current_capacity, size_t min_capacity, size_t max_capacity,
+    double survival_ratio, double scavenge_speed, double allocation_throughput,
+    double pause_target_ms, double throughput_target) {
+  DCHECK_LE(min_capacity, max_capacity);
+  DCHECK_LT(0, scavenge_speed);
+  DCHECK_LT(throughput_target, 1);
+  // Most objects die young, so the bytes that survive a scavenge grow slower
+  // than the capacity. Sizing for the pause assumes that they grow
+  // proportionally, and sizing for throughput assumes that they stay the
+  // same. Both are conservative.
+  const double survived_bytes = survival_ratio * current_capacity;
+  const double pause_ms = survived_bytes / scavenge_speed;
+  const double capacity_for_pause =
+      survival_ratio > 0 ? pause_target_ms * scavenge_speed / survival_ratio
+                         : static_cast<double>(max_capacity);
+  // Scavenges happen every capacity / allocation_throughput ms and take
+  // pause_ms, so the mutator gets
+  //   (capacity / allocation_throughput) /
+  //   (capacity / allocation_throughput + pause_ms)
+  // of the time.
+  const double capacity_for_throughput = allocation_throughput * pause_ms *
+                                         throughput_target /
+                                         (1 - throughput_target);
+  double capacity = std::min(capacity_for_pause, capacity_for_throughput);
+  // Limit the step, as the measurements of a single size are unreliable for
+  // a very different size.
+  capacity = std::min(capacity, static_cast<double>(current_capacity) *
+                                    v8_flags.semi_space_growth_factor);
+  capacity = std::clamp(capacity, static_cast<double>(min_capacity),
+                        static_cast<double>(max_capacity));
+  return std::min(
+      RoundUp(static_cast<size_t>(capacity), MemoryChunk::kPageSize),
+      max_capacity);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,61 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_YOUNG_GENERATION_CONTROLLER_H_
+#define V8_HEAP_YOUNG_GENERATION_CONTROLLER_H_
+
+#include <cstddef>
+
+#include "src/base/macros.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Chooses the capacity of the young generation from the survival rate, the
+// scavenge speed and the allocation throughput that the GCTracer measured.
+// The capacity is the largest one whose scavenges are expected to finish
+// within the pause target, and otherwise the smallest one that keeps the
+// fraction of time spent in scavenges below 1 - throughput target. It stays
+// within the bounds that the embedder configured for the young generation.
+//
+// The controller replaces the fixed growing and shrinking heuristics when
+// --young-generation-controller is passed or the embedder sets targets with
+// Isolate::SetYoungGenerationTargets().
+class V8_EXPORT_PRIVATE YoungGenerationController {
+ public:
+  YoungGenerationController(Heap* heap, double pause_target_ms,
+                            double throughput_target);
+  YoungGenerationController(const YoungGenerationController&) = delete;
+  YoungGenerationController& operator=(const YoungGenerationController&) =
+      delete;
+
+  void SetTargets(double pause_target_ms, double throughput_target);
+
+  double pause_target_ms() const { return pause_target_ms_; }
+  double throughput_target() const { return throughput_target_; }
+
+  // Returns the capacity for new space based on the recorded scavenges, or
+  // the current capacity if nothing has been recorded yet.
+  size_t ComputeCapacity() const;
+
+  // The survival ratio is in [0, 1], speeds are in bytes/ms.
+  static size_t ComputeCapacity(size_t current_capacity, size_t min_capacity,
+                                size_t max_capacity, double survival_ratio,
+                                double scavenge_speed,
+                                double allocation_throughput,
+                                double pause_target_ms,
+                                double throughput_target);
+
+ private:
+  Heap* const heap_;
+  double pause_target_ms_;
+  double throughput_target_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_YOUNG_GENERATION_CONTROLLER_H_
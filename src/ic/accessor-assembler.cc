@@ -2872,7 +2872,8 @@ enum AccessorAssembler::StubCacheTable : int {
   kSecondary = static_cast<int>(StubCache::kSecondary)
 };
 
-TNode<IntPtrT> AccessorAssembler::StubCachePrimaryOffset(TNode<Name> name,
+TNode<IntPtrT> AccessorAssembler::StubCachePrimaryOffset(StubCache* stub_cache,
+                                                         TNode<Name> name,
                                                          TNode<Map> map) {
   // Compute the hash of the name (use entire hash field).
   TNode<Uint32T> raw_hash_field = LoadNameRawHash(name);
@@ -2890,15 +2891,17 @@ TNode<IntPtrT> AccessorAssembler::StubCachePrimaryOffset(TNode<Name> name,
       WordXor(map_word, WordShr(map_word, StubCache::kPrimaryTableBits))));
   // Base the offset on a simple combination of name and map.
   TNode<Word32T> hash = Int32Add(raw_hash_field, map32);
-  uint32_t mask = (StubCache::kPrimaryTableSize - 1)
-                  << StubCache::kCacheIndexShift;
-  TNode<UintPtrT> result =
-      ChangeUint32ToWord(Word32And(hash, Int32Constant(mask)));
+  // The size of the table is only known at runtime.
+  TNode<ExternalReference> mask_address = ExternalConstant(
+      ExternalReference::Create(
+          stub_cache->mask_reference(StubCache::kPrimary)));
+  TNode<Uint32T> mask = Load<Uint32T>(mask_address);
+  TNode<UintPtrT> result = ChangeUint32ToWord(Word32And(hash, mask));
   return Signed(result);
 }
 
-TNode<IntPtrT> AccessorAssembler::StubCacheSecondaryOffset(TNode<Name> name,
-                                                           TNode<Map> map) {
+TNode<IntPtrT> AccessorAssembler::StubCacheSecondaryOffset(
+    StubCache* stub_cache, TNode<Name> name, TNode<Map> map) {
   // See v8::internal::StubCache::SecondaryOffset().
 
   // Use the seed from the primary cache in the secondary cache.
@@ -2908,10 +2911,11 @@ TNode<IntPtrT> AccessorAssembler::StubCacheSecondaryOffset(TNode<Name> name,
   TNode<Word32T> hash_a = Int32Add(map32, name32);
   TNode<Word32T> hash_b = Word32Shr(hash_a, StubCache::kSecondaryTableBits);
   TNode<Word32T> hash = Int32Add(hash_a, hash_b);
-  int32_t mask = (StubCache::kSecondaryTableSize - 1)
-                 << StubCache::kCacheIndexShift;
-  TNode<UintPtrT> result =
-      ChangeUint32ToWord(Word32And(hash, Int32Constant(mask)));
+  TNode<ExternalReference> mask_address = ExternalConstant(
+      ExternalReference::Create(
+          stub_cache->mask_reference(StubCache::kSecondary)));
+  TNode<Uint32T> mask = Load<Uint32T>(mask_address);
+  TNode<UintPtrT> result = ChangeUint32ToWord(Word32And(hash, mask));
   return Signed(result);
 }
 
@@ -2962,18 +2966,37 @@ void AccessorAssembler::TryProbeStubCache(StubCache* stub_cache,
   Counters* counters = isolate()->counters();
   IncrementCounter(counters->megamorphic_stub_cache_probes(), 1);
 
-  // Probe the primary table.
+  // Probe the primary table, one way of the set after the other. The number
+  // of ways is only known at runtime.
   TNode<IntPtrT> primary_offset =
-      StubCachePrimaryOffset(name, lookup_start_object_map);
-  TryProbeStubCacheTable(stub_cache, kPrimary, primary_offset, name,
-                         lookup_start_object_map, if_handler, var_handler,
-                         &try_secondary);
+      StubCachePrimaryOffset(stub_cache, name, lookup_start_object_map);
+  TNode<ExternalReference> ways_address =
+      ExternalConstant(ExternalReference::Create(stub_cache->ways_reference()));
+  TNode<IntPtrT> ways = Signed(ChangeUint32ToWord(Load<Uint32T>(ways_address)));
+  TNode<IntPtrT> primary_set_end =
+      IntPtrAdd(primary_offset,
+                WordShl(ways, IntPtrConstant(StubCache::kCacheIndexShift)));
+  const int kEntryOffsetDelta = 1 << StubCache::kCacheIndexShift;
+  TVARIABLE(IntPtrT, var_way_offset, primary_offset);
+  Label try_way(this, &var_way_offset), try_next_way(this);
+  Goto(&try_way);
+  BIND(&try_way);
+  {
+    TryProbeStubCacheTable(stub_cache, kPrimary, var_way_offset.value(), name,
+                           lookup_start_object_map, if_handler, var_handler,
+                           &try_next_way);
+    BIND(&try_next_way);
+    var_way_offset =
+        IntPtrAdd(var_way_offset.value(), IntPtrConstant(kEntryOffsetDelta));
+    Branch(IntPtrLessThan(var_way_offset.value(), primary_set_end), &try_way,
+           &try_secondary);
+  }
 
   BIND(&try_secondary);
   {
     // Probe the secondary table.
     TNode<IntPtrT> secondary_offset =
-        StubCacheSecondaryOffset(name, lookup_start_object_map);
+        StubCacheSecondaryOffset(stub_cache, name, lookup_start_object_map);
     TryProbeStubCacheTable(stub_cache, kSecondary, secondary_offset, name,
                            lookup_start_object_map, if_handler, var_handler,
                            &miss);
@@ -4,6 +4,8 @@
 
 #include "src/ic/stub-cache.h"
 
+#include <algorithm>
+
 #include "src/ast/ast.h"
 #include "src/base/bits.h"
 #include "src/heap/heap-inl.h"  // For InYoungGeneration().
@@ -14,22 +16,51 @@
 namespace v8 {
 namespace internal {
 
-StubCache::StubCache(Isolate* isolate) : isolate_(isolate) {
+namespace {
+
+int PrimaryTableSize(int requested_size) {
+  if (requested_size <= 0) return StubCache::kDefaultPrimaryTableSize;
+  uint32_t size = base::bits::RoundUpToPowerOfTwo32(
+      static_cast<uint32_t>(std::min(requested_size,
+                                     StubCache::kMaxPrimaryTableSize)));
+  return std::max(static_cast<int>(size), StubCache::kMinPrimaryTableSize);
+}
+
+int PrimaryTableWays(int requested_ways) {
+  if (requested_ways <= 1) return 1;
+  return static_cast<int>(base::bits::RoundUpToPowerOfTwo32(
+      static_cast<uint32_t>(
+          std::min(requested_ways, StubCache::kMaxPrimaryTableWays))));
+}
+
+}  // namespace
+
+StubCache::StubCache(Isolate* isolate, int primary_table_size,
+                     int primary_table_ways)
+    : primary_table_size_(PrimaryTableSize(primary_table_size)),
+      secondary_table_size_(primary_table_size_ / 4),
+      primary_ways_(PrimaryTableWays(primary_table_ways)),
+      primary_mask_((primary_table_size_ - primary_ways_) << kCacheIndexShift),
+      secondary_mask_((secondary_table_size_ - 1) << kCacheIndexShift),
+      primary_(new Entry[primary_table_size_]),
+      secondary_(new Entry[secondary_table_size_]),
+      isolate_(isolate) {
   // Ensure the nullptr (aka Smi::zero()) which StubCache::Get() returns
   // when the entry is not found is not considered as a handler.
   DCHECK(!IC::IsHandler(MaybeObject()));
 }
 
 void StubCache::Initialize() {
-  DCHECK(base::bits::IsPowerOfTwo(kPrimaryTableSize));
-  DCHECK(base::bits::IsPowerOfTwo(kSecondaryTableSize));
+  DCHECK(base::bits::IsPowerOfTwo(primary_table_size_));
+  DCHECK(base::bits::IsPowerOfTwo(secondary_table_size_));
+  DCHECK_EQ(0, primary_table_size_ % primary_table_ways());
   Clear();
 }
 
 // Hash algorithm for the primary table. This algorithm is replicated in
-// the AccessorAssembler.  Returns an index into the table that
-// is scaled by 1 << kCacheIndexShift.
-int StubCache::PrimaryOffset(Tagged<Name> name, Tagged<Map> map) {
+// the AccessorAssembler.  Returns the index of the first entry of the set in
+// the table, scaled by 1 << kCacheIndexShift.
+int StubCache::PrimaryOffset(Tagged<Name> name, Tagged<Map> map) const {
   // Compute the hash of the name (use entire hash field).
   uint32_t field = name->RawHash();
   DCHECK(Name::IsHashFieldComputed(field));
@@ -38,31 +69,42 @@ int StubCache::PrimaryOffset(Tagged<Name> name, Tagged<Map> map) {
   // 4Gb (and not at all if it isn't).
   uint32_t map_low32bits =
       static_cast<uint32_t>(map.ptr() ^ (map.ptr() >> kPrimaryTableBits));
-  // Base the offset on a simple combination of name and map.
+  // Base the offset on a simple combination of name and map. The mask clears
+  // the low bits of the index so that it points to the first way of the set.
   uint32_t key = map_low32bits + field;
-  return key & ((kPrimaryTableSize - 1) << kCacheIndexShift);
+  return key & primary_mask_;
 }
 
 // Hash algorithm for the secondary table.  This algorithm is replicated in
 // assembler. This hash should be sufficiently different from the primary one
 // in order to avoid collisions for minified code with short names.
 // Returns an index into the table that is scaled by 1 << kCacheIndexShift.
-int StubCache::SecondaryOffset(Tagged<Name> name, Tagged<Map> old_map) {
+int StubCache::SecondaryOffset(Tagged<Name> name,
+                               Tagged<Map> old_map) const {
   uint32_t name_low32bits = static_cast<uint32_t>(name.ptr());
   uint32_t map_low32bits = static_cast<uint32_t>(old_map.ptr());
   uint32_t key = (map_low32bits + name_low32bits);
   key = key + (key >> kSecondaryTableBits);
-  return key & ((kSecondaryTableSize - 1) << kCacheIndexShift);
+  return key & secondary_mask_;
 }
 
-int StubCache::PrimaryOffsetForTesting(Tagged<Name> name, Tagged<Map> map) {
+int StubCache::PrimaryOffsetForTesting(Tagged<Name> name,
+                                       Tagged<Map> map) const {
   return PrimaryOffset(name, map);
 }
 
-int StubCache::SecondaryOffsetForTesting(Tagged<Name> name, Tagged<Map> map) {
+int StubCache::SecondaryOffsetForTesting(Tagged<Name> name,
+                                         Tagged<Map> map) const {
   return SecondaryOffset(name, map);
 }
 
+bool StubCache::IsValid(const Entry* entry) const {
+  MaybeObject handler(TaggedValue::ToMaybeObject(isolate_, entry->value));
+  return handler != MaybeObject::FromObject(
+                        isolate_->builtins()->code(Builtin::kIllegal)) &&
+         !entry->map.IsSmi();
+}
+
 #ifdef DEBUG
 namespace {
 
@@ -83,26 +125,40 @@ bool CommonStubCacheChecks(StubCache* stub_cache, Tagged<Name> name,
 void StubCache::Set(Tagged<Name> name, Tagged<Map> map, MaybeObject handler) {
   DCHECK(CommonStubCacheChecks(this, name, map, handler));
 
-  // Compute the primary entry.
+  // Compute the primary set.
   int primary_offset = PrimaryOffset(name, map);
-  Entry* primary = entry(primary_, primary_offset);
-  MaybeObject old_handler(
-      TaggedValue::ToMaybeObject(isolate(), primary->value));
-  // If the primary entry has useful data in it, we retire it to the
-  // secondary cache before overwriting it.
-  if (old_handler != MaybeObject::FromObject(
-                         isolate()->builtins()->code(Builtin::kIllegal)) &&
-      !primary->map.IsSmi()) {
+  Entry* primary = entry(primary_.get(), primary_offset);
+
+  // If the key is already in the set, only the handler is updated.
+  const int ways = primary_table_ways();
+  for (int way = 0; way < ways; way++) {
+    if (primary[way].key == name && primary[way].map == map) {
+      primary[way].value = TaggedValue(handler);
+      isolate()->counters()->megamorphic_stub_cache_updates()->Increment();
+      return;
+    }
+  }
+
+  // If the least recently added entry of the set has useful data in it, we
+  // retire it to the secondary cache before overwriting it.
+  Entry* last = &primary[ways - 1];
+  if (IsValid(last)) {
     Tagged<Map> old_map =
-        Map::cast(StrongTaggedValue::ToObject(isolate(), primary->map));
+        Map::cast(StrongTaggedValue::ToObject(isolate(), last->map));
     Tagged<Name> old_name =
-        Name::cast(StrongTaggedValue::ToObject(isolate(), primary->key));
+        Name::cast(StrongTaggedValue::ToObject(isolate(), last->key));
     int secondary_offset = SecondaryOffset(old_name, old_map);
-    Entry* secondary = entry(secondary_, secondary_offset);
-    *secondary = *primary;
+    Entry* secondary = entry(secondary_.get(), secondary_offset);
+    if (IsValid(secondary)) {
+      isolate()->counters()->megamorphic_stub_cache_evictions()->Increment();
+    }
+    *secondary = *last;
   }
 
-  // Update primary cache.
+  // Update primary cache, keeping the set ordered by age.
+  for (int way = ways - 1; way > 0; way--) {
+    primary[way] = primary[way - 1];
+  }
   primary->key = StrongTaggedValue(name);
   primary->value = TaggedValue(handler);
   primary->map = StrongTaggedValue(map);
@@ -112,12 +168,14 @@ void StubCache::Set(Tagged<Name> name, Tagged<Map> map, MaybeObject handler) {
 MaybeObject StubCache::Get(Tagged<Name> name, Tagged<Map> map) {
   DCHECK(CommonStubCacheChecks(this, name, map, MaybeObject()));
   int primary_offset = PrimaryOffset(name, map);
-  Entry* primary = entry(primary_, primary_offset);
-  if (primary->key == name && primary->map == map) {
-    return TaggedValue::ToMaybeObject(isolate(), primary->value);
+  Entry* primary = entry(primary_.get(), primary_offset);
+  for (int way = 0; way < primary_table_ways(); way++) {
+    if (primary[way].key == name && primary[way].map == map) {
+      return TaggedValue::ToMaybeObject(isolate(), primary[way].value);
+    }
   }
   int secondary_offset = SecondaryOffset(name, map);
-  Entry* secondary = entry(secondary_, secondary_offset);
+  Entry* secondary = entry(secondary_.get(), secondary_offset);
   if (secondary->key == name && secondary->map == map) {
     return TaggedValue::ToMaybeObject(isolate(), secondary->value);
   }
@@ -128,12 +186,12 @@ void StubCache::Clear() {
   MaybeObject empty =
       MaybeObject::FromObject(isolate_->builtins()->code(Builtin::kIllegal));
   Tagged<Name> empty_string = ReadOnlyRoots(isolate()).empty_string();
-  for (int i = 0; i < kPrimaryTableSize; i++) {
+  for (int i = 0; i < primary_table_size_; i++) {
     primary_[i].key = StrongTaggedValue(empty_string);
     primary_[i].map = StrongTaggedValue(Smi::zero());
     primary_[i].value = TaggedValue(empty);
   }
-  for (int j = 0; j < kSecondaryTableSize; j++) {
+  for (int j = 0; j < secondary_table_size_; j++) {
     secondary_[j].key = StrongTaggedValue(empty_string);
     secondary_[j].map = StrongTaggedValue(Smi::zero());
     secondary_[j].value = TaggedValue(empty);
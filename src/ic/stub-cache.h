@@ -5,6 +5,8 @@
 #ifndef V8_IC_STUB_CACHE_H_
 #define V8_IC_STUB_CACHE_H_
 
+#include <memory>
+
 #include "include/v8-callbacks.h"
 #include "src/objects/name.h"
 #include "src/objects/tagged-value.h"
@@ -16,6 +18,11 @@ namespace internal {
 // It maps (map, name, type) to property access handlers. The cache does not
 // need explicit invalidation when a prototype chain is modified, since the
 // handlers verify the chain.
+//
+// The size of the tables and the number of ways of the primary table are
+// chosen per isolate (see ResourceConstraints::set_stub_cache_entries,
+// --stub-cache-entries and --stub-cache-ways), so generated code loads them
+// rather than embedding them.
 
 class SCTableReference {
  public:
@@ -66,12 +73,29 @@ class V8_EXPORT_PRIVATE StubCache {
         reinterpret_cast<Address>(&first_entry(table)->value));
   }
 
+  // The mask that the hash is reduced with to get an offset into the table,
+  // see PrimaryOffset and SecondaryOffset.
+  SCTableReference mask_reference(StubCache::Table table) {
+    switch (table) {
+      case StubCache::kPrimary:
+        return SCTableReference(reinterpret_cast<Address>(&primary_mask_));
+      case StubCache::kSecondary:
+        return SCTableReference(reinterpret_cast<Address>(&secondary_mask_));
+    }
+    UNREACHABLE();
+  }
+
+  // The number of ways of the primary table, see primary_table_ways().
+  SCTableReference ways_reference() {
+    return SCTableReference(reinterpret_cast<Address>(&primary_ways_));
+  }
+
   StubCache::Entry* first_entry(StubCache::Table table) {
     switch (table) {
       case StubCache::kPrimary:
-        return StubCache::primary_;
+        return StubCache::primary_.get();
       case StubCache::kSecondary:
-        return StubCache::secondary_;
+        return StubCache::secondary_.get();
     }
     UNREACHABLE();
   }
@@ -85,16 +109,37 @@ class V8_EXPORT_PRIVATE StubCache {
   // the static_assert below, in {entry(...)}).
   static const int kCacheIndexShift = Name::HashBits::kShift;
 
+  // The table bits of the default table sizes. They are also used to mix the
+  // high bits of the hashes into the low bits, independent of the actual size.
   static const int kPrimaryTableBits = 11;
-  static const int kPrimaryTableSize = (1 << kPrimaryTableBits);
+  static const int kDefaultPrimaryTableSize = (1 << kPrimaryTableBits);
   static const int kSecondaryTableBits = 9;
-  static const int kSecondaryTableSize = (1 << kSecondaryTableBits);
+  static const int kDefaultSecondaryTableSize = (1 << kSecondaryTableBits);
+
+  static const int kMinPrimaryTableSize = 1 << 8;
+  static const int kMaxPrimaryTableSize = 1 << 20;
+
+  static const int kMaxPrimaryTableWays = 4;
 
-  static int PrimaryOffsetForTesting(Tagged<Name> name, Tagged<Map> map);
-  static int SecondaryOffsetForTesting(Tagged<Name> name, Tagged<Map> map);
+  int primary_table_size() const { return primary_table_size_; }
+  int secondary_table_size() const { return secondary_table_size_; }
+  // The primary table is made of sets of this many consecutive entries,
+  // ordered from the most to the least recently added entry. Sets are
+  // replaced in FIFO order: hits do not reorder a set, since generated code
+  // probes the table without writing to it.
+  int primary_table_ways() const { return static_cast<int>(primary_ways_); }
+
+  int PrimaryOffsetForTesting(Tagged<Name> name, Tagged<Map> map) const;
+  int SecondaryOffsetForTesting(Tagged<Name> name, Tagged<Map> map) const;
 
   // The constructor is made public only for the purposes of testing.
-  explicit StubCache(Isolate* isolate);
+  // |primary_table_size| is rounded up to a power of two and clamped to
+  // [kMinPrimaryTableSize, kMaxPrimaryTableSize]. The secondary table gets a
+  // quarter of the entries of the primary table. |primary_table_ways| is
+  // rounded up to a power of two and clamped to [1, kMaxPrimaryTableWays].
+  explicit StubCache(Isolate* isolate,
+                     int primary_table_size = kDefaultPrimaryTableSize,
+                     int primary_table_ways = 1);
   StubCache(const StubCache&) = delete;
   StubCache& operator=(const StubCache&) = delete;
 
@@ -102,19 +147,22 @@ class V8_EXPORT_PRIVATE StubCache {
   // The stub cache has a primary and secondary level.  The two levels have
   // different hashing algorithms in order to avoid simultaneous collisions
   // in both caches.  Unlike a probing strategy (quadratic or otherwise) the
-  // update strategy on updates is fairly clear and simple:  Any existing entry
-  // in the primary cache is moved to the secondary cache, and secondary cache
-  // entries are overwritten.
+  // update strategy on updates is fairly clear and simple:  The least recently
+  // added entry of the primary set is moved to the secondary cache, and
+  // secondary cache entries are overwritten.
 
   // Hash algorithm for the primary table.  This algorithm is replicated in
-  // assembler for every architecture.  Returns an index into the table that
-  // is scaled by 1 << kCacheIndexShift.
-  static int PrimaryOffset(Tagged<Name> name, Tagged<Map> map);
+  // assembler for every architecture.  Returns the index of the first entry
+  // of the set in the table, scaled by 1 << kCacheIndexShift.
+  int PrimaryOffset(Tagged<Name> name, Tagged<Map> map) const;
 
   // Hash algorithm for the secondary table.  This algorithm is replicated in
   // assembler for every architecture.  Returns an index into the table that
   // is scaled by 1 << kCacheIndexShift.
-  static int SecondaryOffset(Tagged<Name> name, Tagged<Map> map);
+  int SecondaryOffset(Tagged<Name> name, Tagged<Map> map) const;
+
+  // Returns whether |entry| holds a handler.
+  bool IsValid(const Entry* entry) const;
 
   // Compute the entry for a given offset in exactly the same way as
   // we do in generated code.  We generate an hash code that already
@@ -131,8 +179,14 @@ class V8_EXPORT_PRIVATE StubCache {
   }
 
  private:
-  Entry primary_[kPrimaryTableSize];
-  Entry secondary_[kSecondaryTableSize];
+  const int primary_table_size_;
+  const int secondary_table_size_;
+  uint32_t primary_ways_;
+  // See PrimaryOffset and SecondaryOffset.
+  uint32_t primary_mask_;
+  uint32_t secondary_mask_;
+  std::unique_ptr<Entry[]> primary_;
+  std::unique_ptr<Entry[]> secondary_;
   Isolate* isolate_;
 
   friend class Isolate;
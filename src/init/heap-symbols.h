@@ -657,6 +657,7 @@
   F(MC_SWEEP_CODE_POINTER_TABLE)              \
   F(MC_COMPLETE_SWEEP_ARRAY_BUFFERS)          \
   F(MC_COMPLETE_SWEEPING)                     \
+  F(MC_COMPLETE_UNMAPPING)                    \
   F(MC_EVACUATE_CANDIDATES)                   \
   F(MC_EVACUATE_CLEAN_UP)                     \
   F(MC_EVACUATE_COPY)                         \
@@ -670,6 +671,7 @@
   F(MC_EVACUATE_UPDATE_POINTERS_SLOTS_MAIN)   \
   F(MC_EVACUATE_UPDATE_POINTERS_TO_NEW_ROOTS) \
   F(MC_EVACUATE_UPDATE_POINTERS_WEAK)         \
+  F(MC_FINISH_SHRINK_LARGE_PAGES)             \
   F(MC_FINISH_SWEEP_ARRAY_BUFFERS)            \
   F(MC_MARK_CLIENT_HEAPS)                     \
   F(MC_MARK_EMBEDDER_PROLOGUE)                \
@@ -5,6 +5,7 @@
 #include "src/init/isolate-allocator.h"
 
 #include "src/base/bounded-page-allocator.h"
+#include "src/base/platform/huge-pages.h"
 #include "src/common/ptr-compr-inl.h"
 #include "src/execution/isolate.h"
 #include "src/heap/code-range.h"
@@ -42,6 +43,16 @@ struct PtrComprCageReservationParams
 #endif
   }
 };
+
+namespace {
+// With --huge-pages, lets the heap pages allocated in the cage be backed by
+// transparent huge pages. The cage base is 4GB aligned, so huge pages line up
+// with the reservation.
+void MaybeEnableHugePages(const VirtualMemoryCage* cage) {
+  if (!v8_flags.huge_pages) return;
+  base::HugePages::Enable(reinterpret_cast<void*>(cage->base()), cage->size());
+}
+}  // namespace
 #endif  // V8_COMPRESS_POINTERS
 
 #ifdef V8_COMPRESS_POINTERS_IN_SHARED_CAGE
@@ -81,6 +92,7 @@ void IsolateAllocator::InitializeOncePerProcess() {
         "Failed to reserve virtual memory for process-wide V8 "
         "pointer compression cage");
   }
+  MaybeEnableHugePages(GetProcessWidePtrComprCage());
   V8HeapCompressionScheme::InitBase(GetProcessWidePtrComprCage()->base());
 #ifdef V8_EXTERNAL_CODE_SPACE
   // Speculatively set the code cage base to the same value in case jitless
@@ -99,6 +111,7 @@ IsolateAllocator::IsolateAllocator() {
         nullptr,
         "Failed to reserve memory for Isolate V8 pointer compression cage");
   }
+  MaybeEnableHugePages(&isolate_ptr_compr_cage_);
   page_allocator_ = isolate_ptr_compr_cage_.page_allocator();
 #elif defined(V8_COMPRESS_POINTERS_IN_SHARED_CAGE)
   CHECK(GetProcessWidePtrComprCage()->IsReserved());
@@ -4,13 +4,17 @@
 
 #include "src/json/json-parser.h"
 
+#include "src/base/bits.h"
+#include "src/base/functional.h"
 #include "src/base/strings.h"
+#include "src/codegen/cpu-features.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
 #include "src/common/message-template.h"
 #include "src/debug/debug.h"
 #include "src/execution/frames-inl.h"
 #include "src/heap/factory.h"
+#include "src/logging/counters.h"
 #include "src/numbers/conversions.h"
 #include "src/numbers/hash-seed-inl.h"
 #include "src/objects/field-type.h"
@@ -20,7 +24,13 @@
 #include "src/objects/property-descriptor.h"
 #include "src/roots/roots.h"
 #include "src/strings/char-predicates-inl.h"
-#include "src/strings/string-hasher.h"
+#include "src/strings/string-hasher-inl.h"
+
+#if defined(V8_HOST_ARCH_X64)
+#include <immintrin.h>
+#elif defined(V8_HOST_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
 
 namespace v8 {
 namespace internal {
@@ -122,6 +132,251 @@ static const constexpr uint8_t character_json_scan_flags[256] = {
 #undef CALL_GET_SCAN_FLAGS
 };
 
+// Vectorized helpers for the hot character loops of the parser. Each helper
+// advances over whole blocks of characters that are uninteresting to the
+// caller and returns a pointer to the first block that may contain an
+// interesting character (or to the exact character, when it is cheap to
+// compute). The caller finishes the scan one character at a time, so the
+// helpers never need to handle the tail of the input.
+//
+// x64 always has SSE2. Since we don't compile with -mavx2 (or /arch:AVX2 on
+// MSVC), the AVX2 kernels are compiled with a target attribute and selected at
+// runtime. Clang on Windows can't generate AVX2 code without /arch:AVX2, so it
+// only gets the SSE2 kernels. Arm64 is guaranteed to have Neon.
+#if defined(V8_HOST_ARCH_X64)
+#define V8_JSON_SCAN_SSE2 1
+#if defined(V8_TARGET_ARCH_X64) && !(defined(_MSC_VER) && defined(__clang__))
+#define V8_JSON_SCAN_AVX2 1
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+#elif defined(V8_HOST_ARCH_ARM64)
+#define V8_JSON_SCAN_NEON 1
+#endif
+
+#ifdef V8_JSON_SCAN_SSE2
+// Or-reduces the eight 16-bit lanes of |v|.
+V8_INLINE base::uc32 HorizontalOrUint16(__m128i v) {
+  v = _mm_or_si128(v, _mm_srli_si128(v, 8));
+  v = _mm_or_si128(v, _mm_srli_si128(v, 4));
+  v = _mm_or_si128(v, _mm_srli_si128(v, 2));
+  return static_cast<base::uc32>(_mm_extract_epi16(v, 0));
+}
+
+// A lane is a string terminator if it is '"', '\\' or less than 0x20. The
+// latter is checked with an unsigned saturating subtraction, since SSE2 has no
+// unsigned comparisons.
+template <typename Char>
+const Char* SkipJsonStringCharactersSSE2(const Char* cursor, const Char* end,
+                                         base::uc32* bits) {
+  constexpr int kBlockSize = sizeof(__m128i) / sizeof(Char);
+  const __m128i zero = _mm_setzero_si128();
+  if constexpr (sizeof(Char) == 1) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i max_control = _mm_set1_epi8(0x1F);
+    for (; end - cursor >= kBlockSize; cursor += kBlockSize) {
+      __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+      __m128i terminators = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(chars, quote),
+                       _mm_cmpeq_epi8(chars, backslash)),
+          _mm_cmpeq_epi8(_mm_subs_epu8(chars, max_control), zero));
+      int mask = _mm_movemask_epi8(terminators);
+      if (mask != 0) return cursor + base::bits::CountTrailingZeros32(mask);
+    }
+  } else {
+    const __m128i quote = _mm_set1_epi16('"');
+    const __m128i backslash = _mm_set1_epi16('\\');
+    const __m128i max_control = _mm_set1_epi16(0x1F);
+    __m128i seen = zero;
+    for (; end - cursor >= kBlockSize; cursor += kBlockSize) {
+      __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+      __m128i terminators = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi16(chars, quote),
+                       _mm_cmpeq_epi16(chars, backslash)),
+          _mm_cmpeq_epi16(_mm_subs_epu16(chars, max_control), zero));
+      if (_mm_movemask_epi8(terminators) != 0) break;
+      seen = _mm_or_si128(seen, chars);
+    }
+    *bits |= HorizontalOrUint16(seen);
+  }
+  return cursor;
+}
+
+template <typename Char>
+const Char* SkipJsonWhitespaceSSE2(const Char* cursor, const Char* end) {
+  constexpr int kBlockSize = sizeof(__m128i) / sizeof(Char);
+  for (; end - cursor >= kBlockSize; cursor += kBlockSize) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+    __m128i whitespace;
+    if constexpr (sizeof(Char) == 1) {
+      whitespace = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')),
+                       _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n'))),
+          _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')),
+                       _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t'))));
+    } else {
+      whitespace = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi16(chars, _mm_set1_epi16(' ')),
+                       _mm_cmpeq_epi16(chars, _mm_set1_epi16('\n'))),
+          _mm_or_si128(_mm_cmpeq_epi16(chars, _mm_set1_epi16('\r')),
+                       _mm_cmpeq_epi16(chars, _mm_set1_epi16('\t'))));
+    }
+    int mask = ~_mm_movemask_epi8(whitespace) & 0xFFFF;
+    if (mask != 0) {
+      return cursor + base::bits::CountTrailingZeros32(mask) / sizeof(Char);
+    }
+  }
+  return cursor;
+}
+#endif  // V8_JSON_SCAN_SSE2
+
+#ifdef V8_JSON_SCAN_AVX2
+template <typename Char>
+TARGET_AVX2 const Char* SkipJsonStringCharactersAVX2(const Char* cursor,
+                                                     const Char* end,
+                                                     base::uc32* bits) {
+  constexpr int kBlockSize = sizeof(__m256i) / sizeof(Char);
+  const __m256i zero = _mm256_setzero_si256();
+  if constexpr (sizeof(Char) == 1) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i max_control = _mm256_set1_epi8(0x1F);
+    for (; end - cursor >= kBlockSize; cursor += kBlockSize) {
+      __m256i chars =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cursor));
+      __m256i terminators = _mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi8(chars, quote),
+                          _mm256_cmpeq_epi8(chars, backslash)),
+          _mm256_cmpeq_epi8(_mm256_subs_epu8(chars, max_control), zero));
+      uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(terminators));
+      if (mask != 0) return cursor + base::bits::CountTrailingZeros32(mask);
+    }
+  } else {
+    const __m256i quote = _mm256_set1_epi16('"');
+    const __m256i backslash = _mm256_set1_epi16('\\');
+    const __m256i max_control = _mm256_set1_epi16(0x1F);
+    __m256i seen = zero;
+    for (; end - cursor >= kBlockSize; cursor += kBlockSize) {
+      __m256i chars =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cursor));
+      __m256i terminators = _mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi16(chars, quote),
+                          _mm256_cmpeq_epi16(chars, backslash)),
+          _mm256_cmpeq_epi16(_mm256_subs_epu16(chars, max_control), zero));
+      if (_mm256_movemask_epi8(terminators) != 0) break;
+      seen = _mm256_or_si256(seen, chars);
+    }
+    *bits |= HorizontalOrUint16(_mm_or_si128(
+        _mm256_castsi256_si128(seen), _mm256_extracti128_si256(seen, 1)));
+  }
+  return cursor;
+}
+#undef TARGET_AVX2
+#endif  // V8_JSON_SCAN_AVX2
+
+#ifdef V8_JSON_SCAN_NEON
+template <typename Char>
+const Char* SkipJsonStringCharactersNeon(const Char* cursor, const Char* end,
+                                         base::uc32* bits) {
+  if constexpr (sizeof(Char) == 1) {
+    constexpr int kBlockSize = sizeof(uint8x16_t);
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t space = vdupq_n_u8(0x20);
+    for (; end - cursor >= kBlockSize; cursor += kBlockSize) {
+      uint8x16_t chars = vld1q_u8(cursor);
+      uint8x16_t terminators =
+          vorrq_u8(vorrq_u8(vceqq_u8(chars, quote), vceqq_u8(chars, backslash)),
+                   vcltq_u8(chars, space));
+      if (vmaxvq_u8(terminators) != 0) break;
+    }
+  } else {
+    constexpr int kBlockSize = sizeof(uint16x8_t) / sizeof(uint16_t);
+    const uint16x8_t quote = vdupq_n_u16('"');
+    const uint16x8_t backslash = vdupq_n_u16('\\');
+    const uint16x8_t space = vdupq_n_u16(0x20);
+    uint16x8_t seen = vdupq_n_u16(0);
+    for (; end - cursor >= kBlockSize; cursor += kBlockSize) {
+      uint16x8_t chars = vld1q_u16(cursor);
+      uint16x8_t terminators = vorrq_u16(
+          vorrq_u16(vceqq_u16(chars, quote), vceqq_u16(chars, backslash)),
+          vcltq_u16(chars, space));
+      if (vmaxvq_u16(terminators) != 0) break;
+      seen = vorrq_u16(seen, chars);
+    }
+    // The caller only cares whether any character is outside of Latin1, for
+    // which the maximum of the or-ed lanes is as good as their or.
+    *bits |= vmaxvq_u16(seen);
+  }
+  return cursor;
+}
+
+template <typename Char>
+const Char* SkipJsonWhitespaceNeon(const Char* cursor, const Char* end) {
+  if constexpr (sizeof(Char) == 1) {
+    constexpr int kBlockSize = sizeof(uint8x16_t);
+    for (; end - cursor >= kBlockSize; cursor += kBlockSize) {
+      uint8x16_t chars = vld1q_u8(cursor);
+      uint8x16_t whitespace =
+          vorrq_u8(vorrq_u8(vceqq_u8(chars, vdupq_n_u8(' ')),
+                            vceqq_u8(chars, vdupq_n_u8('\n'))),
+                   vorrq_u8(vceqq_u8(chars, vdupq_n_u8('\r')),
+                            vceqq_u8(chars, vdupq_n_u8('\t'))));
+      if (vminvq_u8(whitespace) == 0) break;
+    }
+  } else {
+    constexpr int kBlockSize = sizeof(uint16x8_t) / sizeof(uint16_t);
+    for (; end - cursor >= kBlockSize; cursor += kBlockSize) {
+      uint16x8_t chars = vld1q_u16(cursor);
+      uint16x8_t whitespace =
+          vorrq_u16(vorrq_u16(vceqq_u16(chars, vdupq_n_u16(' ')),
+                              vceqq_u16(chars, vdupq_n_u16('\n'))),
+                    vorrq_u16(vceqq_u16(chars, vdupq_n_u16('\r')),
+                              vceqq_u16(chars, vdupq_n_u16('\t'))));
+      if (vminvq_u16(whitespace) == 0) break;
+    }
+  }
+  return cursor;
+}
+#endif  // V8_JSON_SCAN_NEON
+
+// Skips characters that can't terminate a JSON string, i.e. anything but '"',
+// '\\' and control characters. For two-byte strings the skipped characters are
+// or-ed into |bits|, like ScanJsonString does one character at a time.
+template <typename Char>
+V8_INLINE const Char* SkipJsonStringCharacters(const Char* cursor,
+                                               const Char* end,
+                                               base::uc32* bits) {
+#ifdef V8_JSON_SCAN_AVX2
+  if (CpuFeatures::IsSupported(AVX2)) {
+    return SkipJsonStringCharactersAVX2(cursor, end, bits);
+  }
+#endif
+#if defined(V8_JSON_SCAN_SSE2)
+  return SkipJsonStringCharactersSSE2(cursor, end, bits);
+#elif defined(V8_JSON_SCAN_NEON)
+  return SkipJsonStringCharactersNeon(cursor, end, bits);
+#else
+  return cursor;
+#endif
+}
+
+// Skips JSON whitespace (' ', '\t', '\r' and '\n').
+template <typename Char>
+V8_INLINE const Char* SkipJsonWhitespace(const Char* cursor, const Char* end) {
+#if defined(V8_JSON_SCAN_SSE2)
+  return SkipJsonWhitespaceSSE2(cursor, end);
+#elif defined(V8_JSON_SCAN_NEON)
+  return SkipJsonWhitespaceNeon(cursor, end);
+#else
+  return cursor;
+#endif
+}
+
 }  // namespace
 
 MaybeHandle<Object> JsonParseInternalizer::Internalize(
@@ -312,7 +567,9 @@ JsonParser<Char>::JsonParser(Isolate* isolate, Handle<String> source)
     : isolate_(isolate),
       hash_seed_(HashSeed(isolate)),
       object_constructor_(isolate_->object_function()),
-      original_source_(source) {
+      original_source_(source),
+      property_key_cache_maps_(
+          handle(ReadOnlyRoots(isolate).empty_fixed_array(), isolate)) {
   size_t start = 0;
   size_t length = source->length();
   PtrComprCageBase cage_base(isolate);
@@ -576,6 +833,14 @@ template <typename Char>
 void JsonParser<Char>::SkipWhitespace() {
   JsonToken local_next = JsonToken::EOS;
 
+  // Most tokens aren't preceded by whitespace, and single spaces are common in
+  // between tokens, so only vectorize runs such as indentation.
+  if (cursor_ + 1 < end_ &&
+      GetTokenForCharacter(cursor_[0]) == JsonToken::WHITESPACE &&
+      GetTokenForCharacter(cursor_[1]) == JsonToken::WHITESPACE) {
+    cursor_ = SkipJsonWhitespace(cursor_ + 2, end_);
+  }
+
   cursor_ = std::find_if(cursor_, end_, [&](Char c) {
     JsonToken current = GetTokenForCharacter(c);
     bool result = current != JsonToken::WHITESPACE;
@@ -708,6 +973,21 @@ Handle<Object> JsonParser<Char>::BuildJsonObject(
     elements = factory()->empty_fixed_array();
   }
 
+  // Objects that aren't siblings in an array may still share their keys, and
+  // thus their map, with an object that was built before.
+  const bool use_property_key_cache =
+      feedback.is_null() && cont.elements == 0 && named_length > 0 &&
+      named_length <= kMaxPropertyKeyCacheProperties;
+  size_t property_keys_hash = 0;
+  bool keys_match_feedback = false;
+  if (use_property_key_cache) {
+    property_keys_hash = HashPropertyKeys(property_stack, start, length);
+    keys_match_feedback =
+        LookupPropertyKeyCache(property_stack, start, length,
+                               property_keys_hash)
+            .ToHandle(&feedback);
+  }
+
   int feedback_descriptors = 0;
   if (!feedback.is_null()) {
     DisallowGarbageCollection no_gc;
@@ -745,7 +1025,10 @@ Handle<Object> JsonParser<Char>::BuildJsonObject(
       }
     }
 
-    Handle<String> key = MakeString(property.string, expected);
+    Handle<String> key =
+        keys_match_feedback && descriptor < feedback_descriptors
+            ? expected
+            : MakeString(property.string, expected);
     if (key.is_identical_to(expected)) {
       if (descriptor < feedback_descriptors) target = feedback;
     } else {
@@ -805,6 +1088,11 @@ Handle<Object> JsonParser<Char>::BuildJsonObject(
     map = ParentOfDescriptorOwner(isolate_, map, map, descriptor);
   }
 
+  if (use_property_key_cache && i == length && !map.is_identical_to(feedback)) {
+    UpdatePropertyKeyCache(property_stack, start, length, property_keys_hash,
+                           map);
+  }
+
   // Preallocate all mutable heap numbers so we don't need to allocate while
   // setting up the object. Otherwise verification of that object may fail.
   Handle<ByteArray> mutable_double_buffer;
@@ -917,6 +1205,83 @@ Handle<Object> JsonParser<Char>::BuildJsonObject(
   return object;
 }
 
+template <typename Char>
+size_t JsonParser<Char>::HashPropertyKeys(
+    const SmallVector<JsonProperty>& property_stack, size_t start,
+    int length) {
+  DisallowGarbageCollection no_gc;
+  size_t hash = length;
+  for (int i = 0; i < length; i++) {
+    const JsonString& key = property_stack[start + i].string;
+    DCHECK(!key.is_index());
+    hash = base::hash_combine(
+        hash, StringHasher::HashSequentialString(chars_ + key.start(),
+                                                 key.length(), hash_seed_));
+  }
+  return hash;
+}
+
+template <typename Char>
+MaybeHandle<Map> JsonParser<Char>::LookupPropertyKeyCache(
+    const SmallVector<JsonProperty>& property_stack, size_t start, int length,
+    size_t hash) {
+  bool hit = false;
+  MaybeHandle<Map> result;
+  if (property_key_cache_) {
+    DisallowGarbageCollection no_gc;
+    size_t index = hash % kPropertyKeyCacheSize;
+    const PropertyKeyCacheEntry& entry = property_key_cache_[index];
+    hit = entry.hash == hash &&
+          entry.keys.size() == 2 * static_cast<size_t>(length);
+    for (int i = 0; hit && i < length; i++) {
+      const JsonString& key = property_stack[start + i].string;
+      hit = key.length() == entry.keys[2 * i + 1] &&
+            CompareCharsEqual(chars_ + key.start(), chars_ + entry.keys[2 * i],
+                              key.length());
+    }
+    if (hit) {
+      Tagged<Map> map =
+          Map::cast(property_key_cache_maps_->get(static_cast<int>(index)));
+      // The map might have been replaced in the transition tree since.
+      hit = !map->is_deprecated() && !map->IsDetached(isolate_);
+      if (hit) result = handle(map, isolate_);
+    }
+  }
+#ifdef V8_RUNTIME_CALL_STATS
+  if (V8_UNLIKELY(TracingFlags::is_runtime_stats_enabled())) {
+    isolate_->counters()
+        ->runtime_call_stats()
+        ->GetCounter(hit ? RuntimeCallCounterId::kJsonParsePropertyKeyCacheHit
+                         : RuntimeCallCounterId::kJsonParsePropertyKeyCacheMiss)
+        ->Increment();
+  }
+#endif  // V8_RUNTIME_CALL_STATS
+  return result;
+}
+
+template <typename Char>
+void JsonParser<Char>::UpdatePropertyKeyCache(
+    const SmallVector<JsonProperty>& property_stack, size_t start, int length,
+    size_t hash, Handle<Map> map) {
+  DCHECK_EQ(length, map->NumberOfOwnDescriptors());
+  if (!property_key_cache_) {
+    property_key_cache_maps_.PatchValue(
+        *factory()->NewFixedArray(kPropertyKeyCacheSize));
+    property_key_cache_ =
+        std::make_unique<PropertyKeyCacheEntry[]>(kPropertyKeyCacheSize);
+  }
+  size_t index = hash % kPropertyKeyCacheSize;
+  PropertyKeyCacheEntry& entry = property_key_cache_[index];
+  entry.hash = hash;
+  entry.keys.clear();
+  for (int i = 0; i < length; i++) {
+    const JsonString& key = property_stack[start + i].string;
+    entry.keys.push_back(key.start());
+    entry.keys.push_back(key.length());
+  }
+  property_key_cache_maps_->set(static_cast<int>(index), *map);
+}
+
 template <typename Char>
 Handle<Object> JsonParser<Char>::BuildJsonArray(
     const JsonContinuation& cont,
@@ -1576,6 +1941,7 @@ JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
   base::uc32 bits = 0;
 
   while (true) {
+    cursor_ = SkipJsonStringCharacters(cursor_, end_, &bits);
     cursor_ = std::find_if(cursor_, end_, [&bits](Char c) {
       if (sizeof(Char) == 2 && V8_UNLIKELY(c > unibrow::Latin1::kMaxChar)) {
         bits |= c;
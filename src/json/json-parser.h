@@ -5,6 +5,9 @@
 #ifndef V8_JSON_JSON_PARSER_H_
 #define V8_JSON_JSON_PARSER_H_
 
+#include <memory>
+#include <vector>
+
 #include "include/v8-callbacks.h"
 #include "src/base/small-vector.h"
 #include "src/base/strings.h"
@@ -327,6 +330,29 @@ class JsonParser final {
   Handle<Object> BuildJsonObject(
       const JsonContinuation& cont,
       const SmallVector<JsonProperty>& property_stack, Handle<Map> feedback);
+
+  // A cache of the maps of recently built objects, keyed on the source
+  // characters of their property keys. An object whose keys are spelled
+  // exactly like those of a cached object starts out with that object's map
+  // and takes its keys from the map's descriptors, without internalizing them
+  // or searching the transition tree. It is used for objects that don't get
+  // feedback from a preceding sibling in an array.
+  struct PropertyKeyCacheEntry {
+    size_t hash = 0;
+    // Start and length of each key in the source.
+    std::vector<int> keys;
+  };
+  static constexpr size_t kPropertyKeyCacheSize = 64;
+  static constexpr int kMaxPropertyKeyCacheProperties = 32;
+
+  size_t HashPropertyKeys(const SmallVector<JsonProperty>& property_stack,
+                          size_t start, int length);
+  MaybeHandle<Map> LookupPropertyKeyCache(
+      const SmallVector<JsonProperty>& property_stack, size_t start,
+      int length, size_t hash);
+  void UpdatePropertyKeyCache(const SmallVector<JsonProperty>& property_stack,
+                              size_t start, int length, size_t hash,
+                              Handle<Map> map);
   Handle<Object> BuildJsonArray(
       const JsonContinuation& cont,
       const SmallVector<Handle<Object>>& element_stack);
@@ -396,6 +422,11 @@ class JsonParser final {
   // The parsed value's source to be passed to the reviver, if the reviver is
   // callable.
   MaybeHandle<Object> parsed_val_node_;
+  // Maps of the property key cache. This is a handle to the empty fixed array
+  // until the cache is first used, at which point the handle is patched to
+  // point to the cache's own array.
+  Handle<FixedArray> property_key_cache_maps_;
+  std::unique_ptr<PropertyKeyCacheEntry[]> property_key_cache_;
 
   // Cached pointer to the raw chars in source. In case source is on-heap, we
   // register an UpdatePointers callback. For this reason, chars_, cursor_ and
@@ -0,0 +1,270 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/json/json-streaming-parser.h"
+
+#include <algorithm>
+
+#include "src/execution/isolate.h"
+#include "src/handles/global-handles.h"
+#include "src/heap/factory.h"
+#include "src/json/json-parser.h"
+#include "src/objects/js-array-inl.h"
+#include "src/objects/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr bool IsJsonWhitespace(uint8_t c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool IsBlank(base::Vector<const uint8_t> text) {
+  return std::all_of(text.begin(), text.end(), IsJsonWhitespace);
+}
+
+}  // namespace
+
+JsonStreamingParser::JsonStreamingParser(Isolate* isolate, Encoding encoding)
+    : isolate_(isolate), encoding_(encoding) {}
+
+JsonStreamingParser::~JsonStreamingParser() {
+  if (result_location_ != nullptr) GlobalHandles::Destroy(result_location_);
+}
+
+Handle<JSObject> JsonStreamingParser::result() const {
+  DCHECK_NOT_NULL(result_location_);
+  return Handle<JSObject>::cast(Handle<Object>(result_location_));
+}
+
+bool JsonStreamingParser::Feed(base::Vector<const uint8_t> chunk) {
+  DCHECK(!failed_);
+  Factory* factory = isolate_->factory();
+  for (uint8_t c : chunk) {
+    switch (container_) {
+      case Container::kUnknown:
+        if (IsJsonWhitespace(c)) break;
+        if (c == '[') {
+          container_ = Container::kArray;
+          result_location_ =
+              isolate_->global_handles()
+                  ->Create(*factory->NewJSArray(0, PACKED_SMI_ELEMENTS))
+                  .location();
+          break;
+        }
+        if (c == '{') {
+          container_ = Container::kObject;
+          result_location_ =
+              isolate_->global_handles()
+                  ->Create(*factory->NewJSObject(isolate_->object_function()))
+                  .location();
+          break;
+        }
+        container_ = Container::kNone;
+        buffer_.push_back(c);
+        break;
+
+      case Container::kNone:
+        buffer_.push_back(c);
+        break;
+
+      case Container::kArray:
+      case Container::kObject:
+        if (!ScanContainerCharacter(c)) return false;
+        break;
+    }
+    if (c == '\n') {
+      line_++;
+      line_start_ = position_ + 1;
+    }
+    position_++;
+  }
+  return true;
+}
+
+bool JsonStreamingParser::ScanContainerCharacter(uint8_t c) {
+  if (closed_) {
+    if (IsJsonWhitespace(c)) return true;
+    return ReportError(
+        MessageTemplate::kJsonParseUnexpectedNonWhiteSpaceCharacter);
+  }
+  if (in_string_) {
+    if (escaped_) {
+      escaped_ = false;
+    } else if (c == '\\') {
+      escaped_ = true;
+    } else if (c == '"') {
+      in_string_ = false;
+    }
+    buffer_.push_back(c);
+    return true;
+  }
+  switch (c) {
+    case '"':
+      in_string_ = true;
+      break;
+    case '[':
+    case '{':
+      depth_++;
+      break;
+    case ']':
+    case '}':
+      if (depth_ > 0) {
+        depth_--;
+        break;
+      }
+      if ((c == ']') != (container_ == Container::kArray)) {
+        return ReportError(
+            container_ == Container::kArray
+                ? MessageTemplate::kJsonParseExpectedCommaOrRBrack
+                : MessageTemplate::kJsonParseExpectedCommaOrRBrace);
+      }
+      closed_ = true;
+      return ConsumeBufferedItem(true);
+    case ',':
+      if (depth_ > 0) break;
+      return ConsumeBufferedItem(false);
+    case ':':
+      if (depth_ == 0 && colon_position_ == kNoColon) {
+        colon_position_ = buffer_.size();
+      }
+      break;
+  }
+  buffer_.push_back(c);
+  return true;
+}
+
+MaybeHandle<Object> JsonStreamingParser::Finish() {
+  DCHECK(!failed_);
+  switch (container_) {
+    case Container::kUnknown:
+      ReportError(MessageTemplate::kJsonParseUnexpectedEOS);
+      return MaybeHandle<Object>();
+    case Container::kNone:
+      return ParseText(base::VectorOf(buffer_));
+    case Container::kArray:
+    case Container::kObject:
+      if (!closed_) {
+        ReportError(MessageTemplate::kJsonParseUnexpectedEOS);
+        return MaybeHandle<Object>();
+      }
+      return handle(*result(), isolate_);
+  }
+  UNREACHABLE();
+}
+
+bool JsonStreamingParser::ConsumeBufferedItem(bool is_last) {
+  HandleScope scope(isolate_);
+  base::Vector<const uint8_t> text = base::VectorOf(buffer_);
+  bool success = container_ == Container::kArray
+                     ? ConsumeArrayElement(text, is_last)
+                     : ConsumeObjectMember(text, is_last);
+  buffer_.clear();
+  colon_position_ = kNoColon;
+  return success;
+}
+
+bool JsonStreamingParser::ConsumeArrayElement(base::Vector<const uint8_t> text,
+                                              bool is_last) {
+  if (IsBlank(text)) {
+    // Only an empty array may have an empty element.
+    if (is_last && length_ == 0) return true;
+    return ReportUnexpectedCharacter(is_last ? ']' : ',');
+  }
+  Handle<Object> value;
+  if (!ParseText(text).ToHandle(&value)) return false;
+  if (JSObject::AddDataElement(result(), length_, value, NONE).IsNothing()) {
+    failed_ = true;
+    return false;
+  }
+  length_++;
+  return true;
+}
+
+bool JsonStreamingParser::ConsumeObjectMember(base::Vector<const uint8_t> text,
+                                              bool is_last) {
+  if (IsBlank(text)) {
+    // Only an empty object may have an empty member.
+    if (is_last && length_ == 0) return true;
+    return ReportUnexpectedCharacter(is_last ? '}' : ',');
+  }
+  if (colon_position_ == kNoColon) {
+    return ReportError(
+        MessageTemplate::kJsonParseExpectedColonAfterPropertyName);
+  }
+  // The JsonParser would accept any value as the key, so make sure that it is
+  // a string literal first.
+  base::Vector<const uint8_t> key_text = text.SubVector(0, colon_position_);
+  auto key_start =
+      std::find_if_not(key_text.begin(), key_text.end(), IsJsonWhitespace);
+  if (key_start == key_text.end() || *key_start != '"') {
+    return ReportError(
+        MessageTemplate::kJsonParseExpectedDoubleQuotedPropertyName);
+  }
+  Handle<Object> key;
+  if (!ParseText(key_text).ToHandle(&key)) return false;
+  Handle<Object> value;
+  if (!ParseText(text.SubVector(colon_position_ + 1, text.size()))
+           .ToHandle(&value)) {
+    return false;
+  }
+  Handle<String> name =
+      isolate_->factory()->InternalizeString(Handle<String>::cast(key));
+  if (JSReceiver::CreateDataProperty(isolate_, result(), name, value,
+                                     Just(kThrowOnError))
+          .IsNothing()) {
+    failed_ = true;
+    return false;
+  }
+  length_++;
+  return true;
+}
+
+MaybeHandle<Object> JsonStreamingParser::ParseText(
+    base::Vector<const uint8_t> text) {
+  Factory* factory = isolate_->factory();
+  Handle<String> source;
+  MaybeHandle<String> maybe_source =
+      encoding_ == Encoding::kOneByte
+          ? factory->NewStringFromOneByte(text)
+          : factory->NewStringFromUtf8(base::Vector<const char>::cast(text));
+  if (!maybe_source.ToHandle(&source)) {
+    failed_ = true;
+    return MaybeHandle<Object>();
+  }
+  Handle<Object> undefined = factory->undefined_value();
+  MaybeHandle<Object> value =
+      source->IsOneByteRepresentation()
+          ? JsonParser<uint8_t>::Parse(isolate_, source, undefined)
+          : JsonParser<uint16_t>::Parse(isolate_, source, undefined);
+  if (value.is_null()) failed_ = true;
+  return value;
+}
+
+bool JsonStreamingParser::ReportError(MessageTemplate message) {
+  Factory* factory = isolate_->factory();
+  Handle<Object> position = factory->NewNumberFromSize(position_);
+  Handle<Object> line(Smi::FromInt(line_), isolate_);
+  Handle<Object> column =
+      factory->NewNumberFromSize(position_ - line_start_ + 1);
+  isolate_->Throw(*factory->NewSyntaxError(message, position, line, column));
+  failed_ = true;
+  return false;
+}
+
+bool JsonStreamingParser::ReportUnexpectedCharacter(uint8_t c) {
+  Factory* factory = isolate_->factory();
+  Handle<Object> character = factory->LookupSingleCharacterStringFromCode(c);
+  Handle<Object> position = factory->NewNumberFromSize(position_);
+  isolate_->Throw(*factory->NewSyntaxError(
+      MessageTemplate::kJsonParseUnexpectedTokenAtPosition, character,
+      position));
+  failed_ = true;
+  return false;
+}
+
+}  // namespace internal
+}  // namespace v8
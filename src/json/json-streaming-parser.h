@@ -0,0 +1,100 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_JSON_JSON_STREAMING_PARSER_H_
+#define V8_JSON_JSON_STREAMING_PARSER_H_
+
+#include <vector>
+
+#include "include/v8-json.h"
+#include "src/base/vector.h"
+#include "src/common/message-template.h"
+#include "src/handles/handles.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class JSObject;
+class Object;
+
+// Parses a JSON text that is handed over in chunks. The text is only ever
+// buffered up to the end of the current top-level array element or object
+// member: complete elements and members are parsed with the regular
+// JsonParser and added to the result right away, and their source bytes are
+// dropped. Top-level scalars are buffered completely.
+//
+// Syntax errors inside of an element or member are reported by the JsonParser,
+// with positions relative to the start of that element or member. Errors in
+// the structure of the top-level container are reported with positions
+// relative to the start of the text.
+class JsonStreamingParser final {
+ public:
+  using Encoding = v8::JSON::StreamingParser::Encoding;
+
+  JsonStreamingParser(Isolate* isolate, Encoding encoding);
+  ~JsonStreamingParser();
+  JsonStreamingParser(const JsonStreamingParser&) = delete;
+  JsonStreamingParser& operator=(const JsonStreamingParser&) = delete;
+
+  // Consumes the next chunk of the text. Returns false and leaves an exception
+  // pending on syntax errors, after which the parser can't be used anymore.
+  V8_WARN_UNUSED_RESULT bool Feed(base::Vector<const uint8_t> chunk);
+
+  // Signals the end of the text and returns the parsed value.
+  V8_WARN_UNUSED_RESULT MaybeHandle<Object> Finish();
+
+  bool failed() const { return failed_; }
+
+ private:
+  enum class Container : uint8_t { kUnknown, kArray, kObject, kNone };
+
+  static constexpr size_t kNoColon = static_cast<size_t>(-1);
+
+  // Scans a character of the top-level array or object.
+  bool ScanContainerCharacter(uint8_t c);
+
+  // Adds the buffered array element or object member to the result.
+  // |is_last| is true if the element or member is followed by the closing
+  // bracket or brace rather than by a comma.
+  bool ConsumeBufferedItem(bool is_last);
+  bool ConsumeArrayElement(base::Vector<const uint8_t> text, bool is_last);
+  bool ConsumeObjectMember(base::Vector<const uint8_t> text, bool is_last);
+
+  // Parses |text| as a complete JSON text.
+  MaybeHandle<Object> ParseText(base::Vector<const uint8_t> text);
+
+  // Throws a SyntaxError at the current position and return false.
+  bool ReportError(MessageTemplate message);
+  bool ReportUnexpectedCharacter(uint8_t c);
+
+  Handle<JSObject> result() const;
+
+  Isolate* const isolate_;
+  const Encoding encoding_;
+  Container container_ = Container::kUnknown;
+  // Global handle to the top-level array or object.
+  Address* result_location_ = nullptr;
+  // Source of the top-level element or member that is currently being
+  // scanned, or of the whole text for top-level scalars.
+  std::vector<uint8_t> buffer_;
+  // Offset of the first top-level ':' of the current object member in
+  // buffer_.
+  size_t colon_position_ = kNoColon;
+  uint32_t length_ = 0;
+  uint32_t depth_ = 0;
+  bool in_string_ = false;
+  bool escaped_ = false;
+  bool closed_ = false;
+  bool failed_ = false;
+  // Location of the current character in the whole text, for error messages.
+  size_t position_ = 0;
+  int line_ = 1;
+  size_t line_start_ = 0;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_JSON_JSON_STREAMING_PARSER_H_
@@ -4,9 +4,14 @@
 
 #include "src/json/json-stringifier.h"
 
+#include <atomic>
+#include <string>
+
+#include "include/v8-platform.h"
 #include "src/base/strings.h"
 #include "src/common/assert-scope.h"
 #include "src/common/message-template.h"
+#include "src/init/v8.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/heap-number-inl.h"
 #include "src/objects/js-array-inl.h"
@@ -168,6 +173,26 @@ class JsonStringifier {
     if (current_index_ == part_length_) Extend();
   }
 
+  void AppendOneByteChars(base::Vector<const char> chars) {
+    if (chars.size() >= static_cast<size_t>(String::kMaxLength)) {
+      overflowed_ = true;
+      return;
+    }
+    const int length = static_cast<int>(chars.size());
+    while (!CurrentPartCanFit(length)) {
+      Extend();
+      if (overflowed_) return;
+    }
+    if (encoding_ == String::ONE_BYTE_ENCODING) {
+      CopyChars(one_byte_ptr_ + current_index_,
+                reinterpret_cast<const uint8_t*>(chars.begin()), length);
+    } else {
+      CopyChars(two_byte_ptr_ + current_index_,
+                reinterpret_cast<const uint8_t*>(chars.begin()), length);
+    }
+    current_index_ += length;
+  }
+
   V8_NOINLINE void AppendString(Handle<String> string_handle) {
     {
       DisallowGarbageCollection no_gc;
@@ -212,6 +237,14 @@ class JsonStringifier {
   Result SerializeArrayLikeSlow(Handle<JSReceiver> object, uint32_t start,
                                 uint32_t length);
 
+  // Serializes a prefix of the elements of a PACKED_ELEMENTS array on
+  // background threads, and returns the length of that prefix. The caller
+  // serializes the remaining elements, starting with the first one that could
+  // not be serialized without side effects.
+  bool CanSerializeElementsInParallel(uint32_t length);
+  uint32_t SerializeElementsInParallel(Handle<JSArray> object,
+                                       uint32_t length);
+
   // Returns whether any escape sequences were used.
   template <bool raw_json>
   bool SerializeString(Handle<String> object);
@@ -363,6 +396,9 @@ class JsonStringifier {
   static const int kJsonEscapeTableEntrySize = 8;
   static const char* const JsonEscapeTable;
   static const bool JsonDoNotEscapeFlagTable[];
+
+  class SideEffectFreeSerializer;
+  class SerializeElementsJob;
 };
 
 MaybeHandle<Object> JsonStringify(Isolate* isolate, Handle<Object> object,
@@ -1023,7 +1059,10 @@ JsonStringifier::Result JsonStringifier::SerializeJSArray(
       case PACKED_ELEMENTS: {
         HandleScope handle_scope(isolate_);
         Handle<Object> old_length(object->length(), isolate_);
-        for (i = 0; i < length; i++) {
+        if (CanSerializeElementsInParallel(length)) {
+          i = SerializeElementsInParallel(object, length);
+        }
+        for (; i < length; i++) {
           if (object->length() != *old_length ||
               object->GetElementsKind(cage_base) != PACKED_ELEMENTS) {
             // Fall back to slow path.
@@ -1107,6 +1146,302 @@ V8_INLINE bool CanFastSerializeJSObject(PtrComprCageBase cage_base,
 }
 }  // namespace
 
+// Serializes plain data to a std::string, without side effects and without
+// allocating on the V8 heap, so that it can run on a background thread while
+// the main thread is blocked. Everything that needs the general serializer
+// (toJSON methods, proxies, wrappers, dictionary-mode objects, holey arrays,
+// two-byte strings, and deep or cyclic structures) is reported as a bailout.
+class JsonStringifier::SideEffectFreeSerializer {
+ public:
+  enum class Result { kSuccess, kUnchanged, kBailout };
+
+  SideEffectFreeSerializer(Isolate* isolate, std::string* out)
+      : isolate_(isolate), cage_base_(isolate), out_(out) {}
+
+  Result Serialize(Tagged<Object> object, int depth) {
+    if (IsSmi(object)) {
+      SerializeSmi(Smi::cast(object));
+      return Result::kSuccess;
+    }
+    InstanceType instance_type =
+        HeapObject::cast(object)->map(cage_base_)->instance_type();
+    switch (instance_type) {
+      case HEAP_NUMBER_TYPE:
+        SerializeDouble(HeapNumber::cast(object)->value());
+        return Result::kSuccess;
+      case ODDBALL_TYPE:
+        switch (Oddball::cast(object)->kind()) {
+          case Oddball::kFalse:
+            out_->append("false");
+            return Result::kSuccess;
+          case Oddball::kTrue:
+            out_->append("true");
+            return Result::kSuccess;
+          case Oddball::kNull:
+            out_->append("null");
+            return Result::kSuccess;
+          default:
+            return Result::kUnchanged;
+        }
+      case SYMBOL_TYPE:
+        return Result::kUnchanged;
+      case JS_ARRAY_TYPE:
+        return SerializeJSArray(JSArray::cast(object), depth);
+      case JS_OBJECT_TYPE:
+        return SerializeJSObject(JSObject::cast(object), depth);
+      default:
+        if (InstanceTypeChecker::IsString(instance_type) &&
+            SerializeString(String::cast(object))) {
+          return Result::kSuccess;
+        }
+        return Result::kBailout;
+    }
+  }
+
+ private:
+  // Nesting depth up to which objects and arrays are serialized. This also
+  // bounds the work done on cyclic structures, which are left to the main
+  // thread to report.
+  static constexpr int kMaxDepth = 16;
+
+  void SerializeSmi(Tagged<Smi> object) {
+    char chars[100];
+    base::Vector<char> buffer(chars, arraysize(chars));
+    out_->append(IntToCString(object.value(), buffer));
+  }
+
+  void SerializeDouble(double number) {
+    if (std::isinf(number) || std::isnan(number)) {
+      out_->append("null");
+      return;
+    }
+    char chars[100];
+    base::Vector<char> buffer(chars, arraysize(chars));
+    out_->append(DoubleToCString(number, buffer));
+  }
+
+  bool SerializeString(Tagged<String> string) {
+    if (IsThinString(string, cage_base_)) {
+      string = ThinString::cast(string)->actual(cage_base_);
+    }
+    if (!IsSeqOneByteString(string, cage_base_)) return false;
+    DisallowGarbageCollection no_gc;
+    const uint8_t* chars = SeqOneByteString::cast(string)->GetChars(no_gc);
+    const int length = string->length();
+    out_->push_back('"');
+    for (int i = 0; i < length; i++) {
+      uint8_t c = chars[i];
+      if (JsonDoNotEscapeFlagTable[c]) {
+        out_->push_back(c);
+      } else {
+        out_->append(&JsonEscapeTable[c * kJsonEscapeTableEntrySize]);
+      }
+    }
+    out_->push_back('"');
+    return true;
+  }
+
+  Result SerializeJSArray(Tagged<JSArray> object, int depth) {
+    if (depth >= kMaxDepth) return Result::kBailout;
+    if (MayHaveInterestingProperties(isolate_, object)) {
+      return Result::kBailout;
+    }
+    uint32_t length = 0;
+    CHECK(Object::ToArrayLength(object->length(), &length));
+    out_->push_back('[');
+    switch (object->GetElementsKind(cage_base_)) {
+      case PACKED_SMI_ELEMENTS: {
+        Tagged<FixedArray> elements =
+            FixedArray::cast(object->elements(cage_base_));
+        for (uint32_t i = 0; i < length; i++) {
+          if (i > 0) out_->push_back(',');
+          SerializeSmi(Smi::cast(elements->get(i)));
+        }
+        break;
+      }
+      case PACKED_DOUBLE_ELEMENTS: {
+        if (length == 0) break;
+        Tagged<FixedDoubleArray> elements =
+            FixedDoubleArray::cast(object->elements(cage_base_));
+        for (uint32_t i = 0; i < length; i++) {
+          if (i > 0) out_->push_back(',');
+          SerializeDouble(elements->get_scalar(i));
+        }
+        break;
+      }
+      case PACKED_ELEMENTS: {
+        Tagged<FixedArray> elements =
+            FixedArray::cast(object->elements(cage_base_));
+        for (uint32_t i = 0; i < length; i++) {
+          if (i > 0) out_->push_back(',');
+          Result result = Serialize(elements->get(i), depth + 1);
+          if (result == Result::kBailout) return result;
+          if (result == Result::kUnchanged) out_->append("null");
+        }
+        break;
+      }
+      default:
+        return Result::kBailout;
+    }
+    out_->push_back(']');
+    return Result::kSuccess;
+  }
+
+  Result SerializeJSObject(Tagged<JSObject> object, int depth) {
+    if (depth >= kMaxDepth) return Result::kBailout;
+    if (MayHaveInterestingProperties(isolate_, object) ||
+        !CanFastSerializeJSObject(cage_base_, object, isolate_)) {
+      return Result::kBailout;
+    }
+    Tagged<Map> map = object->map(cage_base_);
+    Tagged<DescriptorArray> descriptors = map->instance_descriptors(cage_base_);
+    out_->push_back('{');
+    bool comma = false;
+    for (InternalIndex i : map->IterateOwnDescriptors()) {
+      Tagged<Name> name = descriptors->GetKey(i);
+      if (!IsString(name, cage_base_)) continue;
+      PropertyDetails details = descriptors->GetDetails(i);
+      if (details.IsDontEnum()) continue;
+      if (details.location() != PropertyLocation::kField) {
+        return Result::kBailout;
+      }
+      DCHECK_EQ(PropertyKind::kData, details.kind());
+      // Properties whose value is skipped don't write their key either.
+      const size_t property_start = out_->size();
+      if (comma) out_->push_back(',');
+      if (!SerializeString(String::cast(name))) return Result::kBailout;
+      out_->push_back(':');
+      FieldIndex field_index = FieldIndex::ForDetails(map, details);
+      Result result =
+          Serialize(object->RawFastPropertyAt(cage_base_, field_index),
+                    depth + 1);
+      if (result == Result::kBailout) return result;
+      if (result == Result::kUnchanged) {
+        out_->resize(property_start);
+      } else {
+        comma = true;
+      }
+    }
+    out_->push_back('}');
+    return Result::kSuccess;
+  }
+
+  Isolate* const isolate_;
+  const PtrComprCageBase cage_base_;
+  std::string* const out_;
+};
+
+// Serializes the elements of a PACKED_ELEMENTS array in chunks, each of which
+// is written to its own buffer. A chunk ends early at the first element that
+// can't be serialized without side effects; chunks after that element are
+// not needed anymore and are skipped.
+class JsonStringifier::SerializeElementsJob final : public JobTask {
+ public:
+  struct Chunk {
+    std::string output;
+    // End of the elements that were serialized to {output}.
+    uint32_t end = 0;
+  };
+
+  static constexpr uint32_t kChunkLength = 512;
+
+  SerializeElementsJob(Isolate* isolate, Tagged<FixedArray> elements,
+                       uint32_t length, std::vector<Chunk>* chunks)
+      : isolate_(isolate),
+        elements_(elements),
+        length_(length),
+        chunks_(chunks),
+        first_bailout_(length) {
+    DCHECK_EQ(chunks->size(), (length + kChunkLength - 1) / kChunkLength);
+  }
+
+  void Run(JobDelegate* delegate) override {
+    DisallowGarbageCollection no_gc;
+    do {
+      size_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= chunks_->size()) return;
+      SerializeChunk(chunk);
+    } while (!delegate->ShouldYield());
+  }
+
+  size_t GetMaxConcurrency(size_t /* worker_count */) const override {
+    size_t next_chunk = next_chunk_.load(std::memory_order_relaxed);
+    return chunks_->size() - std::min(next_chunk, chunks_->size());
+  }
+
+ private:
+  void SerializeChunk(size_t index) {
+    uint32_t start = static_cast<uint32_t>(index) * kChunkLength;
+    uint32_t end = std::min(length_, start + kChunkLength);
+    Chunk& chunk = (*chunks_)[index];
+    chunk.end = start;
+    SideEffectFreeSerializer serializer(isolate_, &chunk.output);
+    for (uint32_t i = start; i < end; i++) {
+      if (i >= first_bailout_.load(std::memory_order_relaxed)) return;
+      const size_t element_start = chunk.output.size();
+      if (i > 0) chunk.output.push_back(',');
+      SideEffectFreeSerializer::Result result =
+          serializer.Serialize(elements_->get(i), 0);
+      if (result == SideEffectFreeSerializer::Result::kBailout) {
+        chunk.output.resize(element_start);
+        uint32_t first_bailout = first_bailout_.load(std::memory_order_relaxed);
+        while (i < first_bailout &&
+               !first_bailout_.compare_exchange_weak(
+                   first_bailout, i, std::memory_order_relaxed)) {
+        }
+        return;
+      }
+      if (result == SideEffectFreeSerializer::Result::kUnchanged) {
+        chunk.output.append("null");
+      }
+      chunk.end = i + 1;
+    }
+  }
+
+  Isolate* const isolate_;
+  const Tagged<FixedArray> elements_;
+  const uint32_t length_;
+  std::vector<Chunk>* const chunks_;
+  std::atomic<size_t> next_chunk_{0};
+  std::atomic<uint32_t> first_bailout_;
+};
+
+bool JsonStringifier::CanSerializeElementsInParallel(uint32_t length) {
+  // The background threads only produce one-byte output without indentation,
+  // and can't read strings that other isolates might change concurrently.
+  return v8_flags.parallel_json_stringify &&
+         length >= v8_flags.parallel_json_stringify_min_length &&
+         gap_ == nullptr && property_list_.is_null() &&
+         replacer_function_.is_null() && !isolate_->has_shared_space();
+}
+
+uint32_t JsonStringifier::SerializeElementsInParallel(Handle<JSArray> object,
+                                                      uint32_t length) {
+  DCHECK_EQ(PACKED_ELEMENTS, object->GetElementsKind());
+  std::vector<SerializeElementsJob::Chunk> chunks(
+      (length + SerializeElementsJob::kChunkLength - 1) /
+      SerializeElementsJob::kChunkLength);
+  {
+    // The background threads read the elements without handles, so nothing
+    // may move or change until they are done.
+    DisallowGarbageCollection no_gc;
+    auto job = std::make_unique<SerializeElementsJob>(
+        isolate_, FixedArray::cast(object->elements()), length, &chunks);
+    V8::GetCurrentPlatform()
+        ->CreateJob(TaskPriority::kUserBlocking, std::move(job))
+        ->Join();
+  }
+  uint32_t end = 0;
+  for (const SerializeElementsJob::Chunk& chunk : chunks) {
+    AppendOneByteChars(base::VectorOf(chunk.output));
+    uint32_t chunk_end =
+        std::min(length, end + SerializeElementsJob::kChunkLength);
+    end = chunk.end;
+    if (end < chunk_end) break;
+  }
+  return end;
+}
+
 JsonStringifier::Result JsonStringifier::SerializeJSObject(
     Handle<JSObject> object, Handle<Object> key) {
   PtrComprCageBase cage_base(isolate_);
@@ -6,6 +6,7 @@
 
 #include "src/base/bits.h"
 #include "src/base/macros.h"
+#include "src/base/platform/numa.h"
 
 namespace v8 {
 namespace platform {
@@ -28,6 +29,10 @@ uint8_t DefaultJobState::JobDelegate::GetTaskId() {
   return task_id_;
 }
 
+int DefaultJobState::JobDelegate::GetNumaNode() const {
+  return base::Numa::GetCurrentNode();
+}
+
 DefaultJobState::DefaultJobState(Platform* platform,
                                  std::unique_ptr<JobTask> job_task,
                                  TaskPriority priority,
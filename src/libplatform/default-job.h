@@ -40,6 +40,7 @@ class V8_PLATFORM_EXPORT DefaultJobState
     }
     uint8_t GetTaskId() override;
     bool IsJoiningThread() const override { return is_joining_thread_; }
+    int GetNumaNode() const override;
 
    private:
     static constexpr uint8_t kInvalidTaskId =
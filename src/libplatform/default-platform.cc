@@ -17,6 +17,7 @@
 #include "src/libplatform/default-foreground-task-runner.h"
 #include "src/libplatform/default-job.h"
 #include "src/libplatform/default-worker-threads-task-runner.h"
+#include "src/libplatform/work-stealing-task-runner.h"
 
 namespace v8 {
 namespace platform {
@@ -46,14 +47,15 @@ std::unique_ptr<v8::Platform> NewDefaultPlatform(
     int thread_pool_size, IdleTaskSupport idle_task_support,
     InProcessStackDumping in_process_stack_dumping,
     std::unique_ptr<v8::TracingController> tracing_controller,
-    PriorityMode priority_mode) {
+    PriorityMode priority_mode,
+    WorkerThreadScheduling worker_thread_scheduling, NumaMode numa_mode) {
   if (in_process_stack_dumping == InProcessStackDumping::kEnabled) {
     v8::base::debug::EnableInProcessStackDumping();
   }
   thread_pool_size = GetActualThreadPoolSize(thread_pool_size);
   auto platform = std::make_unique<DefaultPlatform>(
       thread_pool_size, idle_task_support, std::move(tracing_controller),
-      priority_mode);
+      priority_mode, worker_thread_scheduling, numa_mode);
   return platform;
 }
 
@@ -95,12 +97,15 @@ void NotifyIsolateShutdown(v8::Platform* platform, Isolate* isolate) {
 DefaultPlatform::DefaultPlatform(
     int thread_pool_size, IdleTaskSupport idle_task_support,
     std::unique_ptr<v8::TracingController> tracing_controller,
-    PriorityMode priority_mode)
+    PriorityMode priority_mode,
+    WorkerThreadScheduling worker_thread_scheduling, NumaMode numa_mode)
     : thread_pool_size_(thread_pool_size),
       idle_task_support_(idle_task_support),
       tracing_controller_(std::move(tracing_controller)),
       page_allocator_(std::make_unique<v8::base::PageAllocator>()),
-      priority_mode_(priority_mode) {
+      priority_mode_(priority_mode),
+      worker_thread_scheduling_(worker_thread_scheduling),
+      numa_mode_(numa_mode) {
   if (!tracing_controller_) {
     tracing::TracingController* controller = new tracing::TracingController();
 #if !defined(V8_USE_PERFETTO)
@@ -120,6 +125,7 @@ DefaultPlatform::~DefaultPlatform() {
       worker_threads_task_runners_[i]->Terminate();
     }
   }
+  if (work_stealing_task_runner_) work_stealing_task_runner_->Terminate();
   for (const auto& it : foreground_task_runner_map_) {
     it.second->Terminate();
   }
@@ -136,13 +142,22 @@ double DefaultTimeFunction() {
 
 void DefaultPlatform::EnsureBackgroundTaskRunnerInitialized() {
   DCHECK_NULL(worker_threads_task_runners_[0]);
+  DCHECK_NULL(work_stealing_task_runner_);
+  if (worker_thread_scheduling_ == WorkerThreadScheduling::kWorkStealing) {
+    work_stealing_task_runner_ = std::make_shared<WorkStealingTaskRunner>(
+        thread_pool_size_,
+        time_function_for_testing_ ? time_function_for_testing_
+                                   : DefaultTimeFunction,
+        base::Thread::Priority::kDefault, numa_mode_);
+    return;
+  }
   for (int i = 0; i < num_worker_runners(); i++) {
     worker_threads_task_runners_[i] =
         std::make_shared<DefaultWorkerThreadsTaskRunner>(
             thread_pool_size_,
             time_function_for_testing_ ? time_function_for_testing_
                                        : DefaultTimeFunction,
-            priority_from_index(i));
+            priority_from_index(i), numa_mode_);
   }
   DCHECK_NOT_NULL(worker_threads_task_runners_[0]);
 }
@@ -219,6 +234,10 @@ void DefaultPlatform::PostTaskOnWorkerThreadImpl(
   //   but the platform was created as a single-threaded platform.
   // - or some component in V8 is ignoring --single-threaded
   //   and posting a background task.
+  if (work_stealing_task_runner_) {
+    work_stealing_task_runner_->PostTask(priority, std::move(task));
+    return;
+  }
   int index = priority_to_index(priority);
   DCHECK_NOT_NULL(worker_threads_task_runners_[index]);
   worker_threads_task_runners_[index]->PostTask(std::move(task));
@@ -232,6 +251,11 @@ void DefaultPlatform::PostDelayedTaskOnWorkerThreadImpl(
   //   but the platform was created as a single-threaded platform.
   // - or some component in V8 is ignoring --single-threaded
   //   and posting a background task.
+  if (work_stealing_task_runner_) {
+    work_stealing_task_runner_->PostDelayedTask(priority, std::move(task),
+                                                delay_in_seconds);
+    return;
+  }
   int index = priority_to_index(priority);
   DCHECK_NOT_NULL(worker_threads_task_runners_[index]);
   worker_threads_task_runners_[index]->PostDelayedTask(std::move(task),
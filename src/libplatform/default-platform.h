@@ -24,6 +24,7 @@ class WorkerThread;
 class DefaultForegroundTaskRunner;
 class DefaultWorkerThreadsTaskRunner;
 class DefaultPageAllocator;
+class WorkStealingTaskRunner;
 
 class V8_PLATFORM_EXPORT DefaultPlatform : public NON_EXPORTED_BASE(Platform) {
  public:
@@ -31,7 +32,10 @@ class V8_PLATFORM_EXPORT DefaultPlatform : public NON_EXPORTED_BASE(Platform) {
       int thread_pool_size = 0,
       IdleTaskSupport idle_task_support = IdleTaskSupport::kDisabled,
       std::unique_ptr<v8::TracingController> tracing_controller = {},
-      PriorityMode priority_mode = PriorityMode::kDontApply);
+      PriorityMode priority_mode = PriorityMode::kDontApply,
+      WorkerThreadScheduling worker_thread_scheduling =
+          WorkerThreadScheduling::kSharedQueue,
+      NumaMode numa_mode = NumaMode::kDisabled);
 
   ~DefaultPlatform() override;
 
@@ -106,6 +110,9 @@ class V8_PLATFORM_EXPORT DefaultPlatform : public NON_EXPORTED_BASE(Platform) {
   IdleTaskSupport idle_task_support_;
   std::shared_ptr<DefaultWorkerThreadsTaskRunner> worker_threads_task_runners_
       [static_cast<int>(TaskPriority::kMaxPriority) + 1] = {0};
+  // Used instead of |worker_threads_task_runners_| for
+  // WorkerThreadScheduling::kWorkStealing.
+  std::shared_ptr<WorkStealingTaskRunner> work_stealing_task_runner_;
   std::map<v8::Isolate*, std::shared_ptr<DefaultForegroundTaskRunner>>
       foreground_task_runner_map_;
 
@@ -114,6 +121,8 @@ class V8_PLATFORM_EXPORT DefaultPlatform : public NON_EXPORTED_BASE(Platform) {
   DefaultThreadIsolatedAllocator thread_isolated_allocator_;
 
   const PriorityMode priority_mode_;
+  const WorkerThreadScheduling worker_thread_scheduling_;
+  const NumaMode numa_mode_;
   TimeFunction time_function_for_testing_ = nullptr;
 };
 
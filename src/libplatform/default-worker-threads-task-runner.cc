@@ -4,6 +4,7 @@
 
 #include "src/libplatform/default-worker-threads-task-runner.h"
 
+#include "src/base/platform/numa.h"
 #include "src/base/platform/time.h"
 #include "src/libplatform/delayed-task-queue.h"
 
@@ -12,10 +13,15 @@ namespace platform {
 
 DefaultWorkerThreadsTaskRunner::DefaultWorkerThreadsTaskRunner(
     uint32_t thread_pool_size, TimeFunction time_function,
-    base::Thread::Priority priority)
+    base::Thread::Priority priority, NumaMode numa_mode)
     : queue_(time_function), time_function_(time_function) {
+  const int numa_nodes = base::Numa::NumberOfNodes();
   for (uint32_t i = 0; i < thread_pool_size; ++i) {
-    thread_pool_.push_back(std::make_unique<WorkerThread>(this, priority));
+    int numa_node = numa_mode == NumaMode::kEnabled && numa_nodes > 1
+                        ? static_cast<int>(i % numa_nodes)
+                        : base::Numa::kNoNode;
+    thread_pool_.push_back(
+        std::make_unique<WorkerThread>(this, priority, numa_node));
   }
 }
 
@@ -71,10 +77,12 @@ bool DefaultWorkerThreadsTaskRunner::IdleTasksEnabled() {
 }
 
 DefaultWorkerThreadsTaskRunner::WorkerThread::WorkerThread(
-    DefaultWorkerThreadsTaskRunner* runner, base::Thread::Priority priority)
+    DefaultWorkerThreadsTaskRunner* runner, base::Thread::Priority priority,
+    int numa_node)
     : Thread(
           Options("V8 DefaultWorkerThreadsTaskRunner WorkerThread", priority)),
-      runner_(runner) {
+      runner_(runner),
+      numa_node_(numa_node) {
   CHECK(Start());
 }
 
@@ -84,6 +92,9 @@ DefaultWorkerThreadsTaskRunner::WorkerThread::~WorkerThread() {
 }
 
 void DefaultWorkerThreadsTaskRunner::WorkerThread::Run() {
+  if (numa_node_ != base::Numa::kNoNode) {
+    base::Numa::BindCurrentThreadToNode(numa_node_);
+  }
   base::MutexGuard guard(&runner_->lock_);
   while (true) {
     DelayedTaskQueue::MaybeNextTask next_task = runner_->queue_.TryGetNext();
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "include/libplatform/libplatform-export.h"
+#include "include/libplatform/libplatform.h"
 #include "include/v8-platform.h"
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
@@ -25,7 +26,8 @@ class V8_PLATFORM_EXPORT DefaultWorkerThreadsTaskRunner
 
   DefaultWorkerThreadsTaskRunner(
       uint32_t thread_pool_size, TimeFunction time_function,
-      base::Thread::Priority priority = base::Thread::Priority::kDefault);
+      base::Thread::Priority priority = base::Thread::Priority::kDefault,
+      NumaMode numa_mode = NumaMode::kDisabled);
 
   ~DefaultWorkerThreadsTaskRunner() override;
 
@@ -46,8 +48,8 @@ class V8_PLATFORM_EXPORT DefaultWorkerThreadsTaskRunner
  private:
   class WorkerThread : public base::Thread {
    public:
-    explicit WorkerThread(DefaultWorkerThreadsTaskRunner* runner,
-                          base::Thread::Priority priority);
+    WorkerThread(DefaultWorkerThreadsTaskRunner* runner,
+                 base::Thread::Priority priority, int numa_node);
     ~WorkerThread() override;
 
     WorkerThread(const WorkerThread&) = delete;
@@ -61,6 +63,8 @@ class V8_PLATFORM_EXPORT DefaultWorkerThreadsTaskRunner
    private:
     DefaultWorkerThreadsTaskRunner* runner_;
     base::ConditionVariable condition_var_;
+    // The NUMA node this thread binds itself to, or base::Numa::kNoNode.
+    const int numa_node_;
   };
 
   // Called by the WorkerThread. Gets the next take (delayed or immediate) to be
@@ -0,0 +1,142 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LIBPLATFORM_WORK_STEALING_DEQUE_H_
+#define V8_LIBPLATFORM_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "src/base/bits.h"
+#include "src/base/logging.h"
+
+namespace v8 {
+namespace platform {
+
+// A Chase-Lev work-stealing deque, following "Correct and Efficient
+// Work-Stealing for Weak Memory Models" (Lê et al., PPoPP 2013).
+//
+// The owning thread pushes and pops items at the bottom, in LIFO order. Any
+// other thread may steal items from the top, in FIFO order. The buffer grows
+// as needed; buffers that are replaced are kept alive until the deque is
+// destroyed, since thieves may still be reading from them.
+template <typename T>
+class WorkStealingDeque final {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Items are copied without synchronization.");
+
+ public:
+  explicit WorkStealingDeque(size_t initial_capacity = 64) {
+    DCHECK(base::bits::IsPowerOfTwo(initial_capacity));
+    retired_buffers_.push_back(std::make_unique<Buffer>(initial_capacity));
+    buffer_.store(retired_buffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // Must only be called by the owning thread.
+  void Push(T item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(buffer->capacity()) - 1) {
+      buffer = Grow(buffer, top, bottom);
+    }
+    buffer->Put(bottom, item);
+    // Publishes the item to thieves.
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Must only be called by the owning thread. Returns false if the deque is
+  // empty.
+  bool Pop(T* item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    *item = buffer->Get(bottom);
+    if (top < bottom) return true;
+    // This is the last item, so race against thieves for it.
+    bool won = top_.compare_exchange_strong(
+        top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  // May be called by any thread. Returns false if the deque is empty or if
+  // another thread took the top item first.
+  bool Steal(T* item) {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return false;
+    Buffer* buffer = buffer_.load(std::memory_order_acquire);
+    T result = buffer->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    *item = result;
+    return true;
+  }
+
+  // Thread-safe, but the result may be outdated by the time it is used.
+  bool IsEmpty() const {
+    int64_t top = top_.load(std::memory_order_relaxed);
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    return top >= bottom;
+  }
+
+ private:
+  class Buffer final {
+   public:
+    explicit Buffer(size_t capacity)
+        : mask_(capacity - 1),
+          slots_(std::make_unique<std::atomic<T>[]>(capacity)) {}
+
+    size_t capacity() const { return mask_ + 1; }
+
+    T Get(int64_t index) const {
+      return slots_[index & mask_].load(std::memory_order_relaxed);
+    }
+    void Put(int64_t index, T item) {
+      slots_[index & mask_].store(item, std::memory_order_relaxed);
+    }
+
+   private:
+    const size_t mask_;
+    std::unique_ptr<std::atomic<T>[]> slots_;
+  };
+
+  Buffer* Grow(Buffer* buffer, int64_t top, int64_t bottom) {
+    auto new_buffer = std::make_unique<Buffer>(buffer->capacity() * 2);
+    for (int64_t i = top; i < bottom; i++) new_buffer->Put(i, buffer->Get(i));
+    Buffer* result = new_buffer.get();
+    retired_buffers_.push_back(std::move(new_buffer));
+    buffer_.store(result, std::memory_order_release);
+    return result;
+  }
+
+  std::atomic<int64_t> top_{0};
+  std::atomic<int64_t> bottom_{0};
+  std::atomic<Buffer*> buffer_{nullptr};
+  // All buffers that were ever used, including the current one. Only accessed
+  // by the owning thread.
+  std::vector<std::unique_ptr<Buffer>> retired_buffers_;
+};
+
+}  // namespace platform
+}  // namespace v8
+
+#endif  // V8_LIBPLATFORM_WORK_STEALING_DEQUE_H_
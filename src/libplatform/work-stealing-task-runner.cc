@@ -0,0 +1,246 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/libplatform/work-stealing-task-runner.h"
+
+#include "src/base/platform/numa.h"
+#include "src/base/platform/time.h"
+
+namespace v8 {
+namespace platform {
+
+namespace {
+
+// The runner and the index of the worker thread that is running on the
+// current thread, if any.
+thread_local WorkStealingTaskRunner* current_runner = nullptr;
+thread_local size_t current_worker_index = 0;
+
+}  // namespace
+
+class WorkStealingTaskRunner::WorkerThread final : public base::Thread {
+ public:
+  WorkerThread(WorkStealingTaskRunner* runner, size_t index,
+               base::Thread::Priority priority, int numa_node)
+      : Thread(Options("V8 WorkStealingTaskRunner WorkerThread", priority)),
+        runner_(runner),
+        index_(index),
+        numa_node_(numa_node),
+        random_state_(static_cast<uint32_t>(index) * 0x9E3779B9u + 1) {}
+
+  WorkerThread(const WorkerThread&) = delete;
+  WorkerThread& operator=(const WorkerThread&) = delete;
+
+  // This thread attempts to get tasks in a loop from |runner_| and run them.
+  void Run() override {
+    if (numa_node_ != base::Numa::kNoNode) {
+      base::Numa::BindCurrentThreadToNode(numa_node_);
+    }
+    current_runner = runner_;
+    current_worker_index = index_;
+    while (std::unique_ptr<Task> task = runner_->GetNext(this)) task->Run();
+    current_runner = nullptr;
+  }
+
+  WorkStealingDeque<Task*>& deque() { return deque_; }
+
+  // Returns a pseudo-random number for picking the first steal victim.
+  uint32_t NextRandom() {
+    // xorshift32.
+    random_state_ ^= random_state_ << 13;
+    random_state_ ^= random_state_ >> 17;
+    random_state_ ^= random_state_ << 5;
+    return random_state_;
+  }
+
+ private:
+  WorkStealingTaskRunner* const runner_;
+  const size_t index_;
+  // The NUMA node this thread binds itself to, or base::Numa::kNoNode.
+  const int numa_node_;
+  WorkStealingDeque<Task*> deque_;
+  uint32_t random_state_;
+};
+
+WorkStealingTaskRunner::WorkStealingTaskRunner(uint32_t thread_pool_size,
+                                               TimeFunction time_function,
+                                               base::Thread::Priority priority,
+                                               NumaMode numa_mode)
+    : time_function_(time_function) {
+  const int numa_nodes = base::Numa::NumberOfNodes();
+  for (uint32_t i = 0; i < thread_pool_size; ++i) {
+    int numa_node = numa_mode == NumaMode::kEnabled && numa_nodes > 1
+                        ? static_cast<int>(i % numa_nodes)
+                        : base::Numa::kNoNode;
+    thread_pool_.push_back(
+        std::make_unique<WorkerThread>(this, i, priority, numa_node));
+  }
+  // Only start the threads once |thread_pool_| is complete, since workers
+  // iterate over it to steal tasks.
+  for (auto& thread : thread_pool_) CHECK(thread->Start());
+}
+
+WorkStealingTaskRunner::~WorkStealingTaskRunner() { Terminate(); }
+
+double WorkStealingTaskRunner::MonotonicallyIncreasingTime() {
+  return time_function_();
+}
+
+void WorkStealingTaskRunner::Terminate() {
+  {
+    base::MutexGuard guard(&idle_lock_);
+    if (terminated_.load(std::memory_order_relaxed)) return;
+    terminated_.store(true, std::memory_order_relaxed);
+    idle_condition_.NotifyAll();
+  }
+  for (auto& thread : thread_pool_) thread->Join();
+  // Delete the tasks that never ran. The deques can be accessed from this
+  // thread now that their owners have been joined.
+  for (auto& thread : thread_pool_) {
+    Task* task;
+    while (thread->deque().Pop(&task)) delete task;
+  }
+  thread_pool_.clear();
+}
+
+void WorkStealingTaskRunner::PostTask(TaskPriority priority,
+                                      std::unique_ptr<Task> task) {
+  if (terminated_.load(std::memory_order_relaxed)) return;
+  if (priority != TaskPriority::kBestEffort && current_runner == this) {
+    thread_pool_[current_worker_index]->deque().Push(task.release());
+    WakeUpIdleWorker();
+    return;
+  }
+  Inject(priority, std::move(task));
+}
+
+void WorkStealingTaskRunner::PostDelayedTask(TaskPriority priority,
+                                             std::unique_ptr<Task> task,
+                                             double delay_in_seconds) {
+  DCHECK_GE(delay_in_seconds, 0.0);
+  if (terminated_.load(std::memory_order_relaxed)) return;
+  {
+    base::MutexGuard guard(&delayed_lock_);
+    double deadline = MonotonicallyIncreasingTime() + delay_in_seconds;
+    delayed_tasks_.emplace(deadline, std::make_pair(priority, std::move(task)));
+    next_delayed_task_time_.store(delayed_tasks_.begin()->first,
+                                  std::memory_order_relaxed);
+  }
+  // Let an idle worker recompute how long it may wait.
+  WakeUpIdleWorker();
+}
+
+void WorkStealingTaskRunner::Inject(TaskPriority priority,
+                                    std::unique_ptr<Task> task) {
+  InjectionQueue& queue = injection_queues_[static_cast<int>(priority)];
+  {
+    base::MutexGuard guard(&queue.lock);
+    queue.tasks.push_back(std::move(task));
+    queue.size.fetch_add(1, std::memory_order_relaxed);
+  }
+  WakeUpIdleWorker();
+}
+
+void WorkStealingTaskRunner::WakeUpIdleWorker() {
+  // Pairs with the fence in GetNext(): either this thread sees the idle
+  // worker, or the idle worker sees the task that was just posted.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_idle_workers_.load(std::memory_order_relaxed) == 0) return;
+  base::MutexGuard guard(&idle_lock_);
+  idle_condition_.NotifyOne();
+}
+
+std::unique_ptr<Task> WorkStealingTaskRunner::GetNext(WorkerThread* worker) {
+  while (!terminated_.load(std::memory_order_relaxed)) {
+    if (Task* task = FindTask(worker)) return std::unique_ptr<Task>(task);
+
+    base::MutexGuard guard(&idle_lock_);
+    num_idle_workers_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!terminated_.load(std::memory_order_relaxed) && !HasWork()) {
+      double next_delayed_task_time =
+          next_delayed_task_time_.load(std::memory_order_relaxed);
+      if (next_delayed_task_time == kNoDelayedTask) {
+        idle_condition_.Wait(&idle_lock_);
+      } else {
+        // WaitFor unfortunately doesn't care about our fake time and will wait
+        // the 'real' amount of time, based on whatever clock the system call
+        // uses.
+        double wait_time =
+            next_delayed_task_time - MonotonicallyIncreasingTime();
+        bool notified = idle_condition_.WaitFor(
+            &idle_lock_, base::TimeDelta::FromSecondsD(wait_time));
+        USE(notified);
+      }
+    }
+    num_idle_workers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return nullptr;
+}
+
+Task* WorkStealingTaskRunner::FindTask(WorkerThread* worker) {
+  Task* task;
+  if (worker->deque().Pop(&task)) return task;
+  double next_delayed_task_time =
+      next_delayed_task_time_.load(std::memory_order_relaxed);
+  if (next_delayed_task_time != kNoDelayedTask &&
+      next_delayed_task_time <= MonotonicallyIncreasingTime()) {
+    ScheduleDueDelayedTasks();
+  }
+  if ((task = TryPopInjected())) return task;
+  return TrySteal(worker);
+}
+
+Task* WorkStealingTaskRunner::TryPopInjected() {
+  for (int i = kNumPriorities - 1; i >= 0; --i) {
+    InjectionQueue& queue = injection_queues_[i];
+    if (queue.size.load(std::memory_order_relaxed) == 0) continue;
+    base::MutexGuard guard(&queue.lock);
+    if (queue.tasks.empty()) continue;
+    Task* task = queue.tasks.front().release();
+    queue.tasks.pop_front();
+    queue.size.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+  }
+  return nullptr;
+}
+
+Task* WorkStealingTaskRunner::TrySteal(WorkerThread* worker) {
+  const size_t num_workers = thread_pool_.size();
+  const size_t start = worker->NextRandom() % num_workers;
+  for (size_t i = 0; i < num_workers; ++i) {
+    WorkerThread* victim = thread_pool_[(start + i) % num_workers].get();
+    if (victim == worker) continue;
+    Task* task;
+    if (victim->deque().Steal(&task)) return task;
+  }
+  return nullptr;
+}
+
+bool WorkStealingTaskRunner::HasWork() {
+  for (const InjectionQueue& queue : injection_queues_) {
+    if (queue.size.load(std::memory_order_relaxed) > 0) return true;
+  }
+  for (auto& thread : thread_pool_) {
+    if (!thread->deque().IsEmpty()) return true;
+  }
+  return next_delayed_task_time_.load(std::memory_order_relaxed) <=
+         MonotonicallyIncreasingTime();
+}
+
+void WorkStealingTaskRunner::ScheduleDueDelayedTasks() {
+  base::MutexGuard guard(&delayed_lock_);
+  const double now = MonotonicallyIncreasingTime();
+  auto it = delayed_tasks_.begin();
+  while (it != delayed_tasks_.end() && it->first <= now) {
+    Inject(it->second.first, std::move(it->second.second));
+    it = delayed_tasks_.erase(it);
+  }
+  next_delayed_task_time_.store(
+      delayed_tasks_.empty() ? kNoDelayedTask : delayed_tasks_.begin()->first,
+      std::memory_order_relaxed);
+}
+
+}  // namespace platform
+}  // namespace v8
@@ -0,0 +1,108 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LIBPLATFORM_WORK_STEALING_TASK_RUNNER_H_
+#define V8_LIBPLATFORM_WORK_STEALING_TASK_RUNNER_H_
+
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "include/libplatform/libplatform-export.h"
+#include "include/libplatform/libplatform.h"
+#include "include/v8-platform.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/libplatform/work-stealing-deque.h"
+
+namespace v8 {
+namespace platform {
+
+// Runs worker tasks of all priorities on one pool of threads, as an
+// alternative to one DefaultWorkerThreadsTaskRunner per priority.
+//
+// Every worker thread owns a work-stealing deque. Tasks posted from a worker
+// thread of this runner go to the bottom of that thread's deque without
+// taking a lock, which is how job workers spawn more workers. Tasks posted
+// from any other thread go to a global injection queue for their priority.
+// A worker runs tasks from its own deque first, then from the injection
+// queues in priority order, and then steals from the top of other workers'
+// deques. Best-effort tasks always go to their injection queue, so that they
+// don't get ahead of other tasks by being stolen.
+class V8_PLATFORM_EXPORT WorkStealingTaskRunner {
+ public:
+  using TimeFunction = double (*)();
+
+  WorkStealingTaskRunner(
+      uint32_t thread_pool_size, TimeFunction time_function,
+      base::Thread::Priority priority = base::Thread::Priority::kDefault,
+      NumaMode numa_mode = NumaMode::kDisabled);
+  ~WorkStealingTaskRunner();
+
+  WorkStealingTaskRunner(const WorkStealingTaskRunner&) = delete;
+  WorkStealingTaskRunner& operator=(const WorkStealingTaskRunner&) = delete;
+
+  void Terminate();
+
+  double MonotonicallyIncreasingTime();
+
+  void PostTask(TaskPriority priority, std::unique_ptr<Task> task);
+  void PostDelayedTask(TaskPriority priority, std::unique_ptr<Task> task,
+                       double delay_in_seconds);
+
+ private:
+  class WorkerThread;
+
+  struct InjectionQueue {
+    base::Mutex lock;
+    std::deque<std::unique_ptr<Task>> tasks;
+    // Number of tasks in |tasks|, for checking emptiness without the lock.
+    std::atomic<size_t> size{0};
+  };
+
+  static constexpr int kNumPriorities =
+      static_cast<int>(TaskPriority::kMaxPriority) + 1;
+  static constexpr double kNoDelayedTask =
+      std::numeric_limits<double>::infinity();
+
+  void Inject(TaskPriority priority, std::unique_ptr<Task> task);
+
+  // Called by the WorkerThread. Gets the next task to be executed, blocking if
+  // no task is available. Returns nullptr once the runner is terminated.
+  std::unique_ptr<Task> GetNext(WorkerThread* worker);
+  Task* FindTask(WorkerThread* worker);
+  Task* TryPopInjected();
+  Task* TrySteal(WorkerThread* worker);
+  // Returns whether there is a task that an idle worker could run.
+  bool HasWork();
+  // Moves delayed tasks whose deadline has passed to the injection queues.
+  void ScheduleDueDelayedTasks();
+
+  void WakeUpIdleWorker();
+
+  const TimeFunction time_function_;
+  std::vector<std::unique_ptr<WorkerThread>> thread_pool_;
+  InjectionQueue injection_queues_[kNumPriorities];
+
+  base::Mutex delayed_lock_;
+  std::multimap<double, std::pair<TaskPriority, std::unique_ptr<Task>>>
+      delayed_tasks_;
+  std::atomic<double> next_delayed_task_time_{kNoDelayedTask};
+
+  // Idle workers wait on |idle_condition_|. |num_idle_workers_| lets posting
+  // threads skip the lock when all workers are busy.
+  base::Mutex idle_lock_;
+  base::ConditionVariable idle_condition_;
+  std::atomic<size_t> num_idle_workers_{0};
+  std::atomic<bool> terminated_{false};
+};
+
+}  // namespace platform
+}  // namespace v8
+
+#endif  // V8_LIBPLATFORM_WORK_STEALING_TASK_RUNNER_H_
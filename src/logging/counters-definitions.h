@@ -224,6 +224,8 @@ namespace internal {
   HT(maglev_optimize_finalize, V8.MaglevOptimizeFinalize, 100000, MICROSECOND) \
   HT(maglev_optimize_total_time, V8.MaglevOptimizeTotalTime, 1000000,          \
      MICROSECOND)                                                              \
+  HT(maglev_compile_queue_latency, V8.MaglevCompileQueueLatency, 10000000,     \
+     MICROSECOND)                                                              \
   /* TurboFan timers. */                                                       \
   HT(turbofan_optimize_prepare, V8.TurboFanOptimizePrepare, 1000000,           \
      MICROSECOND)                                                              \
@@ -241,6 +243,8 @@ namespace internal {
      V8.TurboFanOptimizeNonConcurrentTotalTime, 10000000, MICROSECOND)         \
   HT(turbofan_optimize_concurrent_total_time,                                  \
      V8.TurboFanOptimizeConcurrentTotalTime, 10000000, MICROSECOND)            \
+  HT(turbofan_compile_queue_latency, V8.TurboFanCompileQueueLatency,           \
+     10000000, MICROSECOND)                                                    \
   HT(turbofan_osr_prepare, V8.TurboFanOptimizeForOnStackReplacementPrepare,    \
      1000000, MICROSECOND)                                                     \
   HT(turbofan_osr_execute, V8.TurboFanOptimizeForOnStackReplacementExecute,    \
@@ -364,7 +368,13 @@ namespace internal {
   SC(enum_cache_hits, V8.EnumCacheHits)                                        \
   SC(enum_cache_misses, V8.EnumCacheMisses)                                    \
   SC(maps_created, V8.MapsCreated)                                             \
+  /* Acquisitions of the space mutex by background allocators, and the */     \
+  /* ones that had to wait for another thread. */                             \
+  SC(concurrent_allocator_space_locks, V8.ConcurrentAllocatorSpaceLocks)       \
+  SC(concurrent_allocator_contended_space_locks,                               \
+     V8.ConcurrentAllocatorContendedSpaceLocks)                                \
   SC(megamorphic_stub_cache_updates, V8.MegamorphicStubCacheUpdates)           \
+  SC(megamorphic_stub_cache_evictions, V8.MegamorphicStubCacheEvictions)       \
   SC(regexp_entry_runtime, V8.RegExpEntryRuntime)                              \
   SC(stack_interrupts, V8.StackInterrupts)                                     \
   SC(new_space_bytes_available, V8.MemoryNewSpaceBytesAvailable)               \
@@ -382,6 +392,9 @@ namespace internal {
   SC(lo_space_bytes_available, V8.MemoryLoSpaceBytesAvailable)                 \
   SC(lo_space_bytes_committed, V8.MemoryLoSpaceBytesCommitted)                 \
   SC(lo_space_bytes_used, V8.MemoryLoSpaceBytesUsed)                           \
+  /* Number of huge pages backing the heap and code range (--huge-pages). */  \
+  SC(huge_pages_heap, V8.MemoryHugePagesHeap)                                  \
+  SC(huge_pages_code, V8.MemoryHugePagesCode)                                  \
   SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)                      \
   SC(wasm_reloc_size, V8.WasmRelocBytes)                                       \
   SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions)           \
@@ -172,6 +172,8 @@ class RuntimeCallTimer final {
   V(Isolate_DateTimeConfigurationChangeNotification)       \
   V(Isolate_LocaleConfigurationChangeNotification)         \
   V(JSON_Parse)                                            \
+  V(JSON_StreamingParser_Feed)                             \
+  V(JSON_StreamingParser_Finish)                           \
   V(JSON_Stringify)                                        \
   V(Map_AsArray)                                           \
   V(Map_Clear)                                             \
@@ -479,6 +481,8 @@ class RuntimeCallTimer final {
   V(IsCompatibleReceiverMap)                   \
   V(IsTemplateFor)                             \
   V(JS_Execution)                              \
+  V(JsonParsePropertyKeyCacheHit)              \
+  V(JsonParsePropertyKeyCacheMiss)             \
   V(Map_SetPrototype)                          \
   V(Map_TransitionToAccessorProperty)          \
   V(Map_TransitionToDataProperty)              \
@@ -8,6 +8,7 @@
 #include "src/compiler/compilation-dependencies.h"
 #include "src/compiler/js-heap-broker.h"
 #include "src/execution/isolate.h"
+#include "src/execution/tiering-manager.h"
 #include "src/flags/flags.h"
 #include "src/handles/persistent-handles.h"
 #include "src/heap/parked-scope.h"
@@ -18,6 +19,7 @@
 #include "src/maglev/maglev-pipeline-statistics.h"
 #include "src/objects/js-function-inl.h"
 #include "src/utils/identity-map.h"
+#include "src/utils/locked-priority-queue-inl.h"
 #include "src/utils/locked-queue-inl.h"
 
 namespace v8 {
@@ -256,8 +258,11 @@ class MaglevConcurrentDispatcher::JobTask final : public v8::JobTask {
     std::unique_ptr<MaglevCompilationJob> job_to_destruct;
     while (!delegate->ShouldYield()) {
       std::unique_ptr<MaglevCompilationJob> job;
-      if (incoming_queue()->Dequeue(&job)) {
+      base::TimeDelta queue_time;
+      if (incoming_queue()->Dequeue(&job, &queue_time)) {
         DCHECK_NOT_NULL(job);
+        isolate()->counters()->maglev_compile_queue_latency()->AddTimedSample(
+            queue_time);
         TRACE_EVENT_WITH_FLOW0(
             TRACE_DISABLED_BY_DEFAULT("v8.compile"), "V8.MaglevBackground",
             job->trace_id(),
@@ -297,7 +302,9 @@ class MaglevConcurrentDispatcher::JobTask final : public v8::JobTask {
 
  private:
   Isolate* isolate() const { return dispatcher_->isolate_; }
-  QueueT* incoming_queue() const { return &dispatcher_->incoming_queue_; }
+  PriorityQueueT* incoming_queue() const {
+    return &dispatcher_->incoming_queue_;
+  }
   QueueT* outgoing_queue() const { return &dispatcher_->outgoing_queue_; }
   QueueT* destruction_queue() const { return &dispatcher_->destruction_queue_; }
 
@@ -343,10 +350,25 @@ MaglevConcurrentDispatcher::~MaglevConcurrentDispatcher() {
 void MaglevConcurrentDispatcher::EnqueueJob(
     std::unique_ptr<MaglevCompilationJob>&& job) {
   DCHECK(is_enabled());
-  incoming_queue_.Enqueue(std::move(job));
+  const int priority =
+      TieringManager::CompileQueuePriority(*job->function(), job->is_osr());
+  incoming_queue_.Enqueue(std::move(job), priority);
   job_handle_->NotifyConcurrencyIncrease();
 }
 
+void MaglevConcurrentDispatcher::Reprioritize(Tagged<JSFunction> function,
+                                              int priority) {
+  DCHECK(is_enabled());
+  DCHECK(isolate_->IsCurrent());
+  // Jobs in the incoming queue are not running yet, so it is safe to
+  // dereference their handles on the main thread.
+  incoming_queue_.RaisePriority(
+      [function](const std::unique_ptr<MaglevCompilationJob>& job) {
+        return *job->function() == function;
+      },
+      priority);
+}
+
 void MaglevConcurrentDispatcher::FinalizeFinishedJobs() {
   HandleScope handle_scope(isolate_);
   while (!outgoing_queue_.IsEmpty()) {
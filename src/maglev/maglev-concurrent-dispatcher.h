@@ -11,6 +11,7 @@
 
 #include "src/codegen/compiler.h"  // For OptimizedCompilationJob.
 #include "src/maglev/maglev-pipeline-statistics.h"
+#include "src/utils/locked-priority-queue.h"
 #include "src/utils/locked-queue.h"
 
 namespace v8 {
@@ -99,6 +100,9 @@ class V8_EXPORT_PRIVATE MaglevConcurrentDispatcher final {
   // TODO(jgruber): There's no reason to use locking queues here, we only use
   // them for simplicity - consider replacing with lock-free data structures.
   using QueueT = LockedQueue<std::unique_ptr<MaglevCompilationJob>>;
+  // Incoming jobs are ordered by the hotness of the function being compiled.
+  using PriorityQueueT =
+      LockedPriorityQueue<std::unique_ptr<MaglevCompilationJob>>;
 
  public:
   explicit MaglevConcurrentDispatcher(Isolate* isolate);
@@ -107,6 +111,10 @@ class V8_EXPORT_PRIVATE MaglevConcurrentDispatcher final {
   // Called from the main thread.
   void EnqueueJob(std::unique_ptr<MaglevCompilationJob>&& job);
 
+  // Called from the main thread. Raises the priority of queued jobs for
+  // |function| to |priority|.
+  void Reprioritize(Tagged<JSFunction> function, int priority);
+
   // Called from the main thread.
   void FinalizeFinishedJobs();
 
@@ -119,7 +127,7 @@ class V8_EXPORT_PRIVATE MaglevConcurrentDispatcher final {
  private:
   Isolate* const isolate_;
   std::unique_ptr<JobHandle> job_handle_;
-  QueueT incoming_queue_;
+  PriorityQueueT incoming_queue_;
   QueueT outgoing_queue_;
   QueueT destruction_queue_;
 };
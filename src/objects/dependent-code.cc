@@ -86,6 +86,23 @@ Handle<DependentCode> DependentCode::InsertWeakCode(
   return entries;
 }
 
+// static
+bool DependentCode::DependsOn(Tagged<HeapObject> object, Tagged<Code> code,
+                              DependencyGroups groups) {
+  DisallowGarbageCollection no_gc;
+  Tagged<DependentCode> entries = GetDependentCode(object);
+  for (int i = 0; i < entries->length(); i += kSlotsPerEntry) {
+    MaybeObject obj = entries->Get(i + kCodeSlotOffset);
+    if (obj->IsCleared() || obj.GetHeapObjectAssumeWeak().ptr() != code.ptr()) {
+      continue;
+    }
+    DependencyGroups entry_groups = static_cast<DependencyGroups>(
+        entries->Get(i + kGroupsSlotOffset).ToSmi().value());
+    if ((entry_groups & groups) != 0) return true;
+  }
+  return false;
+}
+
 void DependentCode::IterateAndCompact(const IterateAndCompactFn& fn) {
   DisallowGarbageCollection no_gc;
 
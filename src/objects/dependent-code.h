@@ -87,6 +87,11 @@ class DependentCode : public WeakArrayList {
                                         Tagged<ObjectT> object,
                                         DependencyGroups groups);
 
+  // Returns whether {code} is registered on {object} in any of {groups}.
+  V8_EXPORT_PRIVATE static bool DependsOn(Tagged<HeapObject> object,
+                                          Tagged<Code> code,
+                                          DependencyGroups groups);
+
   V8_EXPORT_PRIVATE static Tagged<DependentCode> empty_dependent_code(
       const ReadOnlyRoots& roots);
   static constexpr RootIndex kEmptyDependentCode =
@@ -99,7 +99,7 @@ Tagged<InstructionStream> InstructionStream::Initialize(
 // pointer to the relocation info byte array.
 void InstructionStream::Finalize(Tagged<Code> code,
                                  Tagged<ByteArray> reloc_info, CodeDesc desc,
-                                 Heap* heap) {
+                                 Heap* heap, bool flush_icache) {
   DisallowGarbageCollection no_gc;
   base::Optional<WriteBarrierPromise> promise;
 
@@ -138,7 +138,7 @@ void InstructionStream::Finalize(Tagged<Code> code,
                                 no_gc);
   CONDITIONAL_WRITE_BARRIER(*this, kCodeOffset, code, UPDATE_WRITE_BARRIER);
 
-  code->FlushICache();
+  if (flush_icache) code->FlushICache();
 }
 
 Address InstructionStream::body_end() const {
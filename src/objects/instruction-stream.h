@@ -111,8 +111,10 @@ class InstructionStream : public HeapObject {
   static V8_INLINE Tagged<InstructionStream> Initialize(
       Tagged<HeapObject> self, Tagged<Map> map, uint32_t body_size,
       Tagged<ByteArray> reloc_info);
+  // Copies the code from |desc| and publishes |code|. Unless |flush_icache| is
+  // false, also flushes the instruction cache for the new instructions.
   V8_INLINE void Finalize(Tagged<Code> code, Tagged<ByteArray> reloc_info,
-                          CodeDesc desc, Heap* heap);
+                          CodeDesc desc, Heap* heap, bool flush_icache = true);
 
   DECL_CAST(InstructionStream)
   DECL_PRINTER(InstructionStream)
@@ -19,6 +19,7 @@
 #include "src/objects/slots.h"
 #include "src/objects/string-inl.h"
 #include "src/objects/string-table-inl.h"
+#include "src/objects/swiss-hash-table-helpers.h"
 #include "src/snapshot/deserializer.h"
 #include "src/utils/allocation.h"
 #include "src/utils/ostreams.h"
@@ -31,6 +32,19 @@ namespace {
 static constexpr int kStringTableMaxEmptyFactor = 4;
 static constexpr int kStringTableMinCapacity = 2048;
 
+// The string table lives off-heap and is never serialized, so unlike
+// SwissNameDictionary it can pick the group implementation purely by host
+// capabilities.
+#if V8_SWISS_TABLE_HAVE_SSE2_HOST
+using Group = swiss_table::GroupSse2Impl;
+#else
+using Group = swiss_table::GroupPortableImpl;
+#endif
+static_assert(kStringTableMinCapacity % Group::kWidth == 0);
+
+// Probes whole groups of control bytes, see StringTable::Data.
+using GroupProbeSequence = swiss_table::ProbeSequence<1>;
+
 bool StringTableHasSufficientCapacityToAdd(int capacity, int number_of_elements,
                                            int number_of_deleted_elements,
                                            int number_of_additional_elements) {
@@ -76,6 +90,22 @@ bool KeyIsMatch(IsolateT* isolate, StringTableKey* key, Tagged<String> string) {
   return key->IsMatch(isolate, string);
 }
 
+bool IsEmptyOrDeletedElement(Tagged<Object> element) {
+  return element == StringTable::empty_element() ||
+         element == StringTable::deleted_element();
+}
+
+// Returns the index of the first empty or deleted slot in |group|, or -1 if
+// all its slots are full.
+int FirstEmptyOrDeleted(const Group& group) {
+  auto empty = group.MatchEmpty();
+  auto deleted =
+      group.Match(static_cast<swiss_table::h2_t>(swiss_table::kDeleted));
+  if (!empty) return deleted ? deleted.LowestBitSet() : -1;
+  if (!deleted) return empty.LowestBitSet();
+  return std::min(empty.LowestBitSet(), deleted.LowestBitSet());
+}
+
 }  // namespace
 
 // Data holds the actual data of the string table, including capacity and number
@@ -85,9 +115,23 @@ bool KeyIsMatch(IsolateT* isolate, StringTableKey* key, Tagged<String> string) {
 // by the elements themselves. These are accessed as offsets from the elements_
 // field, which itself provides storage for the first element.
 //
-// The elements themselves are stored as an open-addressed hash table, with
-// quadratic probing and Smi 0 and Smi 1 as the empty and deleted sentinels,
-// respectively.
+// The elements themselves are stored as a Swiss table (see
+// swiss-hash-table-helpers.h): the element slots are followed by one control
+// byte per slot, which holds the lowest 7 bits of the hash (H2) of a present
+// element. Lookups compare a whole group of control bytes against H2 at once
+// and only load and compare the strings whose hash fragment matches, rather
+// than every string on the probe sequence.
+//
+// Empty and deleted slots are marked both in the control bytes and, with Smi 0
+// and Smi 1 as sentinels, in the slots themselves, as the GC visits the slots
+// and removes dead strings through DeleteElement. Unlike SwissNameDictionary,
+// groups are aligned and the probe sequence is quadratic over whole groups, so
+// no control bytes need to be mirrored past the end of the table.
+//
+// Concurrent readers may see a control byte and its slot out of sync while an
+// element is being added. Writers set the slot before the control byte, and
+// readers treat a sentinel in a slot with a full control byte as a mismatch,
+// so this can only cause false misses, which LookupKey tolerates.
 class StringTable::Data {
  public:
   static std::unique_ptr<Data> New(int capacity);
@@ -102,8 +146,10 @@ class StringTable::Data {
     return slot(index).Acquire_Load(cage_base);
   }
 
-  void Set(InternalIndex index, Tagged<String> entry) {
+  // Stores |entry|, whose hash is |hash|, at |index|.
+  void Set(InternalIndex index, Tagged<String> entry, uint32_t hash) {
     slot(index).Release_Store(entry);
+    SetCtrl(index, swiss_table::H2(hash));
   }
 
   void ElementAdded() {
@@ -127,6 +173,15 @@ class StringTable::Data {
     number_of_deleted_elements_ += count;
   }
 
+  // Marks the element in |element_slot| as deleted.
+  void DeleteElement(OffHeapObjectSlot element_slot) {
+    DCHECK_LE(slot(InternalIndex(0)), element_slot);
+    DCHECK_LT(element_slot, slot(InternalIndex(capacity_)));
+    InternalIndex index(element_slot - slot(InternalIndex(0)));
+    element_slot.store(deleted_element());
+    SetCtrl(index, swiss_table::kDeleted);
+  }
+
   void* operator new(size_t size, int capacity);
   void* operator new(size_t size) = delete;
   void operator delete(void* description);
@@ -165,14 +220,40 @@ class StringTable::Data {
  private:
   explicit Data(int capacity);
 
-  // Returns probe entry.
-  inline static InternalIndex FirstProbe(uint32_t hash, uint32_t size) {
-    return InternalIndex(hash & (size - 1));
+  swiss_table::ctrl_t* ctrl_table() {
+    return reinterpret_cast<swiss_table::ctrl_t*>(&elements_[capacity_]);
+  }
+  const swiss_table::ctrl_t* ctrl_table() const {
+    return reinterpret_cast<const swiss_table::ctrl_t*>(&elements_[capacity_]);
+  }
+
+  void SetCtrl(InternalIndex index, swiss_table::ctrl_t ctrl) {
+    base::Relaxed_Store(
+        reinterpret_cast<base::Atomic8*>(&ctrl_table()[index.as_uint32()]),
+        static_cast<base::Atomic8>(ctrl));
+  }
+
+  GroupProbeSequence FirstProbe(uint32_t hash) const {
+    return GroupProbeSequence(swiss_table::H1(hash),
+                              capacity_ / Group::kWidth - 1);
   }
 
-  inline static InternalIndex NextProbe(InternalIndex last, uint32_t number,
-                                        uint32_t size) {
-    return InternalIndex((last.as_uint32() + number) & (size - 1));
+  // Returns the control bytes of the group at |group_index|.
+  Group LoadGroup(uint32_t group_index) const {
+    const swiss_table::ctrl_t* ctrl =
+        &ctrl_table()[group_index * Group::kWidth];
+#ifdef THREAD_SANITIZER
+    // Control bytes may be set concurrently. TSAN does not know that the
+    // vector load below tolerates that, so load the bytes one by one instead.
+    swiss_table::ctrl_t copy[Group::kWidth];
+    for (size_t i = 0; i < Group::kWidth; i++) {
+      copy[i] = base::Relaxed_Load(
+          reinterpret_cast<const base::Atomic8*>(ctrl + i));
+    }
+    return Group(copy);
+#else
+    return Group(ctrl);
+#endif  // THREAD_SANITIZER
   }
 
  private:
@@ -197,15 +278,17 @@ void* StringTable::Data::operator new(size_t size, int capacity) {
       0);
 
   // Subtract 1 from capacity, as the member elements_ already supplies the
-  // storage for the first element.
-  return AlignedAllocWithRetry(size + (capacity - 1) * sizeof(Tagged_t),
+  // storage for the first element. The control bytes follow the elements.
+  return AlignedAllocWithRetry(size + (capacity - 1) * sizeof(Tagged_t) +
+                                   capacity * sizeof(swiss_table::ctrl_t),
                                alignof(StringTable::Data));
 }
 
 void StringTable::Data::operator delete(void* table) { AlignedFree(table); }
 
 size_t StringTable::Data::GetCurrentMemoryUsage() const {
-  size_t usage = sizeof(*this) + (capacity_ - 1) * sizeof(Tagged_t);
+  size_t usage = sizeof(*this) + (capacity_ - 1) * sizeof(Tagged_t) +
+                 capacity_ * sizeof(swiss_table::ctrl_t);
   if (previous_data_) {
     usage += previous_data_->GetCurrentMemoryUsage();
   }
@@ -219,6 +302,7 @@ StringTable::Data::Data(int capacity)
       capacity_(capacity) {
   OffHeapObjectSlot first_slot = slot(InternalIndex(0));
   MemsetTagged(first_slot, empty_element(), capacity);
+  memset(ctrl_table(), swiss_table::kEmpty, capacity);
 }
 
 std::unique_ptr<StringTable::Data> StringTable::Data::New(int capacity) {
@@ -237,12 +321,12 @@ std::unique_ptr<StringTable::Data> StringTable::Data::Resize(
   // Rehash the elements.
   for (InternalIndex i : InternalIndex::Range(data->capacity())) {
     Tagged<Object> element = data->Get(cage_base, i);
-    if (element == empty_element() || element == deleted_element()) continue;
+    if (IsEmptyOrDeletedElement(element)) continue;
     Tagged<String> string = String::cast(element);
     uint32_t hash = string->hash();
     InternalIndex insertion_index =
         new_data->FindInsertionEntry(cage_base, hash);
-    new_data->Set(insertion_index, string);
+    new_data->Set(insertion_index, string, hash);
   }
   new_data->number_of_elements_ = data->number_of_elements();
 
@@ -254,60 +338,62 @@ template <typename IsolateT, typename StringTableKey>
 InternalIndex StringTable::Data::FindEntry(IsolateT* isolate,
                                            StringTableKey* key,
                                            uint32_t hash) const {
-  uint32_t count = 1;
+  const swiss_table::ctrl_t h2 = swiss_table::H2(hash);
   // EnsureCapacity will guarantee the hash table is never full.
-  for (InternalIndex entry = FirstProbe(hash, capacity_);;
-       entry = NextProbe(entry, count++, capacity_)) {
-    // TODO(leszeks): Consider delaying the decompression until after the
-    // comparisons against empty/deleted.
-    Tagged<Object> element = Get(isolate, entry);
-    if (element == empty_element()) return InternalIndex::NotFound();
-    if (element == deleted_element()) continue;
-    Tagged<String> string = String::cast(element);
-    if (KeyIsMatch(isolate, key, string)) return entry;
+  for (GroupProbeSequence seq = FirstProbe(hash);; seq.next()) {
+    const Group group = LoadGroup(seq.offset());
+    for (int i : group.Match(h2)) {
+      InternalIndex entry(seq.offset() * Group::kWidth + i);
+      Tagged<Object> element = Get(isolate, entry);
+      if (IsEmptyOrDeletedElement(element)) continue;
+      Tagged<String> string = String::cast(element);
+      if (KeyIsMatch(isolate, key, string)) return entry;
+    }
+    if (group.MatchEmpty()) return InternalIndex::NotFound();
   }
 }
 
 InternalIndex StringTable::Data::FindInsertionEntry(PtrComprCageBase cage_base,
                                                     uint32_t hash) const {
-  uint32_t count = 1;
   // EnsureCapacity will guarantee the hash table is never full.
-  for (InternalIndex entry = FirstProbe(hash, capacity_);;
-       entry = NextProbe(entry, count++, capacity_)) {
-    // TODO(leszeks): Consider delaying the decompression until after the
-    // comparisons against empty/deleted.
-    Tagged<Object> element = Get(cage_base, entry);
-    if (element == empty_element() || element == deleted_element())
-      return entry;
+  for (GroupProbeSequence seq = FirstProbe(hash);; seq.next()) {
+    int i = FirstEmptyOrDeleted(LoadGroup(seq.offset()));
+    if (i < 0) continue;
+    InternalIndex entry(seq.offset() * Group::kWidth + i);
+    DCHECK(IsEmptyOrDeletedElement(Get(cage_base, entry)));
+    return entry;
   }
 }
 
 template <typename IsolateT, typename StringTableKey>
 InternalIndex StringTable::Data::FindEntryOrInsertionEntry(
     IsolateT* isolate, StringTableKey* key, uint32_t hash) const {
+  const swiss_table::ctrl_t h2 = swiss_table::H2(hash);
   InternalIndex insertion_entry = InternalIndex::NotFound();
-  uint32_t count = 1;
   // EnsureCapacity will guarantee the hash table is never full.
-  for (InternalIndex entry = FirstProbe(hash, capacity_);;
-       entry = NextProbe(entry, count++, capacity_)) {
-    // TODO(leszeks): Consider delaying the decompression until after the
-    // comparisons against empty/deleted.
-    Tagged<Object> element = Get(isolate, entry);
-    if (element == empty_element()) {
-      // Empty entry, it's our insertion entry if there was no previous Hole.
-      if (insertion_entry.is_not_found()) return entry;
-      return insertion_entry;
+  for (GroupProbeSequence seq = FirstProbe(hash);; seq.next()) {
+    const Group group = LoadGroup(seq.offset());
+    for (int i : group.Match(h2)) {
+      InternalIndex entry(seq.offset() * Group::kWidth + i);
+      Tagged<Object> element = Get(isolate, entry);
+      if (IsEmptyOrDeletedElement(element)) continue;
+      Tagged<String> string = String::cast(element);
+      if (KeyIsMatch(isolate, key, string)) return entry;
     }
 
-    if (element == deleted_element()) {
-      // Holes are potential insertion candidates, but we continue the search
-      // in case we find the actual matching entry.
-      if (insertion_entry.is_not_found()) insertion_entry = entry;
-      continue;
+    // Deleted slots are potential insertion candidates, but we continue the
+    // search until a group with an empty slot in case we find the actual
+    // matching entry.
+    if (insertion_entry.is_not_found()) {
+      int i = FirstEmptyOrDeleted(group);
+      if (i >= 0) {
+        insertion_entry = InternalIndex(seq.offset() * Group::kWidth + i);
+      }
+    }
+    if (group.MatchEmpty()) {
+      DCHECK(insertion_entry.is_found());
+      return insertion_entry;
     }
-
-    Tagged<String> string = String::cast(element);
-    if (KeyIsMatch(isolate, key, string)) return entry;
   }
 }
 
@@ -459,6 +545,10 @@ void SetInternalizedReference(Isolate* isolate, Tagged<String> string,
   DCHECK(!IsInternalizedString(string));
   DCHECK(IsInternalizedString(internalized));
   DCHECK(!internalized->HasInternalizedForwardingIndex(kAcquireLoad));
+  // Pinned strings must keep their characters (see v8::PinnedContentsScope),
+  // so they are not turned into ThinStrings. Later lookups find the
+  // internalized string again.
+  if (Heap::IsPinned(string)) return;
   if (string->IsShared() || v8_flags.always_use_string_forwarding_table) {
     uint32_t field = string->raw_hash_field(kAcquireLoad);
     // Don't use the forwarding table for strings that have an integer index.
@@ -621,7 +711,7 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
       // element.
       Handle<String> new_string = key->GetHandleForInsertion();
       DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
-      data->Set(entry, *new_string);
+      data->Set(entry, *new_string, key->hash());
       data->ElementAdded();
       return new_string;
     } else if (element == deleted_element()) {
@@ -629,7 +719,7 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
       // overwrote a deleted element.
       Handle<String> new_string = key->GetHandleForInsertion();
       DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
-      data->Set(entry, *new_string);
+      data->Set(entry, *new_string, key->hash());
       data->DeletedElementOverwritten();
       return new_string;
     } else {
@@ -851,7 +941,7 @@ void StringTable::InsertForIsolateDeserialization(
 
       Handle<String> inserted_string = key.GetHandleForInsertion();
       DCHECK_IMPLIES(v8_flags.shared_string_table, inserted_string->IsShared());
-      data->Set(entry, *inserted_string);
+      data->Set(entry, *inserted_string, key.hash());
       data->ElementAdded();
     }
   }
@@ -875,7 +965,7 @@ void StringTable::InsertEmptyStringForBootstrapping(Isolate* isolate) {
     DCHECK_EQ(data->Get(isolate, entry), empty_element());
 
     DCHECK_IMPLIES(v8_flags.shared_string_table, empty_string->IsShared());
-    data->Set(entry, *empty_string);
+    data->Set(entry, *empty_string, hash);
     data->ElementAdded();
   }
   DCHECK_EQ(NumberOfElements(), 1);
@@ -913,5 +1003,12 @@ void StringTable::NotifyElementsRemoved(int count) {
   data_.load(std::memory_order_relaxed)->ElementsRemoved(count);
 }
 
+void StringTable::DeleteElement(OffHeapObjectSlot slot) {
+  // This should only happen during garbage collection when background threads
+  // are paused, so the load can be relaxed.
+  DCHECK_NE(isolate_->heap()->gc_state(), Heap::NOT_IN_GC);
+  data_.load(std::memory_order_relaxed)->DeleteElement(slot);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -87,6 +87,9 @@ class V8_EXPORT_PRIVATE StringTable {
   void IterateElements(RootVisitor* visitor);
   void DropOldData();
   void NotifyElementsRemoved(int count);
+  // Removes the dead string in |slot|, which must have been passed to a
+  // visitor by IterateElements.
+  void DeleteElement(OffHeapObjectSlot slot);
 
   void VerifyIfOwnedBy(Isolate* isolate);
 
@@ -194,6 +194,8 @@ void String::MakeThin(IsolateT* isolate, Tagged<String> internalized) {
   DisallowGarbageCollection no_gc;
   DCHECK_NE(*this, internalized);
   DCHECK(IsInternalizedString(internalized));
+  // The characters of pinned strings are in use, see v8::PinnedContentsScope.
+  DCHECK(!Heap::IsPinned(*this));
 
   Tagged<Map> initial_map = map(kAcquireLoad);
   StringShape initial_shape(initial_map);
@@ -602,6 +604,9 @@ bool String::SupportsExternalization(v8::String::Encoding encoding) {
     return false;
   }
 
+  // The characters of pinned strings are in use, see v8::PinnedContentsScope.
+  if (Heap::IsPinned(*this)) return false;
+
   // Encoding changes are not supported.
   static_assert(kStringEncodingMask == 1 << 3);
   static_assert(v8::String::Encoding::ONE_BYTE_ENCODING == 1 << 3);
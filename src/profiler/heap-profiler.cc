@@ -119,6 +119,44 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(
   return result;
 }
 
+bool HeapProfiler::StreamSnapshot(
+    v8::OutputStream* stream,
+    const v8::HeapProfiler::HeapSnapshotOptions options) {
+  is_taking_snapshot_ = true;
+  bool result = false;
+  {
+    HeapSnapshot snapshot(this, options.snapshot_mode, options.numerics_mode);
+    HeapSnapshotBinarySerializer serializer(&snapshot);
+    serializer.StartStreaming(stream);
+
+    heap()->stack().SetMarkerIfNeededAndCallback(
+        [this, &options, &snapshot, &result]() {
+          base::Optional<CppClassNamesAsHeapObjectNameScope> use_cpp_class_name;
+          if (snapshot.expose_internals() && heap()->cpp_heap()) {
+            use_cpp_class_name.emplace(heap()->cpp_heap());
+          }
+
+          HeapSnapshotGenerator generator(
+              &snapshot, options.control, options.global_object_name_resolver,
+              heap(), options.stack_state);
+          result = generator.GenerateSnapshot();
+        });
+    // Nodes and locations are written even if generation was interrupted, so
+    // that the stream is always terminated.
+    result = serializer.FinishStreaming() && result;
+  }
+  ids_->RemoveDeadEntries();
+  if (native_move_listener_) {
+    native_move_listener_->StartListening();
+  }
+  is_tracking_object_moves_ = true;
+  heap()->isolate()->UpdateLogObjectRelocation();
+  is_taking_snapshot_ = false;
+  MaybeClearStringsStorage();
+
+  return result;
+}
+
 class FileOutputStream : public v8::OutputStream {
  public:
   explicit FileOutputStream(const char* filename) : os_(filename) {}
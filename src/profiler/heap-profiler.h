@@ -60,6 +60,10 @@ class HeapProfiler : public HeapObjectAllocationTracker {
 
   HeapSnapshot* TakeSnapshot(
       const v8::HeapProfiler::HeapSnapshotOptions options);
+  // Generates a snapshot in the binary format and writes it to |stream|
+  // while it is generated, without retaining it.
+  bool StreamSnapshot(v8::OutputStream* stream,
+                      const v8::HeapProfiler::HeapSnapshotOptions options);
 
   // Implementation of --heap-snapshot-on-oom.
   void WriteSnapshotToDiskAfterGC();
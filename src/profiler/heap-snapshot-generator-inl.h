@@ -59,6 +59,13 @@ uint32_t HeapSnapshotJSONSerializer::StringHash(const void* string) {
                                             v8::internal::kZeroHashSeed);
 }
 
+uint32_t HeapSnapshotBinarySerializer::StringHash(const void* string) {
+  const char* s = reinterpret_cast<const char*>(string);
+  int len = static_cast<int>(strlen(s));
+  return StringHasher::HashSequentialString(s, len,
+                                            v8::internal::kZeroHashSeed);
+}
+
 int HeapSnapshotJSONSerializer::to_node_index(const HeapEntry* e) {
   return to_node_index(e->index());
 }
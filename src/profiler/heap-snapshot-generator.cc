@@ -290,7 +290,12 @@ void HeapEntry::SetNamedReference(HeapGraphEdge::Type type, const char* name,
                                   HeapSnapshotGenerator* generator,
                                   ReferenceVerification verification) {
   ++children_count_;
-  snapshot_->edges().emplace_back(type, name, this, entry);
+  if (HeapSnapshotBinarySerializer* serializer =
+          snapshot_->streaming_serializer()) {
+    serializer->SerializeEdge(HeapGraphEdge(type, name, this, entry));
+  } else {
+    snapshot_->edges().emplace_back(type, name, this, entry);
+  }
   VerifyReference(type, entry, generator, verification);
 }
 
@@ -299,7 +304,12 @@ void HeapEntry::SetIndexedReference(HeapGraphEdge::Type type, int index,
                                     HeapSnapshotGenerator* generator,
                                     ReferenceVerification verification) {
   ++children_count_;
-  snapshot_->edges().emplace_back(type, index, this, entry);
+  if (HeapSnapshotBinarySerializer* serializer =
+          snapshot_->streaming_serializer()) {
+    serializer->SerializeEdge(HeapGraphEdge(type, index, this, entry));
+  } else {
+    snapshot_->edges().emplace_back(type, index, this, entry);
+  }
   VerifyReference(type, entry, generator, verification);
 }
 
@@ -2994,7 +3004,8 @@ bool HeapSnapshotGenerator::GenerateSnapshot() {
 
   if (!FillReferences()) return false;
 
-  snapshot_->FillChildren();
+  // A streamed snapshot has written its edges out already.
+  if (!snapshot_->streaming_serializer()) snapshot_->FillChildren();
   snapshot_->RememberLastJSObjectId();
 
   progress_counter_ = progress_total_;
@@ -3039,6 +3050,10 @@ void HeapSnapshotGenerator::ProgressStep() {
 
 bool HeapSnapshotGenerator::ProgressReport(bool force) {
   const int kProgressReportGranularity = 10000;
+  if (snapshot_->streaming_serializer() &&
+      snapshot_->streaming_serializer()->aborted()) {
+    return false;
+  }
   if (control_ != nullptr &&
       (force || progress_counter_ % kProgressReportGranularity == 0)) {
     return control_->ReportProgressValue(progress_counter_, progress_total_) ==
@@ -3556,5 +3571,131 @@ void HeapSnapshotJSONSerializer::SerializeLocations() {
   }
 }
 
+HeapSnapshotBinarySerializer::HeapSnapshotBinarySerializer(
+    HeapSnapshot* snapshot)
+    : snapshot_(snapshot), strings_(StringsMatch) {}
+
+HeapSnapshotBinarySerializer::~HeapSnapshotBinarySerializer() {
+  DCHECK_NULL(writer_);
+}
+
+void HeapSnapshotBinarySerializer::Serialize(v8::OutputStream* stream) {
+  DCHECK(snapshot_->is_complete());
+  DCHECK_NULL(writer_);
+  writer_ = new OutputStreamWriter(stream);
+  SerializeHeader();
+  for (const HeapGraphEdge& edge : snapshot_->edges()) {
+    SerializeEdge(edge);
+    if (writer_->aborted()) break;
+  }
+  if (!writer_->aborted()) SerializeNodesAndLocations();
+  delete writer_;
+  writer_ = nullptr;
+}
+
+void HeapSnapshotBinarySerializer::StartStreaming(v8::OutputStream* stream) {
+  DCHECK(snapshot_->entries().empty());
+  DCHECK_NULL(writer_);
+  writer_ = new OutputStreamWriter(stream);
+  snapshot_->set_streaming_serializer(this);
+  SerializeHeader();
+}
+
+bool HeapSnapshotBinarySerializer::FinishStreaming() {
+  DCHECK_EQ(this, snapshot_->streaming_serializer());
+  snapshot_->set_streaming_serializer(nullptr);
+  // See SerializeEdge().
+  DisallowGarbageCollection no_gc;
+  DisallowHandleAllocation no_handles;
+  if (!writer_->aborted()) SerializeNodesAndLocations();
+  const bool aborted = writer_->aborted();
+  delete writer_;
+  writer_ = nullptr;
+  return !aborted;
+}
+
+bool HeapSnapshotBinarySerializer::aborted() const {
+  return writer_->aborted();
+}
+
+int HeapSnapshotBinarySerializer::GetStringId(const char* s) {
+  base::HashMap::Entry* cache_entry =
+      strings_.LookupOrInsert(const_cast<char*>(s), StringHash(s));
+  if (cache_entry->value == nullptr) {
+    const int id = next_string_id_++;
+    cache_entry->value = reinterpret_cast<void*>(static_cast<intptr_t>(id));
+    const size_t length = strlen(s);
+    writer_->AddByte(kString);
+    writer_->AddVarint(id);
+    writer_->AddVarint(length);
+    writer_->AddBytes(reinterpret_cast<const uint8_t*>(s),
+                      static_cast<int>(length));
+  }
+  return static_cast<int>(reinterpret_cast<intptr_t>(cache_entry->value));
+}
+
+void HeapSnapshotBinarySerializer::SerializeHeader() {
+  writer_->AddString("V8HS");
+  writer_->AddVarint(kVersion);
+}
+
+void HeapSnapshotBinarySerializer::SerializeEdge(const HeapGraphEdge& edge) {
+  // Writing may call the OutputStream while the heap is being traversed,
+  // which must neither call into V8 nor allocate, see
+  // v8::HeapProfiler::StreamHeapSnapshot().
+  DisallowGarbageCollection no_gc;
+  DisallowHandleAllocation no_handles;
+  // Strings are written before the record that refers to them.
+  const int edge_name_or_index = edge.type() == HeapGraphEdge::kElement ||
+                                         edge.type() == HeapGraphEdge::kHidden
+                                     ? edge.index()
+                                     : GetStringId(edge.name());
+  writer_->AddByte(kEdge);
+  writer_->AddVarint(edge.type());
+  writer_->AddVarint(edge_name_or_index);
+  writer_->AddVarint(edge.from()->id());
+  writer_->AddVarint(edge.to()->id());
+  ++edge_count_;
+}
+
+void HeapSnapshotBinarySerializer::SerializeNodesAndLocations() {
+  for (const HeapEntry& entry : snapshot_->entries()) {
+    SerializeNode(entry);
+    if (writer_->aborted()) return;
+  }
+  for (const SourceLocation& location : snapshot_->locations()) {
+    SerializeLocation(location);
+    if (writer_->aborted()) return;
+  }
+  SerializeEnd();
+}
+
+void HeapSnapshotBinarySerializer::SerializeNode(const HeapEntry& entry) {
+  const int name_id = GetStringId(entry.name());
+  writer_->AddByte(kNode);
+  writer_->AddVarint(entry.type());
+  writer_->AddVarint(name_id);
+  writer_->AddVarint(entry.id());
+  writer_->AddVarint(entry.self_size());
+  writer_->AddVarint(entry.trace_node_id());
+  writer_->AddVarint(entry.detachedness());
+}
+
+void HeapSnapshotBinarySerializer::SerializeLocation(
+    const SourceLocation& location) {
+  writer_->AddByte(kLocation);
+  writer_->AddVarint(snapshot_->entries()[location.entry_index].id());
+  writer_->AddVarint(static_cast<unsigned>(location.scriptId));
+  writer_->AddVarint(static_cast<unsigned>(location.line));
+  writer_->AddVarint(static_cast<unsigned>(location.col));
+}
+
+void HeapSnapshotBinarySerializer::SerializeEnd() {
+  writer_->AddByte(kEnd);
+  writer_->AddVarint(snapshot_->entries().size());
+  writer_->AddVarint(edge_count_);
+  writer_->Finalize();
+}
+
 }  // namespace internal
 }  // namespace v8
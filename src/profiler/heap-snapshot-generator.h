@@ -35,6 +35,7 @@ class AllocationTraceNode;
 class HeapEntry;
 class HeapProfiler;
 class HeapSnapshot;
+class HeapSnapshotBinarySerializer;
 class HeapSnapshotGenerator;
 class IsolateSafepointScope;
 class JSArrayBuffer;
@@ -243,6 +244,14 @@ class HeapSnapshot {
     return max_snapshot_js_object_id_;
   }
   bool is_complete() const { return !children_.empty(); }
+  // Set while the snapshot is streamed, see HeapProfiler::StreamSnapshot().
+  // References are then written out instead of being retained in |edges_|.
+  HeapSnapshotBinarySerializer* streaming_serializer() const {
+    return streaming_serializer_;
+  }
+  void set_streaming_serializer(HeapSnapshotBinarySerializer* serializer) {
+    streaming_serializer_ = serializer;
+  }
   bool capture_numeric_value() const {
     return numerics_mode_ ==
            v8::HeapProfiler::NumericsMode::kExposeNumericValues;
@@ -284,6 +293,7 @@ class HeapSnapshot {
   SnapshotObjectId max_snapshot_js_object_id_ = -1;
   v8::HeapProfiler::HeapSnapshotMode snapshot_mode_;
   v8::HeapProfiler::NumericsMode numerics_mode_;
+  HeapSnapshotBinarySerializer* streaming_serializer_ = nullptr;
 };
 
 
@@ -762,6 +772,62 @@ class HeapSnapshotJSONSerializer {
   friend class HeapSnapshotJSONSerializerIterator;
 };
 
+// Writes a snapshot in the binary format described at
+// v8::HeapSnapshot::Serialize(). Records refer to nodes by their
+// SnapshotObjectId rather than by their position, so edges can be written
+// while the snapshot is still being generated.
+class HeapSnapshotBinarySerializer {
+ public:
+  explicit HeapSnapshotBinarySerializer(HeapSnapshot* snapshot);
+  ~HeapSnapshotBinarySerializer();
+  HeapSnapshotBinarySerializer(const HeapSnapshotBinarySerializer&) = delete;
+  HeapSnapshotBinarySerializer& operator=(const HeapSnapshotBinarySerializer&) =
+      delete;
+
+  // Serializes a complete snapshot.
+  void Serialize(v8::OutputStream* stream);
+
+  // Streams a snapshot that is being generated. Edges are written by
+  // SerializeEdge() as they are added to the snapshot, and nodes once the
+  // snapshot is generated. Returns false if the stream was aborted.
+  void StartStreaming(v8::OutputStream* stream);
+  void SerializeEdge(const HeapGraphEdge& edge);
+  bool FinishStreaming();
+
+  bool aborted() const;
+
+ private:
+  enum RecordType : uint8_t {
+    kEnd = 0,
+    kString = 1,
+    kNode = 2,
+    kEdge = 3,
+    kLocation = 4,
+  };
+  static const uint32_t kVersion = 1;
+
+  V8_INLINE static bool StringsMatch(void* key1, void* key2) {
+    return strcmp(reinterpret_cast<char*>(key1),
+                  reinterpret_cast<char*>(key2)) == 0;
+  }
+
+  V8_INLINE static uint32_t StringHash(const void* string);
+
+  // Writes a string record the first time |s| is seen.
+  int GetStringId(const char* s);
+  void SerializeHeader();
+  void SerializeNodesAndLocations();
+  void SerializeNode(const HeapEntry& entry);
+  void SerializeLocation(const SourceLocation& location);
+  void SerializeEnd();
+
+  HeapSnapshot* snapshot_;
+  base::CustomMatcherHashMap strings_;
+  int next_string_id_ = 1;
+  size_t edge_count_ = 0;
+  OutputStreamWriter* writer_ = nullptr;
+};
+
 
 }  // namespace internal
 }  // namespace v8
@@ -561,6 +561,8 @@ MaybeHandle<JSObject> CreateLiteral(Isolate* isolate,
     creation_context.ExitScope(site, boilerplate);
 
     vector->SynchronizedSet(literals_slot, *site);
+    isolate->heap()->pretenuring_handler()->ApplyImportedPretenuringFeedback(
+        *vector, literals_slot, *site);
   }
 
   static_assert(static_cast<int>(ObjectLiteral::kDisableMementos) ==
@@ -5,6 +5,8 @@
 #include "src/snapshot/code-serializer.h"
 
 #include <memory>
+#include <unordered_set>
+#include <utility>
 
 #include "src/base/logging.h"
 #include "src/base/platform/elapsed-timer.h"
@@ -12,6 +14,8 @@
 #include "src/baseline/baseline-batch-compiler.h"
 #include "src/codegen/background-merge-task.h"
 #include "src/common/globals.h"
+#include "src/execution/protectors.h"
+#include "src/execution/tiering-manager.h"
 #include "src/handles/maybe-handles.h"
 #include "src/handles/persistent-handles.h"
 #include "src/heap/heap-inl.h"
@@ -19,6 +23,8 @@
 #include "src/logging/counters-scopes.h"
 #include "src/logging/log.h"
 #include "src/logging/runtime-call-stats-scope.h"
+#include "src/objects/dependent-code.h"
+#include "src/objects/feedback-vector-inl.h"
 #include "src/objects/objects-inl.h"
 #include "src/objects/shared-function-info.h"
 #include "src/objects/slots.h"
@@ -46,6 +52,99 @@ CodeSerializer::CodeSerializer(Isolate* isolate, uint32_t source_hash)
     : Serializer(isolate, Snapshot::kDefaultSerializerFlags),
       source_hash_(source_hash) {}
 
+namespace {
+
+// Optimized code cannot be cached since it embeds context-specific objects
+// such as maps. Instead, the cache records which functions were optimized,
+// together with the protectors their code relied on, so that they can tier
+// up early after deserialization if these protectors still hold. Other
+// dependencies of the code, e.g. on maps of builtin prototypes, are not
+// revalidated; they are checked again when the function is re-optimized.
+//
+// Feedback vectors are not reachable from the script's functions (the one of
+// the toplevel function is only held by its closure), so this walks the heap
+// and is behind --code-cache-tiering-hints.
+#define PROTECTOR_CELL(unused_name, unused_root_index, cell) \
+  isolate->factory()->cell(),
+#define PROTECTOR_COUNT(...) +1
+static_assert(0 DECLARED_PROTECTORS_ON_ISOLATE(PROTECTOR_COUNT) <= 32);
+
+std::vector<uint32_t> CollectTieringHints(Isolate* isolate,
+                                          Handle<Script> script) {
+  std::vector<uint32_t> hints;
+  if (!v8_flags.code_cache_tiering_hints || !isolate->use_optimizer()) {
+    return hints;
+  }
+  Handle<PropertyCell> protectors[] = {
+      DECLARED_PROTECTORS_ON_ISOLATE(PROTECTOR_CELL)};
+  std::unordered_set<int> seen;
+  HeapObjectIterator iterator(isolate->heap());
+  for (Tagged<HeapObject> object = iterator.Next(); !object.is_null();
+       object = iterator.Next()) {
+    if (!IsFeedbackVector(object)) continue;
+    Tagged<FeedbackVector> vector = FeedbackVector::cast(object);
+    Tagged<SharedFunctionInfo> shared = vector->shared_function_info();
+    if (shared->script() != *script || !vector->has_optimized_code()) continue;
+    Tagged<Code> code = vector->optimized_code();
+    if (code->marked_for_deoptimization()) continue;
+    if (!seen.insert(shared->function_literal_id()).second) continue;
+    uint32_t protector_bits = 0;
+    for (size_t i = 0; i < arraysize(protectors); ++i) {
+      if (DependentCode::DependsOn(*protectors[i], code,
+                                   DependentCode::kPropertyCellChangedGroup)) {
+        protector_bits |= 1u << i;
+      }
+    }
+    hints.push_back(shared->function_literal_id());
+    hints.push_back(static_cast<uint32_t>(code->kind()));
+    hints.push_back(protector_bits);
+  }
+  static_assert(CodeSerializer::kTieringHintSize == 3);
+  return hints;
+}
+
+void ApplyTieringHints(Isolate* isolate, Handle<SharedFunctionInfo> toplevel,
+                       base::Vector<const uint32_t> hints) {
+  if (hints.empty() || !isolate->use_optimizer()) return;
+  Handle<PropertyCell> protectors[] = {
+      DECLARED_PROTECTORS_ON_ISOLATE(PROTECTOR_CELL)};
+  DisallowGarbageCollection no_gc;
+  Tagged<Script> script = Script::cast(toplevel->script());
+  Tagged<WeakFixedArray> infos = script->shared_function_infos();
+  for (size_t i = 0; i + CodeSerializer::kTieringHintSize <= hints.size();
+       i += CodeSerializer::kTieringHintSize) {
+    const uint32_t function_literal_id = hints[i];
+    const CodeKind kind = static_cast<CodeKind>(hints[i + 1]);
+    const uint32_t protector_bits = hints[i + 2];
+    if (kind != CodeKind::MAGLEV && kind != CodeKind::TURBOFAN) continue;
+    bool protectors_intact = true;
+    for (size_t j = 0; j < arraysize(protectors); ++j) {
+      if ((protector_bits & (1u << j)) &&
+          protectors[j]->value() !=
+              Smi::FromInt(Protectors::kProtectorValid)) {
+        protectors_intact = false;
+        break;
+      }
+    }
+    if (!protectors_intact) continue;
+    if (function_literal_id >= static_cast<uint32_t>(infos->length())) {
+      continue;
+    }
+    Tagged<HeapObject> shared;
+    if (!infos->get(function_literal_id).GetHeapObject(&shared) ||
+        !IsSharedFunctionInfo(shared)) {
+      continue;
+    }
+    isolate->tiering_manager()->AddCodeCacheHint(
+        script, SharedFunctionInfo::cast(shared), kind);
+  }
+}
+
+#undef PROTECTOR_COUNT
+#undef PROTECTOR_CELL
+
+}  // namespace
+
 // static
 ScriptCompiler::CachedData* CodeSerializer::Serialize(
     Isolate* isolate, Handle<SharedFunctionInfo> info) {
@@ -72,8 +171,12 @@ ScriptCompiler::CachedData* CodeSerializer::Serialize(
   // Serialize code object.
   Handle<String> source(String::cast(script->source()), isolate);
   HandleScope scope(isolate);
+  // Collected before the serializer disallows garbage collection, as
+  // iterating the heap may have to finish sweeping.
+  std::vector<uint32_t> tiering_hints = CollectTieringHints(isolate, script);
   CodeSerializer cs(isolate, SerializedCodeData::SourceHash(
                                  source, script->origin_options()));
+  cs.tiering_hints_ = std::move(tiering_hints);
   DisallowGarbageCollection no_gc;
   cs.reference_map()->AddAttachedReference(*source);
   AlignedCachedData* cached_data = cs.SerializeSharedFunctionInfo(info);
@@ -484,6 +587,7 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
 
   BaselineBatchCompileIfSparkplugCompiled(isolate,
                                           Script::cast(result->script()));
+  ApplyTieringHints(isolate, result, scd.TieringHints());
   if (v8_flags.profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
     int length = cached_data->length();
@@ -625,6 +729,7 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::FinishOffThreadDeserialize(
     }
     isolate->heap()->SetRootScriptList(*list);
   }
+  ApplyTieringHints(isolate, result, scd.TieringHints());
 
   if (v8_flags.profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
@@ -646,7 +751,12 @@ SerializedCodeData::SerializedCodeData(const std::vector<uint8_t>* payload,
   DisallowGarbageCollection no_gc;
 
   // Calculate sizes.
-  uint32_t size = kHeaderSize + static_cast<uint32_t>(payload->size());
+  const std::vector<uint32_t>& tiering_hints = cs->tiering_hints();
+  const uint32_t tiering_hints_length =
+      static_cast<uint32_t>(tiering_hints.size() * kUInt32Size);
+  uint32_t size = kHeaderSize + static_cast<uint32_t>(payload->size()) +
+                  POINTER_SIZE_ALIGN(tiering_hints_length);
+  DCHECK(IsAligned(payload->size(), kPointerAlignment));
   DCHECK(IsAligned(size, kPointerAlignment));
 
   // Allocate backing store and create result data.
@@ -664,13 +774,19 @@ SerializedCodeData::SerializedCodeData(const std::vector<uint8_t>* payload,
                  Snapshot::ExtractReadOnlySnapshotChecksum(
                      cs->isolate()->snapshot_blob()));
   SetHeaderValue(kPayloadLengthOffset, static_cast<uint32_t>(payload->size()));
+  SetHeaderValue(kTieringHintsLengthOffset, tiering_hints_length);
 
   // Zero out any padding in the header.
   memset(data_ + kUnalignedHeaderSize, 0, kHeaderSize - kUnalignedHeaderSize);
 
-  // Copy serialized data.
+  // Copy serialized data, followed by the tiering hints and their padding.
   CopyBytes(data_ + kHeaderSize, payload->data(),
             static_cast<size_t>(payload->size()));
+  uint8_t* tiering_hints_start = data_ + kHeaderSize + payload->size();
+  memset(tiering_hints_start, 0, POINTER_SIZE_ALIGN(tiering_hints_length));
+  if (tiering_hints_length > 0) {
+    memcpy(tiering_hints_start, tiering_hints.data(), tiering_hints_length);
+  }
   uint32_t checksum =
       v8_flags.verify_snapshot_checksum ? Checksum(ChecksummedContent()) : 0;
   SetHeaderValue(kChecksumOffset, checksum);
@@ -717,8 +833,12 @@ SerializedCodeSanityCheckResult SerializedCodeData::SanityCheckWithoutSource(
     return SerializedCodeSanityCheckResult::kReadOnlySnapshotChecksumMismatch;
   }
   uint32_t payload_length = GetHeaderValue(kPayloadLengthOffset);
+  uint32_t tiering_hints_length = GetHeaderValue(kTieringHintsLengthOffset);
   uint32_t max_payload_length = size_ - kHeaderSize;
-  if (payload_length > max_payload_length) {
+  if (payload_length > max_payload_length ||
+      tiering_hints_length > max_payload_length - payload_length ||
+      tiering_hints_length % (CodeSerializer::kTieringHintSize * kUInt32Size) !=
+          0) {
     return SerializedCodeSanityCheckResult::kLengthMismatch;
   }
   if (v8_flags.verify_snapshot_checksum) {
@@ -755,10 +875,21 @@ base::Vector<const uint8_t> SerializedCodeData::Payload() const {
   const uint8_t* payload = data_ + kHeaderSize;
   DCHECK(IsAligned(reinterpret_cast<intptr_t>(payload), kPointerAlignment));
   int length = GetHeaderValue(kPayloadLengthOffset);
-  DCHECK_EQ(data_ + size_, payload + length);
+  DCHECK_EQ(data_ + size_,
+            payload + length +
+                POINTER_SIZE_ALIGN(GetHeaderValue(kTieringHintsLengthOffset)));
   return base::Vector<const uint8_t>(payload, length);
 }
 
+base::Vector<const uint32_t> SerializedCodeData::TieringHints() const {
+  const uint8_t* hints =
+      data_ + kHeaderSize + GetHeaderValue(kPayloadLengthOffset);
+  DCHECK(IsAligned(reinterpret_cast<intptr_t>(hints), kUInt32Size));
+  int length = GetHeaderValue(kTieringHintsLengthOffset) / kUInt32Size;
+  return base::Vector<const uint32_t>(reinterpret_cast<const uint32_t*>(hints),
+                                      length);
+}
+
 SerializedCodeData::SerializedCodeData(AlignedCachedData* data)
     : SerializedData(const_cast<uint8_t*>(data->data()), data->length()) {}
 
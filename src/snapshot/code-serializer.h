@@ -5,6 +5,8 @@
 #ifndef V8_SNAPSHOT_CODE_SERIALIZER_H_
 #define V8_SNAPSHOT_CODE_SERIALIZER_H_
 
+#include <vector>
+
 #include "src/base/macros.h"
 #include "src/snapshot/serializer.h"
 #include "src/snapshot/snapshot-data.h"
@@ -109,6 +111,12 @@ class CodeSerializer : public Serializer {
       BackgroundMergeTask* background_merge_task = nullptr);
 
   uint32_t source_hash() const { return source_hash_; }
+  const std::vector<uint32_t>& tiering_hints() const { return tiering_hints_; }
+
+  // Each tiering hint consists of a function literal id, the kind of the
+  // function's optimized code and a bit set of the protectors that code
+  // depended on.
+  static constexpr int kTieringHintSize = 3;
 
  protected:
   CodeSerializer(Isolate* isolate, uint32_t source_hash);
@@ -121,6 +129,7 @@ class CodeSerializer : public Serializer {
 
   DISALLOW_GARBAGE_COLLECTION(no_gc_)
   uint32_t source_hash_;
+  std::vector<uint32_t> tiering_hints_;
 };
 
 // Wrapper around ScriptData to provide code-serializer-specific functionality.
@@ -134,7 +143,10 @@ class SerializedCodeData : public SerializedData {
       kFlagHashOffset + kUInt32Size;
   static const uint32_t kPayloadLengthOffset =
       kReadOnlySnapshotChecksumOffset + kUInt32Size;
-  static const uint32_t kChecksumOffset = kPayloadLengthOffset + kUInt32Size;
+  static const uint32_t kTieringHintsLengthOffset =
+      kPayloadLengthOffset + kUInt32Size;
+  static const uint32_t kChecksumOffset =
+      kTieringHintsLengthOffset + kUInt32Size;
   static const uint32_t kUnalignedHeaderSize = kChecksumOffset + kUInt32Size;
   static const uint32_t kHeaderSize = POINTER_SIZE_ALIGN(kUnalignedHeaderSize);
 
@@ -163,6 +175,8 @@ class SerializedCodeData : public SerializedData {
   AlignedCachedData* GetScriptData();
 
   base::Vector<const uint8_t> Payload() const;
+  // Tiering hints follow the payload, see CodeSerializer::kTieringHintSize.
+  base::Vector<const uint32_t> TieringHints() const;
 
   static uint32_t SourceHash(Handle<String> source,
                              ScriptOriginOptions origin_options);
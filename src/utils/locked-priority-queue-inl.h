@@ -0,0 +1,91 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_UTILS_LOCKED_PRIORITY_QUEUE_INL_H_
+#define V8_UTILS_LOCKED_PRIORITY_QUEUE_INL_H_
+
+#include <algorithm>
+
+#include "src/utils/locked-priority-queue.h"
+
+namespace v8 {
+namespace internal {
+
+template <typename Record>
+struct LockedPriorityQueue<Record>::Entry {
+  Record value;
+  int priority;
+  // Monotonically increasing enqueue counter, used to keep FIFO order among
+  // records of equal priority.
+  uint64_t sequence;
+  base::TimeTicks enqueue_time;
+};
+
+template <typename Record>
+struct LockedPriorityQueue<Record>::Compare {
+  // Returns true if |a| should be dequeued after |b|.
+  bool operator()(const Entry& a, const Entry& b) const {
+    if (a.priority != b.priority) return a.priority < b.priority;
+    return a.sequence > b.sequence;
+  }
+};
+
+template <typename Record>
+inline void LockedPriorityQueue<Record>::Enqueue(Record record, int priority) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::MutexGuard guard(&mutex_);
+  heap_.push_back(Entry{std::move(record), priority, next_sequence_++, now});
+  std::push_heap(heap_.begin(), heap_.end(), Compare());
+}
+
+template <typename Record>
+inline bool LockedPriorityQueue<Record>::Dequeue(Record* record,
+                                                 base::TimeDelta* queue_time) {
+  base::TimeTicks enqueue_time;
+  {
+    base::MutexGuard guard(&mutex_);
+    if (heap_.empty()) return false;
+    std::pop_heap(heap_.begin(), heap_.end(), Compare());
+    *record = std::move(heap_.back().value);
+    enqueue_time = heap_.back().enqueue_time;
+    heap_.pop_back();
+  }
+  if (queue_time) *queue_time = base::TimeTicks::Now() - enqueue_time;
+  return true;
+}
+
+template <typename Record>
+template <typename Predicate>
+inline bool LockedPriorityQueue<Record>::RaisePriority(Predicate predicate,
+                                                       int priority) {
+  base::MutexGuard guard(&mutex_);
+  bool found = false;
+  bool changed = false;
+  for (Entry& entry : heap_) {
+    if (!predicate(entry.value)) continue;
+    found = true;
+    if (entry.priority >= priority) continue;
+    entry.priority = priority;
+    changed = true;
+  }
+  if (changed) std::make_heap(heap_.begin(), heap_.end(), Compare());
+  return found;
+}
+
+template <typename Record>
+inline bool LockedPriorityQueue<Record>::IsEmpty() const {
+  base::MutexGuard guard(&mutex_);
+  return heap_.empty();
+}
+
+template <typename Record>
+inline size_t LockedPriorityQueue<Record>::size() const {
+  base::MutexGuard guard(&mutex_);
+  return heap_.size();
+}
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_UTILS_LOCKED_PRIORITY_QUEUE_INL_H_
@@ -0,0 +1,54 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_UTILS_LOCKED_PRIORITY_QUEUE_H_
+#define V8_UTILS_LOCKED_PRIORITY_QUEUE_H_
+
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/time.h"
+
+namespace v8 {
+namespace internal {
+
+// Simple lock-based unbounded size priority queue (multi producer; multi
+// consumer). Records with a higher priority are dequeued first; records with
+// equal priority are dequeued in FIFO order. The priority of a queued record
+// can be raised after the fact, e.g. when the work it represents becomes more
+// urgent while it is waiting.
+template <typename Record>
+class LockedPriorityQueue final {
+ public:
+  LockedPriorityQueue() = default;
+  LockedPriorityQueue(const LockedPriorityQueue&) = delete;
+  LockedPriorityQueue& operator=(const LockedPriorityQueue&) = delete;
+  ~LockedPriorityQueue() = default;
+
+  inline void Enqueue(Record record, int priority);
+  // Dequeues the record with the highest priority. If |queue_time| is not
+  // null, it receives the time the record spent in the queue.
+  inline bool Dequeue(Record* record, base::TimeDelta* queue_time = nullptr);
+  // Raises the priority of all queued records for which |predicate| returns
+  // true to |priority|. Records that already have a higher priority are left
+  // untouched. Returns whether any record matched.
+  template <typename Predicate>
+  inline bool RaisePriority(Predicate predicate, int priority);
+  inline bool IsEmpty() const;
+  inline size_t size() const;
+
+ private:
+  struct Entry;
+  struct Compare;
+
+  mutable base::Mutex mutex_;
+  // Binary max-heap ordered by |Compare|.
+  std::vector<Entry> heap_;
+  uint64_t next_sequence_ = 0;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_UTILS_LOCKED_PRIORITY_QUEUE_H_
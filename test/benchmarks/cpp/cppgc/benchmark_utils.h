@@ -20,13 +20,19 @@ class BenchmarkWithHeap : public benchmark::Fixture {
 
  protected:
   void SetUp(::benchmark::State& state) override {
-    heap_ = cppgc::Heap::Create(GetPlatform());
+    heap_ = cppgc::Heap::Create(GetPlatform(), GetHeapOptions());
   }
 
   void TearDown(::benchmark::State& state) override { heap_.reset(); }
 
   cppgc::Heap& heap() const { return *heap_.get(); }
 
+  // Options used to create the heap. Fixtures override this to e.g. register
+  // custom spaces.
+  virtual cppgc::Heap::HeapOptions GetHeapOptions() {
+    return cppgc::Heap::HeapOptions::Default();
+  }
+
  private:
   static std::shared_ptr<testing::TestPlatform> GetPlatform() {
     return platform_;
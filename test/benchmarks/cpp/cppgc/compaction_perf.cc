@@ -0,0 +1,148 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "include/cppgc/allocation.h"
+#include "include/cppgc/custom-space.h"
+#include "include/cppgc/garbage-collected.h"
+#include "include/cppgc/heap-statistics.h"
+#include "include/cppgc/persistent.h"
+#include "include/cppgc/testing.h"
+#include "include/cppgc/visitor.h"
+#include "src/base/macros.h"
+#include "src/heap/cppgc/globals.h"
+#include "src/heap/cppgc/heap.h"
+#include "test/benchmarks/cpp/cppgc/benchmark_utils.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace cppgc {
+namespace internal {
+namespace {
+
+class CompactableSpace : public CustomSpace<CompactableSpace> {
+ public:
+  static constexpr size_t kSpaceIndex = 0;
+  static constexpr bool kSupportsCompaction = true;
+};
+
+class Node final : public GarbageCollected<Node> {
+ public:
+  void Trace(Visitor* visitor) const {
+    VisitorBase::TraceRawForTesting(visitor, const_cast<const Node*>(next));
+    visitor->RegisterMovableReference(const_cast<const Node**>(&next));
+  }
+
+  Node* next = nullptr;
+  char payload[256];
+};
+
+class List final : public GarbageCollected<List> {
+ public:
+  void Trace(Visitor* visitor) const {
+    VisitorBase::TraceRawForTesting(visitor, const_cast<const Node*>(head));
+    visitor->RegisterMovableReference(const_cast<const Node**>(&head));
+  }
+
+  Node* head = nullptr;
+};
+
+}  // namespace
+}  // namespace internal
+
+template <>
+struct SpaceTrait<internal::Node> {
+  using Space = internal::CompactableSpace;
+};
+
+namespace internal {
+namespace {
+
+class Compaction : public testing::BenchmarkWithHeap {
+ protected:
+  cppgc::Heap::HeapOptions GetHeapOptions() override {
+    cppgc::Heap::HeapOptions options;
+    options.custom_spaces.emplace_back(std::make_unique<CompactableSpace>());
+    return options;
+  }
+
+  // Allocates |kNumNodes| nodes of which only every |survivor_interval|-th
+  // one stays reachable, which leaves the compactable space fragmented after
+  // the next garbage collection.
+  void Fragment(List* list, size_t survivor_interval) {
+    for (size_t i = 0; i < kNumNodes; ++i) {
+      Node* node = MakeGarbageCollected<Node>(heap().GetAllocationHandle());
+      if (i % survivor_interval) continue;
+      node->next = list->head;
+      list->head = node;
+    }
+  }
+
+  double Fragmentation() {
+    const HeapStatistics stats = Heap::From(&heap())->CollectStatistics(
+        HeapStatistics::DetailLevel::kBrief);
+    if (!stats.committed_size_bytes) return 0;
+    return 1.0 - static_cast<double>(stats.used_size_bytes) /
+                     stats.committed_size_bytes;
+  }
+
+  void CollectGarbage() {
+    heap().ForceGarbageCollectionSlow("Compaction", "benchmark",
+                                      cppgc::Heap::StackState::kNoHeapPointers);
+  }
+
+  // Measures the atomic pause of a garbage collection that finds a fragmented
+  // compactable space, with or without compaction.
+  void Run(benchmark::State& st, bool compact) {
+    const size_t survivor_interval = st.range(0);
+    Persistent<List> list =
+        MakeGarbageCollected<List>(heap().GetAllocationHandle());
+    cppgc::testing::StandaloneTestingHeap testing_heap(heap().GetHeapHandle());
+    double fragmentation_before = 0;
+    double fragmentation_after = 0;
+    for (auto _ : st) {
+      USE(_);
+      st.PauseTiming();
+      list->head = nullptr;
+      CollectGarbage();
+      Fragment(list.Get(), survivor_interval);
+      fragmentation_before += Fragmentation();
+      if (compact) testing_heap.ForceCompactionForNextGarbageCollection();
+      st.ResumeTiming();
+      CollectGarbage();
+      st.PauseTiming();
+      fragmentation_after += Fragmentation();
+      st.ResumeTiming();
+    }
+    st.counters["fragmentation_before"] = benchmark::Counter(
+        fragmentation_before, benchmark::Counter::kAvgIterations);
+    st.counters["fragmentation_after"] = benchmark::Counter(
+        fragmentation_after, benchmark::Counter::kAvgIterations);
+  }
+
+  static constexpr size_t kNumNodes = 64 * 1024;
+};
+
+BENCHMARK_DEFINE_F(Compaction, Disabled)(benchmark::State& st) {
+  Run(st, false);
+}
+
+BENCHMARK_DEFINE_F(Compaction, Enabled)(benchmark::State& st) {
+  Run(st, true);
+}
+
+BENCHMARK_REGISTER_F(Compaction, Disabled)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(16)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(Compaction, Enabled)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(16)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace internal
+}  // namespace cppgc
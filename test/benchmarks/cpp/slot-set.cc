@@ -0,0 +1,87 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares the iteration speed of atomic and non-atomic scanning of dense and
+// sparse slot sets, and measures the scavenger's OLD_TO_NEW iteration.
+
+#include <cstddef>
+#include <vector>
+
+#include "src/heap/base/basic-slot-set.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace {
+
+constexpr size_t kGranularity = sizeof(void*);
+using SlotSet = ::heap::base::BasicSlotSet<kGranularity>;
+constexpr size_t kPageSize = 1 << 17;
+constexpr size_t kBuckets = SlotSet::BucketsForSize(kPageSize);
+
+template <SlotSet::AccessMode access_mode>
+void BM_IterateSlotSet(benchmark::State& state) {
+  const size_t stride = static_cast<size_t>(state.range(0));
+  SlotSet* set = SlotSet::Allocate(kBuckets);
+  for (size_t i = 0; i < kPageSize; i += stride * kGranularity) {
+    set->Insert<SlotSet::AccessMode::ATOMIC>(i);
+  }
+  size_t slots = 0;
+  for (auto _ : state) {
+    slots += set->Iterate<access_mode>(
+        0, 0, kBuckets, [](uintptr_t) { return ::heap::base::KEEP_SLOT; },
+        SlotSet::KEEP_EMPTY_BUCKETS);
+  }
+  benchmark::DoNotOptimize(slots);
+  state.SetItemsProcessed(static_cast<int64_t>(slots));
+  SlotSet::Delete(set, kBuckets);
+}
+
+// Iterates like the scavenger's IterateAndTrackEmptyBuckets: atomically, and
+// recording the buckets without slots. Every other bucket was emptied by
+// earlier scavenges.
+class ScavengerSlotSet : public SlotSet {
+ public:
+  size_t IterateAndTrackEmptyBuckets(std::vector<bool>* empty_buckets) {
+    return SlotSet::Iterate<SlotSet::AccessMode::ATOMIC>(
+        0, 0, kBuckets, [](uintptr_t) { return ::heap::base::KEEP_SLOT; },
+        [empty_buckets](size_t bucket_index) {
+          (*empty_buckets)[bucket_index] = true;
+        });
+  }
+};
+
+void BM_ScavengeSlotSet(benchmark::State& state) {
+  const size_t stride = static_cast<size_t>(state.range(0));
+  SlotSet* set = SlotSet::Allocate(kBuckets);
+  for (size_t i = 0; i < kPageSize; i += stride * kGranularity) {
+    set->Insert<SlotSet::AccessMode::ATOMIC>(i);
+  }
+  constexpr size_t kBucketSize = SlotSet::kBitsPerBucket * kGranularity;
+  for (size_t i = 0; i < kPageSize; i += 2 * kBucketSize) {
+    set->RemoveRange(i, i + kBucketSize, kBuckets,
+                     SlotSet::KEEP_EMPTY_BUCKETS);
+  }
+  std::vector<bool> empty_buckets(kBuckets);
+  size_t slots = 0;
+  for (auto _ : state) {
+    slots += static_cast<ScavengerSlotSet*>(set)->IterateAndTrackEmptyBuckets(
+        &empty_buckets);
+  }
+  benchmark::DoNotOptimize(slots);
+  state.SetItemsProcessed(static_cast<int64_t>(slots));
+  SlotSet::Delete(set, kBuckets);
+}
+
+BENCHMARK_TEMPLATE(BM_IterateSlotSet, SlotSet::AccessMode::ATOMIC)
+    ->Arg(1)
+    ->Arg(7)
+    ->Arg(127)
+    ->Arg(4093);
+BENCHMARK_TEMPLATE(BM_IterateSlotSet, SlotSet::AccessMode::NON_ATOMIC)
+    ->Arg(1)
+    ->Arg(7)
+    ->Arg(127)
+    ->Arg(4093);
+BENCHMARK(BM_ScavengeSlotSet)->Arg(1)->Arg(7)->Arg(127)->Arg(4093);
+
+}  // namespace
@@ -0,0 +1,152 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how quickly the default platform dispatches tiny worker tasks, with
+// and without work stealing, as the number of worker threads grows.
+
+#include <atomic>
+#include <memory>
+
+#include "include/libplatform/libplatform.h"
+#include "include/v8-platform.h"
+#include "src/base/platform/semaphore.h"
+#include "src/base/platform/time.h"
+#include "src/base/sys-info.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace {
+
+using v8::platform::WorkerThreadScheduling;
+
+constexpr int kTasksPerIteration = 1000;
+
+std::unique_ptr<v8::Platform> NewPlatform(const benchmark::State& state) {
+  return v8::platform::NewDefaultPlatform(
+      static_cast<int>(state.range(1)),
+      v8::platform::IdleTaskSupport::kDisabled,
+      v8::platform::InProcessStackDumping::kDisabled, {},
+      v8::platform::PriorityMode::kDontApply,
+      static_cast<WorkerThreadScheduling>(state.range(0)));
+}
+
+// Counts down and signals the main thread when the last task has run.
+class CountdownTask final : public v8::Task {
+ public:
+  CountdownTask(std::atomic<int>* pending, v8::base::Semaphore* done)
+      : pending_(pending), done_(done) {}
+
+  void Run() override {
+    if (pending_->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      done_->Signal();
+    }
+  }
+
+ private:
+  std::atomic<int>* const pending_;
+  v8::base::Semaphore* const done_;
+};
+
+// Posts |count| CountdownTasks from a worker thread, where they can be
+// pushed to the worker's own queue.
+class FanOutTask final : public v8::Task {
+ public:
+  FanOutTask(v8::Platform* platform, int count, std::atomic<int>* pending,
+             v8::base::Semaphore* done)
+      : platform_(platform), count_(count), pending_(pending), done_(done) {}
+
+  void Run() override {
+    for (int i = 0; i < count_; i++) {
+      platform_->CallOnWorkerThread(
+          std::make_unique<CountdownTask>(pending_, done_));
+    }
+  }
+
+ private:
+  v8::Platform* const platform_;
+  const int count_;
+  std::atomic<int>* const pending_;
+  v8::base::Semaphore* const done_;
+};
+
+class SignalTask final : public v8::Task {
+ public:
+  explicit SignalTask(v8::base::Semaphore* done) : done_(done) {}
+
+  void Run() override { done_->Signal(); }
+
+ private:
+  v8::base::Semaphore* const done_;
+};
+
+void SetItemsProcessed(benchmark::State& state) {
+  state.SetItemsProcessed(state.iterations() * kTasksPerIteration);
+}
+
+}  // namespace
+
+// Tasks posted from the main thread.
+static void BM_PostTaskThroughput(benchmark::State& state) {
+  std::unique_ptr<v8::Platform> platform = NewPlatform(state);
+  v8::base::Semaphore done(0);
+  std::atomic<int> pending{0};
+  for (auto _ : state) {
+    pending.store(kTasksPerIteration, std::memory_order_relaxed);
+    for (int i = 0; i < kTasksPerIteration; i++) {
+      platform->CallOnWorkerThread(
+          std::make_unique<CountdownTask>(&pending, &done));
+    }
+    done.Wait();
+  }
+  SetItemsProcessed(state);
+}
+
+// Tasks posted from worker threads, e.g. job workers spawning more workers.
+static void BM_FanOutThroughput(benchmark::State& state) {
+  std::unique_ptr<v8::Platform> platform = NewPlatform(state);
+  const int fan_out_tasks = static_cast<int>(state.range(1));
+  v8::base::Semaphore done(0);
+  std::atomic<int> pending{0};
+  for (auto _ : state) {
+    pending.store(kTasksPerIteration, std::memory_order_relaxed);
+    int remaining = kTasksPerIteration;
+    for (int i = 0; i < fan_out_tasks; i++) {
+      int count = remaining / (fan_out_tasks - i);
+      remaining -= count;
+      platform->CallOnWorkerThread(std::make_unique<FanOutTask>(
+          platform.get(), count, &pending, &done));
+    }
+    done.Wait();
+  }
+  SetItemsProcessed(state);
+}
+
+// Time from posting a single task to it signaling the main thread.
+static void BM_PostTaskLatency(benchmark::State& state) {
+  std::unique_ptr<v8::Platform> platform = NewPlatform(state);
+  v8::base::Semaphore done(0);
+  for (auto _ : state) {
+    v8::base::TimeTicks start = v8::base::TimeTicks::Now();
+    platform->CallOnWorkerThread(std::make_unique<SignalTask>(&done));
+    done.Wait();
+    state.SetIterationTime((v8::base::TimeTicks::Now() - start).InSecondsF());
+  }
+}
+
+// Arguments are the scheduling mode and the number of worker threads.
+static void SchedulingAndThreads(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"work_stealing", "threads"});
+  const int num_processors = v8::base::SysInfo::NumberOfProcessors();
+  for (WorkerThreadScheduling scheduling :
+       {WorkerThreadScheduling::kSharedQueue,
+        WorkerThreadScheduling::kWorkStealing}) {
+    for (int threads = 1; threads < num_processors; threads *= 2) {
+      b->Args({static_cast<int>(scheduling), threads});
+    }
+    b->Args({static_cast<int>(scheduling), num_processors});
+  }
+}
+
+BENCHMARK(BM_PostTaskThroughput)->Apply(SchedulingAndThreads)->UseRealTime();
+BENCHMARK(BM_FanOutThroughput)->Apply(SchedulingAndThreads)->UseRealTime();
+BENCHMARK(BM_PostTaskLatency)->Apply(SchedulingAndThreads)->UseManualTime();
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "include/v8-pinned-contents-scope.h"
+#include "src/api/api-inl.h"
+#include "src/base/optional.h"
 #include "src/execution/isolate.h"
 #include "src/heap/factory.h"
 #include "src/heap/heap-inl.h"
@@ -428,6 +431,190 @@ HEAP_TEST(CompactionPartiallyAbortedPageWithRememberedSetEntries) {
   heap->RemoveNearHeapLimitCallback(reset_oom, 0u);
 }
 
+TEST(CompactionSkipsPagesWithPinnedObjects) {
+  if (!v8_flags.compact) return;
+  ManualGCScope manual_gc_scope;
+  heap::ManualEvacuationCandidatesSelectionScope
+      manual_evacuation_candidate_selection_scope(manual_gc_scope);
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Isolate* i_isolate = CcTest::i_isolate();
+  Heap* heap = i_isolate->heap();
+  // Compaction is only performed without stack.
+  DisableConservativeStackScanningScopeForTesting no_stack_scanning(heap);
+  v8::HandleScope scope(isolate);
+
+  const char kContents[] = "pinned contents";
+  Handle<String> string = i_isolate->factory()->NewStringFromAsciiChecked(
+      kContents, AllocationType::kOld);
+  Page* page = Page::FromHeapObject(*string);
+  {
+    v8::PinnedContentsScope pinned(isolate, v8::Utils::ToLocal(string));
+    CHECK(page->IsPinned());
+    CHECK(pinned.is_one_byte());
+    CHECK_EQ(strlen(kContents), pinned.byte_length());
+    const void* data = pinned.data();
+
+    heap::ForceEvacuationCandidate(page);
+    heap::InvokeMajorGC(heap);
+    CHECK_EQ(page, Page::FromHeapObject(*string));
+    CHECK_EQ(data, pinned.data());
+    CHECK_EQ(0, memcmp(data, kContents, strlen(kContents)));
+  }
+  CHECK(!page->IsPinned());
+
+  heap::ForceEvacuationCandidate(page);
+  heap::InvokeMajorGC(heap);
+  CHECK_NE(page, Page::FromHeapObject(*string));
+}
+
+TEST(PinnedYoungObjectsAreNotMoved) {
+  if (v8_flags.single_generation) return;
+  ManualGCScope manual_gc_scope;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Isolate* i_isolate = CcTest::i_isolate();
+  Heap* heap = i_isolate->heap();
+  DisableConservativeStackScanningScopeForTesting no_stack_scanning(heap);
+  v8::HandleScope scope(isolate);
+
+  Handle<String> string =
+      i_isolate->factory()->NewStringFromAsciiChecked("young contents");
+  CHECK(Heap::InYoungGeneration(*string));
+  const Address address = string->address();
+  {
+    v8::PinnedContentsScope pinned(isolate, v8::Utils::ToLocal(string));
+    CHECK(heap->HasPinnedYoungPages());
+    // The page of the string is promoted as a whole if the young generation
+    // collector would move it.
+    heap::InvokeMinorGC(heap);
+    CHECK_EQ(address, string->address());
+    heap::InvokeMajorGC(heap);
+    CHECK_EQ(address, string->address());
+    // The page has been promoted in place and is no longer young.
+    CHECK(!Heap::InYoungGeneration(*string));
+    CHECK(!heap->HasPinnedYoungPages());
+  }
+  CHECK(!heap->HasPinnedYoungPages());
+}
+
+TEST(PinnedStringsAreNotMadeThin) {
+  ManualGCScope manual_gc_scope;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Isolate* i_isolate = CcTest::i_isolate();
+  DisableConservativeStackScanningScopeForTesting no_stack_scanning(
+      i_isolate->heap());
+  v8::HandleScope scope(isolate);
+
+  const char kContents[] = "pinned string to be internalized";
+  Handle<String> string =
+      i_isolate->factory()->NewStringFromAsciiChecked(kContents);
+  CHECK(!IsInternalizedString(*string));
+  {
+    v8::PinnedContentsScope pinned(isolate, v8::Utils::ToLocal(string));
+    const void* data = pinned.data();
+    Handle<String> internalized =
+        i_isolate->factory()->InternalizeString(string);
+    CHECK(IsInternalizedString(*internalized));
+    CHECK(!IsThinString(*string));
+    CHECK_EQ(data, pinned.data());
+    CHECK_EQ(0, memcmp(data, kContents, strlen(kContents)));
+    heap::InvokeMajorGC(i_isolate->heap());
+    CHECK(!IsThinString(*string));
+    CHECK_EQ(0, memcmp(data, kContents, strlen(kContents)));
+  }
+}
+
+namespace {
+
+class StaticOneByteResource
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  explicit StaticOneByteResource(const char* data)
+      : data_(data), length_(strlen(data)) {}
+  const char* data() const override { return data_; }
+  size_t length() const override { return length_; }
+
+ private:
+  const char* data_;
+  size_t length_;
+};
+
+}  // namespace
+
+TEST(PinnedStringsAreNotExternalized) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Isolate* i_isolate = CcTest::i_isolate();
+  v8::HandleScope scope(isolate);
+
+  const char kContents[] = "pinned string that is long enough to externalize";
+  Handle<String> string = i_isolate->factory()->NewStringFromAsciiChecked(
+      kContents, AllocationType::kOld);
+  v8::Local<v8::String> local = v8::Utils::ToLocal(string);
+  CHECK(local->CanMakeExternal(v8::String::Encoding::ONE_BYTE_ENCODING));
+  {
+    v8::PinnedContentsScope pinned(isolate, local);
+    CHECK(!local->CanMakeExternal(v8::String::Encoding::ONE_BYTE_ENCODING));
+    auto resource = std::make_unique<StaticOneByteResource>(kContents);
+    CHECK(!local->MakeExternal(resource.get()));
+    CHECK(!IsExternalString(*string));
+    CHECK_EQ(0, memcmp(pinned.data(), kContents, strlen(kContents)));
+  }
+  CHECK(local->CanMakeExternal(v8::String::Encoding::ONE_BYTE_ENCODING));
+}
+
+TEST(PinnedOnHeapTypedArraysMoveOffHeap) {
+  if (v8_flags.typed_array_max_size_in_heap < 8) return;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+
+  v8::Local<v8::Uint8Array> view =
+      CompileRun("var array = new Uint8Array(8); array")
+          .As<v8::Uint8Array>();
+  CHECK(Utils::OpenDirectHandle(*view)->is_on_heap());
+  {
+    v8::PinnedContentsScope pinned(isolate, view);
+    CHECK(!Utils::OpenDirectHandle(*view)->is_on_heap());
+    CHECK_EQ(8u, pinned.byte_length());
+    // Accessing the buffer does not move the contents anymore, so writes
+    // stay visible through data().
+    CompileRun("array.buffer; array[0] = 42;");
+    CHECK_EQ(42, static_cast<const uint8_t*>(pinned.data())[0]);
+  }
+}
+
+TEST(PinnedViewsKeepTheirBuffersAlive) {
+  ManualGCScope manual_gc_scope;
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  Heap* heap = CcTest::heap();
+  DisableConservativeStackScanningScopeForTesting no_stack_scanning(heap);
+  v8::HandleScope scope(isolate);
+
+  v8::Global<v8::ArrayBuffer> buffer;
+  base::Optional<v8::PinnedContentsScope> pinned;
+  {
+    v8::HandleScope inner_scope(isolate);
+    v8::Local<v8::Uint8Array> view =
+        CompileRun("new Uint8Array(1024).fill(42)").As<v8::Uint8Array>();
+    buffer.Reset(isolate, view->Buffer());
+    buffer.SetWeak();
+    pinned.emplace(isolate, view);
+  }
+  // Only the scope refers to the view's buffer now.
+  heap::InvokeMajorGC(heap);
+  CHECK(!buffer.IsEmpty());
+  CHECK_EQ(1024u, pinned->byte_length());
+  CHECK_EQ(42, static_cast<const uint8_t*>(pinned->data())[1023]);
+
+  pinned.reset();
+  heap::InvokeMajorGC(heap);
+  CHECK(buffer.IsEmpty());
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
@@ -4,10 +4,13 @@
 
 #include <memory>
 
-#include "src/api/api.h"
+#include "src/api/api-inl.h"
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/semaphore.h"
+#include "src/base/strings.h"
+#include "src/base/vector.h"
+#include "src/baseline/baseline-batch-compiler.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/assembler.h"
 #include "src/codegen/macro-assembler-inl.h"
@@ -23,6 +26,7 @@
 #include "src/heap/heap.h"
 #include "src/heap/local-heap-inl.h"
 #include "src/heap/marking-state-inl.h"
+#include "src/heap/memory-chunk.h"
 #include "src/heap/parked-scope.h"
 #include "src/heap/safepoint.h"
 #include "src/objects/heap-number.h"
@@ -140,6 +144,53 @@ UNINITIALIZED_TEST(ConcurrentAllocationInOldSpaceFromMainThread) {
   isolate->Dispose();
 }
 
+UNINITIALIZED_TEST(ConcurrentAllocationFreeListCache) {
+  v8_flags.stress_concurrent_allocation = false;
+  v8_flags.concurrent_allocation_free_list_cache = true;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  Heap* heap = i_isolate->heap();
+
+  {
+    PtrComprCageAccessScope ptr_compr_cage_access_scope(i_isolate);
+    LocalHeap* local_heap = i_isolate->main_thread_local_heap();
+    {
+      IsolateSafepointScope safepoint_scope(heap);
+      heap->FreeLinearAllocationAreas();
+    }
+    const size_t size_before = heap->old_space()->Size();
+
+    const int kObjects = 100;
+    for (int i = 0; i < kObjects; i++) {
+      Address address = local_heap->AllocateRawOrFail(
+          kSmallObjectSize, AllocationType::kOld, AllocationOrigin::kRuntime,
+          AllocationAlignment::kTaggedAligned);
+      CreateFixedArray(heap, address, kSmallObjectSize);
+      address = local_heap->AllocateRawOrFail(
+          kMediumObjectSize, AllocationType::kOld, AllocationOrigin::kRuntime,
+          AllocationAlignment::kTaggedAligned);
+      CreateFixedArray(heap, address, kMediumObjectSize);
+    }
+
+    // Freeing the LABs gives all cached memory back to the space, which then
+    // only accounts for the objects.
+    {
+      IsolateSafepointScope safepoint_scope(heap);
+      heap->FreeLinearAllocationAreas();
+    }
+    CHECK_EQ(
+        size_t{0},
+        local_heap->old_space_allocator()->FreeListCacheSizeForTesting());
+    CHECK_EQ(size_before + kObjects * (kSmallObjectSize + kMediumObjectSize),
+             heap->old_space()->Size());
+    heap::InvokeAtomicMajorGC(heap);
+  }
+  isolate->Dispose();
+}
+
 UNINITIALIZED_TEST(ConcurrentAllocationWhileMainThreadIsParked) {
 #ifndef V8_ENABLE_CONSERVATIVE_STACK_SCANNING
   v8_flags.max_old_space_size = 4;
@@ -586,5 +637,80 @@ UNINITIALIZED_TEST(ConcurrentRecordRelocSlot) {
   isolate->Dispose();
 }
 
+#ifdef V8_ENABLE_SPARKPLUG
+UNINITIALIZED_TEST(ConcurrentSparkplugBatchInCodeSpace) {
+  v8_flags.sparkplug = true;
+  v8_flags.concurrent_sparkplug = true;
+  v8_flags.baseline_batch_compilation = true;
+  v8_flags.always_sparkplug = false;
+  v8_flags.stress_concurrent_allocation = false;
+  // The batch is only compiled once its last function is enqueued.
+  v8_flags.baseline_batch_compilation_threshold = kMaxInt;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+
+    constexpr int kFunctions = 6;
+    std::vector<Handle<JSFunction>> functions;
+    for (int i = 0; i < kFunctions; i++) {
+      base::ScopedVector<char> source(128);
+      base::SNPrintF(source,
+                     "function f%d(a) { return a + %d; }"
+                     "f%d(1);"
+                     "f%d;",
+                     i, i, i, i);
+      functions.push_back(Handle<JSFunction>::cast(
+          v8::Utils::OpenHandle(*CompileRun(source.begin()))));
+    }
+    baseline::BaselineBatchCompiler* compiler =
+        i_isolate->baseline_batch_compiler();
+    for (int i = 0; i < kFunctions; i++) {
+      if (i == kFunctions - 1) {
+        v8_flags.baseline_batch_compilation_threshold = 0;
+      }
+      compiler->EnqueueFunction(functions[i]);
+    }
+
+    // All functions are compiled in one batch on a background thread, which
+    // then requests the installation of its code.
+    auto all_installed = [&]() {
+      for (Handle<JSFunction> function : functions) {
+        if (!function->shared()->HasBaselineCode()) return false;
+      }
+      return true;
+    };
+    while (!all_installed()) {
+      if (i_isolate->stack_guard()->CheckInstallBaselineCode()) {
+        i_isolate->stack_guard()->HandleInterrupts();
+      } else {
+        base::OS::Sleep(base::TimeDelta::FromMilliseconds(1));
+      }
+    }
+    CHECK_EQ(1, compiler->install_steps_for_testing());
+
+    for (int i = 0; i < kFunctions; i++) {
+      Tagged<Code> code = functions[i]->shared()->baseline_code(kAcquireLoad);
+      CHECK_EQ(CodeKind::BASELINE, code->kind());
+      CHECK_EQ(CODE_SPACE,
+               MemoryChunk::FromHeapObject(code->instruction_stream())
+                   ->owner_identity());
+      base::ScopedVector<char> source(32);
+      base::SNPrintF(source, "f%d(1);", i);
+      CHECK_EQ(1 + i,
+               CompileRun(source.begin())->Int32Value(context).FromJust());
+    }
+  }
+  isolate->Dispose();
+}
+#endif  // V8_ENABLE_SPARKPLUG
+
 }  // namespace internal
 }  // namespace v8
@@ -2862,6 +2862,69 @@ TEST(OptimizedPretenuringMixedInObjectProperties) {
 }
 
 
+TEST(PretenuringFeedbackExportImport) {
+  v8_flags.allow_natives_syntax = true;
+  v8_flags.expose_gc = true;
+  v8_flags.compilation_cache = false;
+  v8_flags.allocation_site_lifetime_histograms = true;
+  CcTest::InitializeVM();
+  if (v8_flags.gc_global || v8_flags.stress_compaction ||
+      v8_flags.stress_incremental_marking || v8_flags.single_generation ||
+      !v8_flags.allocation_site_pretenuring) {
+    return;
+  }
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+
+  GrowNewSpaceToMaximumCapacity(CcTest::heap());
+
+  // The source must be identical in both runs, so only the argument of the
+  // trailing call differs.
+  const char* kScriptName = "pretenuring-feedback.js";
+  const char* kSource =
+      "var elements = [];"
+      "function f(n) {"
+      "  for (var i = 0; i < n; i++) {"
+      "    elements.push({a: []});"
+      "  }"
+      "};"
+      "%%PrepareFunctionForOptimization(f);"
+      "f(%d);";
+
+  base::ScopedVector<char> source(1024);
+  base::SNPrintF(source, kSource, kPretenureCreationCount);
+  CompileRunWithOrigin(source.begin(), kScriptName);
+  CompileRun("gc();");
+
+  std::string feedback = isolate->ExportPretenuringFeedback();
+  CHECK_EQ(0u, feedback.find("v8-pretenuring-feedback 1\n"));
+  CHECK_NE(std::string::npos, feedback.find(kScriptName));
+  CHECK(!isolate->ImportPretenuringFeedback("v8-pretenuring-feedback 1\nx"));
+  CHECK(isolate->ImportPretenuringFeedback(feedback));
+
+  // A fresh run of the script starts with the imported decision, before any
+  // garbage collection had a chance to find mementos.
+  LocalContext env;
+  base::SNPrintF(source, kSource, 2);
+  CompileRunWithOrigin(source.begin(), kScriptName);
+  i::Handle<JSFunction> f = i::Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*v8::Local<v8::Function>::Cast(
+          env->Global()->Get(env.local(), v8_str("f")).ToLocalChecked())));
+  Tagged<FeedbackVector> vector = f->feedback_vector();
+  int sites = 0;
+  for (int i = 0; i < vector->length(); ++i) {
+    Tagged<HeapObject> site;
+    if (!vector->Get(FeedbackSlot(i)).GetHeapObjectIfStrong(&site) ||
+        !IsAllocationSite(site)) {
+      continue;
+    }
+    CHECK_EQ(AllocationSite::kTenure,
+             AllocationSite::cast(site)->pretenure_decision());
+    sites++;
+  }
+  CHECK_EQ(1, sites);
+}
+
 TEST(OptimizedPretenuringDoubleArrayProperties) {
   v8_flags.allow_natives_syntax = true;
   v8_flags.expose_gc = true;
@@ -6151,6 +6214,12 @@ TEST(UncommitUnusedLargeObjectMemory) {
   size_t shrinked_size = RoundUp(
       (array->address() - chunk->address()) + array->Size(), CommitPageSize());
   CHECK_EQ(shrinked_size, chunk->CommittedPhysicalMemory());
+
+  // The tail of the page is released by the Unmapper.
+  heap->memory_allocator()->unmapper()->EnsureUnmappingCompleted();
+  CHECK_EQ(0, heap->memory_allocator()->unmapper()->NumberOfChunks());
+  CHECK_EQ(shrinked_size, chunk->CommittedPhysicalMemory());
+  CHECK_EQ(array->address() + array->Size(), chunk->area_end());
 }
 
 template <RememberedSetType direction>
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <limits>
+
 #include "src/base/utils/random-number-generator.h"
 #include "src/ic/accessor-assembler.h"
 #include "src/ic/stub-cache.h"
@@ -20,23 +22,27 @@ using compiler::Node;
 
 namespace {
 
-void TestStubCacheOffsetCalculation(StubCache::Table table) {
+void TestStubCacheOffsetCalculation(StubCache::Table table,
+                                    int primary_table_ways = 1) {
   Isolate* isolate(CcTest::InitIsolateOnce());
   const int kNumParams = 2;
   CodeAssemblerTester data(isolate, JSParameterCount(kNumParams));
   AccessorAssembler m(data.state());
+  StubCache local_stub_cache(isolate, StubCache::kDefaultPrimaryTableSize,
+                             primary_table_ways);
+  StubCache* stub_cache = &local_stub_cache;
 
   {
     auto name = m.Parameter<Name>(1);
     auto map = m.Parameter<Map>(2);
     TNode<IntPtrT> primary_offset =
-        m.StubCachePrimaryOffsetForTesting(name, map);
+        m.StubCachePrimaryOffsetForTesting(stub_cache, name, map);
     TNode<IntPtrT> result;
     if (table == StubCache::kPrimary) {
       result = primary_offset;
     } else {
       CHECK_EQ(StubCache::kSecondary, table);
-      result = m.StubCacheSecondaryOffsetForTesting(name, map);
+      result = m.StubCacheSecondaryOffsetForTesting(stub_cache, name, map);
     }
     m.Return(m.SmiTag(result));
   }
@@ -73,11 +79,11 @@ void TestStubCacheOffsetCalculation(StubCache::Table table) {
 
       int expected_result;
       {
-        int primary_offset = StubCache::PrimaryOffsetForTesting(*name, *map);
+        int primary_offset = stub_cache->PrimaryOffsetForTesting(*name, *map);
         if (table == StubCache::kPrimary) {
           expected_result = primary_offset;
         } else {
-          expected_result = StubCache::SecondaryOffsetForTesting(*name, *map);
+          expected_result = stub_cache->SecondaryOffsetForTesting(*name, *map);
         }
       }
       Handle<Object> result = ft.Call(name, map).ToHandleChecked();
@@ -98,6 +104,10 @@ TEST(StubCacheSecondaryOffset) {
   TestStubCacheOffsetCalculation(StubCache::kSecondary);
 }
 
+TEST(StubCachePrimaryOffsetFourWays) {
+  TestStubCacheOffsetCalculation(StubCache::kPrimary, 4);
+}
+
 namespace {
 
 Handle<Code> CreateCodeOfKind(CodeKind kind) {
@@ -108,17 +118,19 @@ Handle<Code> CreateCodeOfKind(CodeKind kind) {
   return data.GenerateCodeCloseAndEscape();
 }
 
-}  // namespace
-
-TEST(TryProbeStubCache) {
+void TestTryProbeStubCache(int primary_table_size,
+                           int primary_table_ways = 1) {
   using Label = CodeStubAssembler::Label;
   Isolate* isolate(CcTest::InitIsolateOnce());
   const int kNumParams = 3;
   CodeAssemblerTester data(isolate, JSParameterCount(kNumParams));
   AccessorAssembler m(data.state());
 
-  StubCache stub_cache(isolate);
+  StubCache stub_cache(isolate, primary_table_size, primary_table_ways);
   stub_cache.Clear();
+  CHECK_EQ(primary_table_ways, stub_cache.primary_table_ways());
+  const int kPrimaryTableSize = stub_cache.primary_table_size();
+  const int kSecondaryTableSize = stub_cache.secondary_table_size();
 
   {
     auto receiver = m.Parameter<Object>(1);
@@ -159,21 +171,21 @@ TEST(TryProbeStubCache) {
   Factory* factory = isolate->factory();
 
   // Generate some number of names.
-  for (int i = 0; i < StubCache::kPrimaryTableSize / 7; i++) {
+  for (int i = 0; i < kPrimaryTableSize / 7; i++) {
     Handle<Name> name;
     switch (rand_gen.NextInt(3)) {
       case 0: {
         // Generate string.
         std::stringstream ss;
         ss << "s" << std::hex
-           << (rand_gen.NextInt(Smi::kMaxValue) % StubCache::kPrimaryTableSize);
+           << (rand_gen.NextInt(Smi::kMaxValue) % kPrimaryTableSize);
         name = factory->InternalizeUtf8String(ss.str().c_str());
         break;
       }
       case 1: {
         // Generate number string.
         std::stringstream ss;
-        ss << (rand_gen.NextInt(Smi::kMaxValue) % StubCache::kPrimaryTableSize);
+        ss << (rand_gen.NextInt(Smi::kMaxValue) % kPrimaryTableSize);
         name = factory->InternalizeUtf8String(ss.str().c_str());
         break;
       }
@@ -189,7 +201,7 @@ TEST(TryProbeStubCache) {
   }
 
   // Generate some number of receiver maps and receivers.
-  for (int i = 0; i < StubCache::kSecondaryTableSize / 2; i++) {
+  for (int i = 0; i < kSecondaryTableSize / 2; i++) {
     Handle<Map> map = Map::Create(isolate, 0);
     receivers.push_back(factory->NewJSObjectFromMap(map));
   }
@@ -204,7 +216,7 @@ TEST(TryProbeStubCache) {
   DisallowGarbageCollection no_gc;
 
   // Populate {stub_cache}.
-  const int N = StubCache::kPrimaryTableSize + StubCache::kSecondaryTableSize;
+  const int N = kPrimaryTableSize + kSecondaryTableSize;
   for (int i = 0; i < N; i++) {
     int index = rand_gen.NextInt();
     Handle<Name> name = names[index % names.size()];
@@ -250,5 +262,100 @@ TEST(TryProbeStubCache) {
   CHECK(queried_existing && queried_non_existing);
 }
 
+}  // namespace
+
+TEST(TryProbeStubCache) {
+  TestTryProbeStubCache(StubCache::kDefaultPrimaryTableSize);
+}
+
+TEST(TryProbeStubCacheLargeTable) {
+  TestTryProbeStubCache(4 * StubCache::kDefaultPrimaryTableSize);
+}
+
+TEST(TryProbeStubCacheTwoWays) {
+  TestTryProbeStubCache(StubCache::kDefaultPrimaryTableSize, 2);
+}
+
+TEST(TryProbeStubCacheFourWays) {
+  TestTryProbeStubCache(StubCache::kDefaultPrimaryTableSize, 4);
+}
+
+TEST(StubCacheTableSize) {
+  Isolate* isolate(CcTest::InitIsolateOnce());
+  {
+    StubCache stub_cache(isolate, 0);
+    CHECK_EQ(StubCache::kDefaultPrimaryTableSize,
+             stub_cache.primary_table_size());
+    CHECK_EQ(StubCache::kDefaultSecondaryTableSize,
+             stub_cache.secondary_table_size());
+  }
+  {
+    StubCache stub_cache(isolate, 3000);
+    CHECK_EQ(4096, stub_cache.primary_table_size());
+    CHECK_EQ(1024, stub_cache.secondary_table_size());
+  }
+  {
+    StubCache stub_cache(isolate, 1);
+    CHECK_EQ(StubCache::kMinPrimaryTableSize,
+             stub_cache.primary_table_size());
+  }
+  {
+    StubCache stub_cache(isolate, std::numeric_limits<int>::max());
+    CHECK_EQ(StubCache::kMaxPrimaryTableSize,
+             stub_cache.primary_table_size());
+  }
+  {
+    StubCache stub_cache(isolate, 0, 3);
+    CHECK_EQ(4, stub_cache.primary_table_ways());
+  }
+  {
+    StubCache stub_cache(isolate, 0, 64);
+    CHECK_EQ(StubCache::kMaxPrimaryTableWays, stub_cache.primary_table_ways());
+  }
+}
+
+namespace {
+
+void TestStubCacheKeepsRecentEntriesOfSet(int primary_table_ways) {
+  Isolate* isolate(CcTest::InitIsolateOnce());
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+  StubCache stub_cache(isolate, StubCache::kDefaultPrimaryTableSize,
+                       primary_table_ways);
+  stub_cache.Clear();
+
+  Handle<Name> name = factory->InternalizeUtf8String("name");
+  Handle<Code> handler = CreateCodeOfKind(CodeKind::FOR_TESTING);
+  MaybeObject handler_object = MaybeObject::FromObject(*handler);
+
+  // Find maps whose (name, map) pairs all fall into the same primary set.
+  std::vector<Handle<Map>> maps;
+  int offset = -1;
+  while (static_cast<int>(maps.size()) < primary_table_ways + 1) {
+    Handle<Map> map = Map::Create(isolate, 0);
+    int map_offset = stub_cache.PrimaryOffsetForTesting(*name, *map);
+    if (offset == -1) offset = map_offset;
+    if (map_offset == offset) maps.push_back(map);
+  }
+
+  DisallowGarbageCollection no_gc;
+  for (Handle<Map> map : maps) {
+    stub_cache.Set(*name, *map, handler_object);
+  }
+  // All but the oldest entry are still in the primary set, and the oldest
+  // entry was moved to the secondary table.
+  for (Handle<Map> map : maps) {
+    CHECK(handler_object == stub_cache.Get(*name, *map));
+  }
+}
+
+}  // namespace
+
+TEST(StubCacheKeepsRecentEntriesOfSet) {
+  TestStubCacheKeepsRecentEntriesOfSet(1);
+  TestStubCacheKeepsRecentEntriesOfSet(2);
+  TestStubCacheKeepsRecentEntriesOfSet(4);
+}
+
 }  // namespace internal
 }  // namespace v8
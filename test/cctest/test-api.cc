@@ -30046,3 +30046,101 @@ TEST(DeepFreezeInstantiatesAccessors2) {
   v8::Maybe<void> maybe_success = context->DeepFreeze(nullptr);
   CHECK(!maybe_success.IsNothing());
 }
+
+TEST(OptimizedCodeBudget) {
+  if (!i::v8_flags.turbofan || i::v8_flags.always_turbofan) return;
+  i::v8_flags.allow_natives_syntax = true;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  // Any optimized function exceeds a one byte budget, so optimizing g has to
+  // tier down f, but never g itself.
+  isolate->SetOptimizedCodeBudget(1);
+  v8::Local<v8::Value> f = CompileRun(
+      "function f(x) { return x + 1; }"
+      "%PrepareFunctionForOptimization(f);"
+      "f(1);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f(1);"
+      "f;");
+  i::Handle<i::JSFunction> i_f =
+      i::Handle<i::JSFunction>::cast(v8::Utils::OpenHandle(*f));
+  CHECK(i_f->HasAttachedOptimizedCode());
+
+  v8::Local<v8::Value> g = CompileRun(
+      "function g(x) { return x * 2; }"
+      "%PrepareFunctionForOptimization(g);"
+      "g(1);"
+      "%OptimizeFunctionOnNextCall(g);"
+      "g(1);"
+      "g;");
+  i::Handle<i::JSFunction> i_g =
+      i::Handle<i::JSFunction>::cast(v8::Utils::OpenHandle(*g));
+  CHECK(i_g->HasAttachedOptimizedCode());
+  CHECK(!i_f->HasAttachedOptimizedCode());
+
+  // Without a budget, optimized code stays installed.
+  isolate->SetOptimizedCodeBudget(0);
+  CompileRun(
+      "%PrepareFunctionForOptimization(f);"
+      "f(1);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f(1);");
+  CHECK(i_f->HasAttachedOptimizedCode());
+  CHECK(i_g->HasAttachedOptimizedCode());
+}
+
+TEST(OptimizedCodeBudgetKeepsRunningCode) {
+  if (!i::v8_flags.turbofan || i::v8_flags.always_turbofan) return;
+  i::v8_flags.allow_natives_syntax = true;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  // Account for all optimized code until the sizes are known.
+  isolate->SetOptimizedCodeBudget(i::MB);
+  CompileRun(
+      "var pending = null;"
+      "function optimize(f) {"
+      "  %PrepareFunctionForOptimization(f);"
+      "  f(1);"
+      "  %OptimizeFunctionOnNextCall(f);"
+      "  f(1);"
+      "}"
+      "function step(x) {"
+      "  if (pending) {"
+      "    const f = pending;"
+      "    pending = null;"
+      "    optimize(f);"
+      "  }"
+      "  return x;"
+      "}"
+      "%NeverOptimizeFunction(optimize);"
+      "%NeverOptimizeFunction(step);"
+      "function hot(x) { return step(x) + 1; }"
+      "function cold(x) { return x + 1; }"
+      "function other(x) { return x + 1; }"
+      "optimize(hot);"
+      "optimize(cold);");
+  auto get = [&](const char* name) {
+    return i::Handle<i::JSFunction>::cast(
+        v8::Utils::OpenHandle(*CompileRun(name)));
+  };
+  i::Handle<i::JSFunction> hot = get("hot");
+  i::Handle<i::JSFunction> cold = get("cold");
+  i::Handle<i::JSFunction> other = get("other");
+  CHECK(hot->HasAttachedOptimizedCode());
+  CHECK(cold->HasAttachedOptimizedCode());
+
+  // There is room for hot and one of cold and other, which are identical.
+  // Optimizing other while hot is running has to tier down one function.
+  // Hot was installed first, but it is in use, so cold goes.
+  const size_t cold_size = cold->code()->SizeIncludingMetadata();
+  isolate->SetOptimizedCodeBudget(hot->code()->SizeIncludingMetadata() +
+                                  cold_size + cold_size / 2);
+  CompileRun("pending = other; hot(1);");
+  CHECK(hot->HasAttachedOptimizedCode());
+  CHECK(other->HasAttachedOptimizedCode());
+  CHECK(!cold->HasAttachedOptimizedCode());
+}
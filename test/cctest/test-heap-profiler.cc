@@ -30,6 +30,8 @@
 #include <ctype.h>
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include "include/v8-function.h"
 #include "include/v8-json.h"
@@ -1195,6 +1197,188 @@ TEST(HeapSnapshotJSONSerializationAborting) {
 
 namespace {
 
+// Reads a snapshot written in the binary format, see
+// v8::HeapSnapshot::Serialize().
+struct BinarySnapshot {
+  struct Node {
+    uint64_t type;
+    std::string name;
+    uint64_t id;
+  };
+  struct Edge {
+    uint64_t type;
+    std::string name;
+    uint64_t from;
+    uint64_t to;
+  };
+
+  explicit BinarySnapshot(Vector<char> data) {
+    CHECK_EQ(0, strncmp(data.begin(), "V8HS", 4));
+    size_t pos = 4;
+    auto read_varint = [&data, &pos]() {
+      uint64_t result = 0;
+      for (int shift = 0;; shift += 7) {
+        CHECK_LT(pos, data.size());
+        const uint8_t b = static_cast<uint8_t>(data[pos++]);
+        result |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return result;
+      }
+    };
+    CHECK_EQ(1u, read_varint());
+    std::unordered_map<uint64_t, std::string> strings;
+    while (true) {
+      CHECK_LT(pos, data.size());
+      switch (data[pos++]) {
+        case 0: {
+          CHECK_EQ(nodes.size(), read_varint());
+          CHECK_EQ(edges.size(), read_varint());
+          CHECK_EQ(data.size(), pos);
+          return;
+        }
+        case 1: {
+          const uint64_t id = read_varint();
+          const uint64_t length = read_varint();
+          CHECK_LE(pos + length, data.size());
+          CHECK(strings.emplace(id, std::string(&data[pos], length)).second);
+          pos += length;
+          break;
+        }
+        case 2: {
+          Node node;
+          node.type = read_varint();
+          node.name = strings.at(read_varint());
+          node.id = read_varint();
+          read_varint();  // self_size
+          read_varint();  // trace_node_id
+          read_varint();  // detachedness
+          nodes_by_id.emplace(node.id, nodes.size());
+          nodes.push_back(node);
+          break;
+        }
+        case 3: {
+          Edge edge;
+          edge.type = read_varint();
+          const uint64_t name_or_index = read_varint();
+          if (edge.type != v8::HeapGraphEdge::kElement &&
+              edge.type != v8::HeapGraphEdge::kHidden) {
+            edge.name = strings.at(name_or_index);
+          }
+          edge.from = read_varint();
+          edge.to = read_varint();
+          edges.push_back(edge);
+          break;
+        }
+        case 4: {
+          for (int i = 0; i < 4; ++i) read_varint();
+          break;
+        }
+        default:
+          UNREACHABLE();
+      }
+    }
+  }
+
+  const Node& GetNode(uint64_t id) const { return nodes[nodes_by_id.at(id)]; }
+
+  // Returns the target of the first property edge called |name| from a node
+  // called |from_name|, or nullptr.
+  const Node* FindProperty(const char* from_name, const char* name) const {
+    for (const Edge& edge : edges) {
+      if (edge.type == v8::HeapGraphEdge::kProperty && edge.name == name &&
+          GetNode(edge.from).name == from_name) {
+        return &GetNode(edge.to);
+      }
+    }
+    return nullptr;
+  }
+
+  std::vector<Node> nodes;
+  std::vector<Edge> edges;
+  std::unordered_map<uint64_t, size_t> nodes_by_id;
+};
+
+}  // namespace
+
+TEST(HeapSnapshotBinarySerialization) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "function B(x) { this.x = x; }\n"
+      "var a = new A('String \\u0101');\n"
+      "var b = new B(a);");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  v8::internal::TestJSONStream stream;
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kBinary);
+  CHECK_EQ(1, stream.eos_signaled());
+  v8::base::ScopedVector<char> data(stream.size());
+  stream.WriteTo(data);
+  BinarySnapshot parsed(data);
+
+  CHECK_EQ(static_cast<size_t>(snapshot->GetNodesCount()),
+           parsed.nodes.size());
+  size_t edge_count = 0;
+  for (int i = 0; i < snapshot->GetNodesCount(); ++i) {
+    const v8::HeapGraphNode* node = snapshot->GetNode(i);
+    CHECK_EQ(node->GetId(), parsed.nodes[i].id);
+    edge_count += node->GetChildrenCount();
+  }
+  CHECK_EQ(edge_count, parsed.edges.size());
+  for (const BinarySnapshot::Edge& edge : parsed.edges) {
+    parsed.GetNode(edge.from);
+    parsed.GetNode(edge.to);
+  }
+  const BinarySnapshot::Node* a = parsed.FindProperty("B", "x");
+  CHECK_NOT_NULL(a);
+  CHECK(a->name == "A");
+  const BinarySnapshot::Node* s = parsed.FindProperty("A", "s");
+  CHECK_NOT_NULL(s);
+  // Strings are written as UTF-8.
+  CHECK(s->name == "String \xC4\x81");
+}
+
+TEST(HeapSnapshotStreaming) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun(
+      "function A() {}\n"
+      "function B(x) { this.x = x; }\n"
+      "var b = new B(new A());");
+
+  v8::internal::TestJSONStream stream;
+  CHECK(heap_profiler->StreamHeapSnapshot(&stream));
+  CHECK_EQ(1, stream.eos_signaled());
+  CHECK_EQ(0, heap_profiler->GetSnapshotCount());
+  v8::base::ScopedVector<char> data(stream.size());
+  stream.WriteTo(data);
+  BinarySnapshot parsed(data);
+
+  for (const BinarySnapshot::Edge& edge : parsed.edges) {
+    parsed.GetNode(edge.from);
+    parsed.GetNode(edge.to);
+  }
+  const BinarySnapshot::Node* a = parsed.FindProperty("B", "x");
+  CHECK_NOT_NULL(a);
+  CHECK(a->name == "A");
+}
+
+TEST(HeapSnapshotStreamingAborting) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  v8::internal::TestJSONStream stream(5);
+  CHECK(!heap_profiler->StreamHeapSnapshot(&stream));
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(0, stream.eos_signaled());
+  CHECK_EQ(0, heap_profiler->GetSnapshotCount());
+}
+
+namespace {
+
 class TestStatsStream : public v8::OutputStream {
  public:
   TestStatsStream()
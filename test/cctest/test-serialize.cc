@@ -2771,6 +2771,120 @@ TEST(CodeSerializerAfterExecute) {
   v8_flags.always_turbofan = prev_always_turbofan_value;
 }
 
+TEST(JitProfileWarmStart) {
+  v8_flags.allow_natives_syntax = true;
+  CcTest::InitializeVM();
+  if (!CcTest::i_isolate()->use_optimizer() || v8_flags.always_turbofan ||
+      !v8_flags.lazy_feedback_allocation ||
+      v8_flags.invocation_count_for_profiled_tierup >=
+          std::min(v8_flags.invocation_count_for_maglev,
+                   v8_flags.invocation_count_for_turbofan)) {
+    return;
+  }
+  const char* js_source = "function f(x) { return x + 1; }";
+  std::string profile;
+  {
+    v8::HandleScope scope(CcTest::isolate());
+    CompileRun(js_source);
+    CompileRun(
+        "%PrepareFunctionForOptimization(f); f(1); f(2);"
+        "%OptimizeFunctionOnNextCall(f); f(3);");
+    profile = CcTest::isolate()->ExportJitProfile();
+  }
+  CHECK_EQ(0u, profile.find("v8-jit-profile 1\n"));
+  CHECK_NE(std::string::npos, profile.find("\nTURBOFAN "));
+  CHECK(!CcTest::isolate()->ImportJitProfile("v8-jit-profile 1\nTURBOFAN"));
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  Isolate* i_isolate2 = reinterpret_cast<Isolate*>(isolate2);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    CHECK(isolate2->ImportJitProfile(profile));
+    CompileRun(js_source);
+    // Run f just long enough to allocate its feedback vector.
+    CompileRun("for (var i = 0; i < 20; i++) f(i);");
+    Handle<JSFunction> f =
+        Handle<JSFunction>::cast(v8::Utils::OpenHandle(*CompileRun("f")));
+    CHECK(f->has_feedback_vector());
+    const int bytecode_length =
+        f->shared()->GetBytecodeArray(i_isolate2)->length();
+    CHECK_LE(f->raw_feedback_cell()->interrupt_budget(),
+             v8_flags.invocation_count_for_profiled_tierup * bytecode_length);
+  }
+  isolate2->Dispose();
+}
+
+TEST(CodeSerializerTieringHints) {
+  v8_flags.allow_natives_syntax = true;
+  v8_flags.code_cache_tiering_hints = true;
+  CcTest::InitializeVM();
+  if (!CcTest::i_isolate()->use_optimizer() || v8_flags.always_turbofan ||
+      !v8_flags.lazy_feedback_allocation ||
+      v8_flags.invocation_count_for_profiled_tierup >=
+          std::min(v8_flags.invocation_count_for_maglev,
+                   v8_flags.invocation_count_for_turbofan)) {
+    return;
+  }
+  const char* js_source = "function f(x) { return x + 1; }";
+  v8::ScriptCompiler::CachedData* cache;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptOrigin origin(isolate1, v8_str("test"));
+    v8::ScriptCompiler::Source source(v8_str(js_source), origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate1, &source)
+            .ToLocalChecked();
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CompileRun(
+        "%PrepareFunctionForOptimization(f); f(1); f(2);"
+        "%OptimizeFunctionOnNextCall(f); f(3);");
+    cache = ScriptCompiler::CreateCodeCache(script);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  Isolate* i_isolate2 = reinterpret_cast<Isolate*>(isolate2);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptOrigin origin(isolate2, v8_str("test"));
+    v8::ScriptCompiler::Source source(v8_str(js_source), origin, cache);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(!cache->rejected);
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+
+    // Run f just long enough to allocate its feedback vector.
+    CompileRun("for (var i = 0; i < 20; i++) f(i);");
+    Handle<JSFunction> f =
+        Handle<JSFunction>::cast(v8::Utils::OpenHandle(*CompileRun("f")));
+    CHECK(f->has_feedback_vector());
+    const int bytecode_length =
+        f->shared()->GetBytecodeArray(i_isolate2)->length();
+    CHECK_LE(f->raw_feedback_cell()->interrupt_budget(),
+             v8_flags.invocation_count_for_profiled_tierup * bytecode_length);
+  }
+  isolate2->Dispose();
+}
+
 TEST(CodeSerializerFlagChange) {
   const char* js_source = "function f() { return 'abc'; }; f() + 'def'";
   v8::ScriptCompiler::CachedData* cache = CompileRunAndProduceCache(js_source);
@@ -0,0 +1,62 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The reported score is 100 * reference / (microseconds per run), so using a
+// hundredth of the document length as the reference makes the score the parse
+// throughput in MB/s (in millions of characters per second for TwoByte).
+
+function MakeRecord(i, text) {
+  return {
+    id: i,
+    guid: "7c1e" + i.toString(16).padStart(8, "0") + "-4b2a-9f3d-a1b2c3d4e5f6",
+    active: (i % 3) == 0,
+    balance: i * 13.37,
+    name: "User " + i,
+    email: "user" + i + "@example.com",
+    about: text,
+    tags: ["alpha", "beta", "gamma", "delta"].slice(i % 4),
+    location: { latitude: -12.5 + i / 1000, longitude: 48.25 - i / 1000 },
+  };
+}
+
+function MakeDocument(count, text, indent) {
+  const records = [];
+  for (let i = 0; i < count; i++) records.push(MakeRecord(i, text));
+  return JSON.stringify(records, null, indent);
+}
+
+const kShortText = "Lorem ipsum dolor sit amet.";
+const kLongText =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod " +
+    "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim " +
+    "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea " +
+    "commodo consequat. \"Duis\" aute irure dolor in reprehenderit.\n";
+
+const documents = {
+  Records: MakeDocument(20000, kShortText, undefined),
+  LongStrings: MakeDocument(5000, kLongText.repeat(8), undefined),
+  PrettyPrinted: MakeDocument(20000, kShortText, 2),
+  TwoByte: MakeDocument(5000, kLongText.repeat(8) + "\u2603", undefined),
+};
+
+let source;
+let result;
+
+function CreateParseSuite(name) {
+  const document = documents[name];
+  %FlattenString(document);
+  new BenchmarkSuite(name, [document.length / 100], [
+    new Benchmark(name, false, false, 0, Parse, () => { source = document; },
+                  () => { result = undefined; })
+  ]);
+}
+
+function Parse() {
+  result = JSON.parse(source);
+}
+
+CreateParseSuite("Records");
+CreateParseSuite("LongStrings");
+CreateParseSuite("PrettyPrinted");
+CreateParseSuite("TwoByte");
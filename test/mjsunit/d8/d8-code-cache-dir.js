@@ -0,0 +1,72 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --enable-os-system
+
+// Tests d8's --code-cache-dir across several d8 processes: a miss writes an
+// entry, a hit consumes it, and a rejected entry is removed and rewritten.
+// The cached script uses dynamic import(), which depends on the host-defined
+// options that d8 has to restore for scripts from the cache.
+
+if (this.os && os.system && os.name != 'windows') {
+  const dir = '/tmp/d8-code-cache-dir-' + Date.now() + '-' +
+      ((Math.random() * (1 << 30)) | 0);
+  os.mkdirp(dir);
+  try {
+    const script = dir + '/script.js';
+    writeFile(dir + '/module.mjs', 'export const value = 42;\n');
+    writeFile(
+        script,
+        'import("./module.mjs").then(\n' +
+            '    m => print("imported " + m.value),\n' +
+            '    e => print("import failed: " + e));\n');
+
+    function run() {
+      return os.system(
+          os.d8Path,
+          ['--code-cache-dir=' + dir, '--profile-deserialization', script]);
+    }
+
+    function entries() {
+      return os.system('ls', [dir])
+          .split('\n')
+          .filter(name => name.endsWith('.v8cache'));
+    }
+
+    // Miss: the script is compiled from source and an entry is written.
+    let output = run();
+    assertTrue(output.includes('imported 42'), output);
+    assertFalse(output.includes('[Deserializing from'), output);
+    assertTrue(output.includes('[Serializing to'), output);
+    assertEquals(1, entries().length);
+    const entry = dir + '/' + entries()[0];
+
+    // Hit: the entry is consumed, import() still works, and nothing is
+    // written.
+    output = run();
+    assertTrue(output.includes('imported 42'), output);
+    assertTrue(output.includes('[Deserializing from'), output);
+    assertFalse(output.includes('[Serializing to'), output);
+
+    // Rejected: corrupt the serialized data after d8's own entry header, so
+    // that d8 maps the entry but V8 rejects it. d8 removes the entry and
+    // writes a fresh one.
+    const bytes = new Uint8Array(readbuffer(entry));
+    const kEntryHeaderSize = 24;
+    for (let i = 0; i < 4; i++) bytes[kEntryHeaderSize + i] ^= 0xff;
+    writeFile(entry, bytes);
+    output = run();
+    assertTrue(output.includes('imported 42'), output);
+    assertTrue(output.includes('[Cached code failed check'), output);
+    assertTrue(output.includes('[Serializing to'), output);
+    assertEquals(1, entries().length);
+
+    // The rewritten entry is consumed again.
+    output = run();
+    assertTrue(output.includes('imported 42'), output);
+    assertTrue(output.includes('[Deserializing from'), output);
+  } finally {
+    os.system('rm', ['-r', dir]);
+  }
+}
@@ -0,0 +1,52 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Strings and whitespace runs are scanned a block of characters at a time.
+// Place quotes, escapes, control and non-Latin1 characters at every offset
+// around the block boundaries.
+
+function Check(prefix_length, special) {
+  const prefix = "a".repeat(prefix_length);
+  const suffix = "b".repeat(40);
+  const value = prefix + special + suffix;
+  const json = JSON.stringify(value);
+  assertEquals(value, JSON.parse(json));
+  const whitespace = " ".repeat(prefix_length);
+  assertEquals([value, 1], JSON.parse("[" + json + "," + whitespace + "1]"));
+  assertEquals({[value]: value}, JSON.parse("{" + json + ":" + json + "}"));
+}
+
+for (let i = 0; i < 70; i++) {
+  Check(i, "");
+  Check(i, "\"");
+  Check(i, "\\");
+  Check(i, "\n");
+  Check(i, "\x01");
+  Check(i, "\x1f");
+  Check(i, "\x7f");
+  Check(i, "\xff");
+  Check(i, "Ā");
+  Check(i, "☃");
+  Check(i, "€\"");
+}
+
+// Raw control characters are illegal inside of JSON strings, wherever they
+// appear.
+for (let i = 0; i < 70; i++) {
+  const prefix = "a".repeat(i);
+  const suffix = "c".repeat(40);
+  assertThrows(() => JSON.parse("\"" + prefix + "\x01" + suffix + "\""),
+               SyntaxError);
+  assertThrows(() => JSON.parse("\"" + prefix + "☃\x1f" + suffix + "\""),
+               SyntaxError);
+  assertThrows(() => JSON.parse("\"" + prefix + suffix), SyntaxError);
+}
+
+// Two-byte sources whose strings only contain Latin1 characters.
+for (let i = 0; i < 70; i++) {
+  const value = "\xe9".repeat(i);
+  const parsed = JSON.parse("[\"" + value + "\", \"☃\"]");
+  assertEquals(value, parsed[0]);
+  assertEquals("☃", parsed[1]);
+}
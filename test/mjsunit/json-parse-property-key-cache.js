@@ -0,0 +1,81 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Objects with the same keys get the same map, even if they are not siblings
+// in an array.
+{
+  const result = JSON.parse(
+      '{"x": {"a": 1, "b": "s"}, "y": [{"c": 1}, {"a": 2, "b": "t"}],' +
+      ' "z": {"n": {"a": 3, "b": "u"}}}');
+  assertEquals({a: 1, b: 's'}, result.x);
+  assertEquals({a: 2, b: 't'}, result.y[1]);
+  assertEquals({a: 3, b: 'u'}, result.z.n);
+  assertTrue(%HaveSameMap(result.x, result.y[1]));
+  assertTrue(%HaveSameMap(result.x, result.z.n));
+  assertFalse(%HaveSameMap(result.x, result.y[0]));
+}
+
+// Keys are compared by their spelling in the source, so different spellings
+// of the same key don't hit, but still get the same map through the
+// transition tree.
+{
+  const result =
+      JSON.parse('[[{"ab": 1, "c": 2}], [{"a\\u0062": 3, "c": 4}], ' +
+                 '[{"ab": 5, "\\u0063": 6}], [{"ab": 7, "cd": 8}]]');
+  assertEquals({ab: 1, c: 2}, result[0][0]);
+  assertEquals({ab: 3, c: 4}, result[1][0]);
+  assertEquals({ab: 5, c: 6}, result[2][0]);
+  assertEquals({ab: 7, cd: 8}, result[3][0]);
+  assertTrue(%HaveSameMap(result[0][0], result[1][0]));
+  assertTrue(%HaveSameMap(result[0][0], result[2][0]));
+  assertFalse(%HaveSameMap(result[0][0], result[3][0]));
+}
+
+// Prefixes and extensions of cached keys.
+{
+  const result = JSON.parse(
+      '[[{"a": 1, "b": 2}], [{"a": 3}], [{"a": 4, "b": 5, "c": 6}],' +
+      ' [{"a": 7, "b": 8}], [{"b": 9, "a": 10}]]');
+  assertEquals({a: 1, b: 2}, result[0][0]);
+  assertEquals({a: 3}, result[1][0]);
+  assertEquals({a: 4, b: 5, c: 6}, result[2][0]);
+  assertEquals({a: 7, b: 8}, result[3][0]);
+  assertEquals(['b', 'a'], Object.keys(result[4][0]));
+  assertTrue(%HaveSameMap(result[0][0], result[3][0]));
+  assertFalse(%HaveSameMap(result[0][0], result[4][0]));
+}
+
+// Values that don't fit the representation of the cached map's fields.
+{
+  const result = JSON.parse(
+      '[[{"p": 1, "q": 2}], [{"p": 1.5, "q": "x"}], [{"p": {}, "q": null}],' +
+      ' [{"p": 3, "q": 4}]]');
+  assertEquals({p: 1, q: 2}, result[0][0]);
+  assertEquals({p: 1.5, q: 'x'}, result[1][0]);
+  assertEquals({p: {}, q: null}, result[2][0]);
+  assertEquals({p: 3, q: 4}, result[3][0]);
+  assertTrue(%HaveSameMap(result[2][0], result[3][0]));
+}
+
+// Objects with elements and objects with duplicate keys.
+{
+  const result = JSON.parse(
+      '[[{"a": 1, "0": 2}], [{"a": 3}], [{"a": 4, "a": 5}], [{"a": 6}]]');
+  assertEquals({a: 1, 0: 2}, result[0][0]);
+  assertEquals({a: 3}, result[1][0]);
+  assertEquals({a: 5}, result[2][0]);
+  assertEquals({a: 6}, result[3][0]);
+  assertTrue(%HaveSameMap(result[1][0], result[3][0]));
+}
+
+// Two-byte sources.
+{
+  const result = JSON.parse(
+      '[[{"\u2603": 1, "b": 2}], [{"c": 3}], [{"\u2603": 4, "b": 5}]]');
+  assertEquals(4, result[2][0]['\u2603']);
+  assertEquals(5, result[2][0].b);
+  assertTrue(%HaveSameMap(result[0][0], result[2][0]));
+}
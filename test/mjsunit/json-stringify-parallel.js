@@ -0,0 +1,109 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --parallel-json-stringify --parallel-json-stringify-min-length=16
+
+// Serializes the elements one by one, which never takes the parallel path.
+function Expected(array) {
+  return '[' + array.map(e => JSON.stringify(e) ?? 'null').join(',') + ']';
+}
+
+function Check(array) {
+  assertEquals(Expected(array), JSON.stringify(array));
+}
+
+function MakeRecords(length) {
+  const result = [];
+  for (let i = 0; i < length; i++) {
+    result.push({
+      id: i,
+      name: 'item "' + i + '"\n',
+      score: i / 7,
+      tags: ['a', 'b\\', i],
+      values: [i, i + 0.5, -0],
+      active: i % 2 == 0,
+      missing: undefined,
+      nested: {x: null, f() {}, s: Symbol()}
+    });
+  }
+  return result;
+}
+
+// Plain data, spread over several chunks.
+Check(MakeRecords(5000));
+
+// Elements that are skipped or written as null.
+{
+  const array = MakeRecords(3000);
+  array[17] = undefined;
+  array[1500] = () => 1;
+  array[2999] = Symbol('s');
+  array[100] = NaN;
+  array[101] = Infinity;
+  Check(array);
+}
+
+// Elements that need the main thread, in the middle of chunks and at chunk
+// boundaries.
+for (const index of [0, 1, 511, 512, 513, 1024, 2999]) {
+  const array = MakeRecords(3000);
+  array[index] = {toJSON() { return 'to json ' + index; }};
+  Check(array);
+  array[index] = 'two byte \u2603';
+  Check(array);
+  array[index] = new Number(index);
+  Check(array);
+  array[index] = [1, , 3];
+  Check(array);
+  array[index] = new Proxy({a: 1}, {});
+  Check(array);
+}
+
+// toJSON on a prototype of the elements.
+{
+  const proto = {};
+  const array = MakeRecords(2000).map(e => Object.setPrototypeOf(e, proto));
+  Check(array);
+  proto.toJSON = function() { return 'proto'; };
+  Check(array);
+  delete proto.toJSON;
+  Check(array);
+}
+
+// Deep nesting.
+{
+  let deep = {};
+  for (let i = 0; i < 100; i++) deep = {child: [deep]};
+  const array = MakeRecords(2000);
+  array[1234] = deep;
+  Check(array);
+}
+
+// Cycles are still reported.
+{
+  const array = MakeRecords(2000);
+  const cycle = {a: 1};
+  cycle.self = cycle;
+  array[1000] = cycle;
+  assertThrows(() => JSON.stringify(array), TypeError);
+  array[1000] = array;
+  assertThrows(() => JSON.stringify(array), TypeError);
+}
+
+// Two-byte output before the parallel part.
+{
+  const array = ['\u2603'].concat(MakeRecords(2000));
+  Check(array);
+  assertEquals(Expected([array]), JSON.stringify([array]));
+}
+
+// Replacers and gaps use the main thread only.
+{
+  const array = MakeRecords(1000);
+  assertEquals(JSON.stringify(array),
+               JSON.stringify(JSON.parse(JSON.stringify(array, null, 2))));
+  assertEquals(JSON.stringify(array), JSON.stringify(array, (k, v) => v));
+  assertEquals(Expected(array.map(e => ({id: e.id}))),
+               JSON.stringify(array, ['id']));
+}
@@ -0,0 +1,30 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --stub-cache-ways=4 --stub-cache-entries=256
+
+// Megamorphic loads and stores through a small four-way stub cache.
+const kNumShapes = 64;
+const objects = [];
+for (let i = 0; i < kNumShapes; i++) {
+  const o = {};
+  o['p' + i] = i;
+  o.x = i;
+  objects.push(o);
+}
+
+function load(o) {
+  return o.x;
+}
+
+function store(o, value) {
+  o.x = value;
+}
+
+for (let round = 0; round < 10; round++) {
+  for (let i = 0; i < kNumShapes; i++) {
+    assertEquals(i + round, load(objects[i]));
+    store(objects[i], i + round + 1);
+  }
+}
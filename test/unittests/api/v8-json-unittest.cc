@@ -0,0 +1,114 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "include/v8-exception.h"
+#include "include/v8-json.h"
+#include "include/v8-primitive.h"
+#include "include/v8-value.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace {
+
+using JSONTest = TestWithContext;
+using Encoding = JSON::StreamingParser::Encoding;
+
+// Feeds |json| in chunks of |chunk_size| bytes and returns the re-stringified
+// result, or the message of the SyntaxError.
+std::string StreamingParse(Isolate* isolate, Local<Context> context,
+                           const char* json, size_t chunk_size,
+                           Encoding encoding = Encoding::kUtf8) {
+  TryCatch try_catch(isolate);
+  JSON::StreamingParser parser(isolate, encoding);
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(json);
+  size_t length = strlen(json);
+  Local<Value> result;
+  for (size_t offset = 0; offset < length; offset += chunk_size) {
+    if (parser
+            .Feed(context, data + offset, std::min(chunk_size, length - offset))
+            .IsNothing()) {
+      break;
+    }
+  }
+  if (!try_catch.HasCaught() && parser.Finish(context).ToLocal(&result)) {
+    String::Utf8Value utf8(
+        isolate, JSON::Stringify(context, result).ToLocalChecked());
+    return *utf8;
+  }
+  EXPECT_TRUE(try_catch.HasCaught());
+  String::Utf8Value message(isolate, try_catch.Exception());
+  return *message;
+}
+
+std::string Parse(Isolate* isolate, Local<Context> context, const char* json) {
+  TryCatch try_catch(isolate);
+  Local<Value> result;
+  if (JSON::Parse(context, String::NewFromUtf8(isolate, json).ToLocalChecked())
+          .ToLocal(&result)) {
+    String::Utf8Value utf8(
+        isolate, JSON::Stringify(context, result).ToLocalChecked());
+    return *utf8;
+  }
+  return "SyntaxError";
+}
+
+TEST_F(JSONTest, StreamingParserMatchesParse) {
+  HandleScope scope(isolate());
+  const char* kInputs[] = {
+      "[]",
+      " [ ] ",
+      "{}",
+      "[1, 2.5, \"three\", true, false, null]",
+      "[[1, [2]], {\"a\": [3, {\"b\": 4}]}, \"]\", \"[\", \",\"]",
+      "{\"a\": 1, \"b\": {\"c\": [1, 2, {\"d\": \"}\"}]}, \"e:f\": \"g,h\"}",
+      "{\"\\\"quoted\\\\\": \"\\\"\", \"a\": 1, \"a\": 2, \"0\": \"x\"}",
+      "{\"__proto__\": {\"x\": 1}}",
+      "\n[\n  {\"k\": \"\\u2603 \xe2\x98\x83\"},\n  \"\xc3\xa9\"\n]\n",
+      "42",
+      " \"a string\" ",
+      "null",
+  };
+  for (const char* input : kInputs) {
+    std::string expected = Parse(isolate(), context(), input);
+    for (size_t chunk_size : {1, 2, 3, 7, 1000}) {
+      EXPECT_EQ(expected,
+                StreamingParse(isolate(), context(), input, chunk_size))
+          << input << " in chunks of " << chunk_size;
+    }
+  }
+}
+
+TEST_F(JSONTest, StreamingParserOneByte) {
+  HandleScope scope(isolate());
+  // 0xE9 is a Latin1 'é', but not valid UTF-8.
+  EXPECT_EQ("[\"\xc3\xa9\",{\"\xc3\xa9\":1}]",
+            StreamingParse(isolate(), context(), "[\"\xe9\", {\"\xe9\": 1}]",
+                           1, Encoding::kOneByte));
+}
+
+TEST_F(JSONTest, StreamingParserSyntaxErrors) {
+  HandleScope scope(isolate());
+  const char* kInputs[] = {
+      "",       "  ",        "[",      "[1,]",      "[,1]",
+      "[1,,2]", "[1}",       "[1] x",  "[\"a]",     "{\"a\": 1]",
+      "{a: 1}", "{\"a\" 1}", "{1: 1}", "{\"a\":}", "{\"a\": [1}",
+      "tru",
+  };
+  for (const char* input : kInputs) {
+    EXPECT_EQ("SyntaxError", Parse(isolate(), context(), input)) << input;
+    for (size_t chunk_size : {1, 1000}) {
+      EXPECT_EQ(0u, StreamingParse(isolate(), context(), input, chunk_size)
+                        .rfind("SyntaxError", 0))
+          << input << " in chunks of " << chunk_size;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace v8
@@ -0,0 +1,60 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/platform/huge-pages.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "src/base/bits.h"
+#include "src/base/page-allocator.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace base {
+
+TEST(HugePagesTest, PageSize) {
+  const size_t huge_page_size = HugePages::PageSize();
+  if (huge_page_size == 0) return;
+  PageAllocator page_allocator;
+  EXPECT_TRUE(bits::IsPowerOfTwo(huge_page_size));
+  EXPECT_LT(page_allocator.CommitPageSize(), huge_page_size);
+}
+
+TEST(HugePagesTest, BackedBytes) {
+  PageAllocator page_allocator;
+  const size_t huge_page_size = HugePages::PageSize();
+  const size_t size =
+      4 * std::max(huge_page_size, page_allocator.AllocatePageSize());
+  void* memory = page_allocator.AllocatePages(nullptr, size, size / 4,
+                                              PageAllocator::kReadWrite);
+  ASSERT_NE(nullptr, memory);
+  EXPECT_EQ(0u, HugePages::BackedBytes(memory, size));
+  if (HugePages::Enable(memory, size)) {
+    // Whether the kernel actually finds huge pages depends on fragmentation,
+    // so only check that the result is within the range.
+    memset(memory, 0xab, size);
+    EXPECT_EQ(0xab, static_cast<uint8_t*>(memory)[size - 1]);
+    size_t backed_bytes = HugePages::BackedBytes(memory, size);
+    EXPECT_LE(backed_bytes, size);
+    EXPECT_EQ(0u, backed_bytes % huge_page_size);
+    EXPECT_LE(HugePages::BackedBytes(memory, size / 2), size / 2);
+  }
+  EXPECT_TRUE(page_allocator.FreePages(memory, size));
+}
+
+TEST(HugePagesTest, UnsupportedWithoutHugePageSize) {
+  if (HugePages::PageSize() != 0) return;
+  PageAllocator page_allocator;
+  const size_t size = page_allocator.AllocatePageSize();
+  void* memory = page_allocator.AllocatePages(nullptr, size, size,
+                                              PageAllocator::kReadWrite);
+  ASSERT_NE(nullptr, memory);
+  EXPECT_FALSE(HugePages::Enable(memory, size));
+  EXPECT_EQ(0u, HugePages::BackedBytes(memory, size));
+  EXPECT_TRUE(page_allocator.FreePages(memory, size));
+}
+
+}  // namespace base
+}  // namespace v8
@@ -0,0 +1,90 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/platform/numa.h"
+
+#include <cstring>
+
+#include "src/base/page-allocator.h"
+#include "src/base/platform/platform.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace base {
+
+TEST(NumaTest, CurrentNode) {
+  int nodes = Numa::NumberOfNodes();
+  EXPECT_LE(1, nodes);
+  int node = Numa::GetCurrentNode();
+  if (node != Numa::kNoNode) {
+    EXPECT_LE(0, node);
+    EXPECT_LT(node, nodes);
+  }
+}
+
+TEST(NumaTest, InvalidNode) {
+  EXPECT_FALSE(Numa::BindCurrentThreadToNode(Numa::kNoNode));
+  EXPECT_FALSE(Numa::BindCurrentThreadToNode(Numa::NumberOfNodes()));
+  PageAllocator page_allocator;
+  const size_t size = page_allocator.AllocatePageSize();
+  void* memory = page_allocator.AllocatePages(nullptr, size, size,
+                                              PageAllocator::kReadWrite);
+  ASSERT_NE(nullptr, memory);
+  EXPECT_FALSE(Numa::SetPreferredNode(memory, size, Numa::NumberOfNodes()));
+  EXPECT_TRUE(page_allocator.FreePages(memory, size));
+}
+
+#if V8_OS_LINUX
+
+namespace {
+
+class BindToNodeThread final : public Thread {
+ public:
+  explicit BindToNodeThread(int node)
+      : Thread(Options("BindToNodeThread")), node_(node) {}
+
+  void Run() override {
+    bound_ = Numa::BindCurrentThreadToNode(node_);
+    current_node_ = Numa::GetCurrentNode();
+  }
+
+  bool bound() const { return bound_; }
+  int current_node() const { return current_node_; }
+
+ private:
+  const int node_;
+  bool bound_ = false;
+  int current_node_ = Numa::kNoNode;
+};
+
+}  // namespace
+
+TEST(NumaTest, BindThreadToEveryNode) {
+  for (int node = 0; node < Numa::NumberOfNodes(); node++) {
+    BindToNodeThread thread(node);
+    ASSERT_TRUE(thread.Start());
+    thread.Join();
+    // Binding may be disallowed, e.g. by a sandbox, or nodes may be offline.
+    if (thread.bound()) EXPECT_EQ(node, thread.current_node());
+  }
+}
+
+TEST(NumaTest, SetPreferredNode) {
+  PageAllocator page_allocator;
+  const size_t size = 4 * page_allocator.AllocatePageSize();
+  void* memory = page_allocator.AllocatePages(nullptr, size, size / 4,
+                                              PageAllocator::kReadWrite);
+  ASSERT_NE(nullptr, memory);
+  if (Numa::SetPreferredNode(memory, size, 0)) {
+    // Faulting in the pages still works.
+    memset(memory, 0xab, size);
+    EXPECT_EQ(0xab, static_cast<uint8_t*>(memory)[size - 1]);
+  }
+  EXPECT_TRUE(page_allocator.FreePages(memory, size));
+}
+
+#endif  // V8_OS_LINUX
+
+}  // namespace base
+}  // namespace v8
@@ -11,10 +11,12 @@
 #include "src/codegen/optimized-compilation-info.h"
 #include "src/execution/isolate.h"
 #include "src/execution/local-isolate.h"
+#include "src/execution/tiering-manager.h"
 #include "src/handles/handles.h"
 #include "src/heap/local-heap.h"
 #include "src/objects/objects-inl.h"
 #include "src/parsing/parse-info.h"
+#include "src/utils/locked-priority-queue-inl.h"
 #include "test/unittests/test-helpers.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -96,5 +98,43 @@ TEST_F(OptimizingCompileDispatcherTest, NonBlockingFlush) {
   dispatcher.Stop();
 }
 
+TEST_F(OptimizingCompileDispatcherTest, OsrJobsComeFirst) {
+  Handle<JSFunction> hot = RunJS<JSFunction>("(function hot() {})");
+  Handle<JSFunction> cold = RunJS<JSFunction>("(function cold() {})");
+  for (Handle<JSFunction> function : {hot, cold}) {
+    IsCompiledScope is_compiled_scope;
+    ASSERT_TRUE(Compiler::Compile(i_isolate(), function,
+                                  Compiler::CLEAR_EXCEPTION,
+                                  &is_compiled_scope));
+    JSFunction::EnsureFeedbackVector(i_isolate(), function,
+                                     &is_compiled_scope);
+  }
+  hot->feedback_vector()->set_invocation_count(10000, kRelaxedStore);
+  cold->feedback_vector()->set_invocation_count(1, kRelaxedStore);
+
+  // A function stuck in a loop has a low invocation count, but its OSR job
+  // must not wait behind the jobs of functions that are invoked more often.
+  enum Job { kHot, kCold, kColdOsr };
+  LockedPriorityQueue<Job> queue;
+  queue.Enqueue(kCold, TieringManager::CompileQueuePriority(*cold, false));
+  queue.Enqueue(kColdOsr, TieringManager::CompileQueuePriority(*cold, true));
+  queue.Enqueue(kHot, TieringManager::CompileQueuePriority(*hot, false));
+
+  // Reprioritizing a hot function does not overtake OSR jobs either.
+  hot->feedback_vector()->set_invocation_count(kMaxInt, kRelaxedStore);
+  EXPECT_TRUE(queue.RaisePriority([](Job job) { return job == kHot; },
+                                  TieringManager::CompileQueuePriority(
+                                      *hot, false)));
+
+  Job job = kCold;
+  ASSERT_TRUE(queue.Dequeue(&job));
+  EXPECT_EQ(kColdOsr, job);
+  ASSERT_TRUE(queue.Dequeue(&job));
+  EXPECT_EQ(kHot, job);
+  ASSERT_TRUE(queue.Dequeue(&job));
+  EXPECT_EQ(kCold, job);
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <map>
+#include <vector>
 
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -194,5 +195,68 @@ TEST(BasicSlotSet, RemoveRange) {
   TestSlotSet::Delete(set, kBucketsTestPage);
 }
 
+namespace {
+
+// Inserts every |stride|-th slot, starting at |start|.
+TestSlotSet* AllocateWithSlots(size_t start, size_t stride) {
+  TestSlotSet* set = TestSlotSet::Allocate(kBucketsTestPage);
+  for (size_t i = start; i < kTestPageSize; i += stride * kTestGranularity) {
+    set->Insert<TestSlotSet::AccessMode::ATOMIC>(i);
+  }
+  return set;
+}
+
+template <TestSlotSet::AccessMode access_mode>
+std::vector<uintptr_t> IterateAndRemoveOddSlots(TestSlotSet* set) {
+  std::vector<uintptr_t> visited;
+  set->Iterate<access_mode>(
+      0, 0, kBucketsTestPage,
+      [&visited](uintptr_t slot) {
+        visited.push_back(slot);
+        return (slot / kTestGranularity) % 2 == 0 ? KEEP_SLOT : REMOVE_SLOT;
+      },
+      TestSlotSet::KEEP_EMPTY_BUCKETS);
+  return visited;
+}
+
+void CheckNonAtomicIterationMatchesAtomic(size_t start, size_t stride) {
+  TestSlotSet* atomic_set = AllocateWithSlots(start, stride);
+  TestSlotSet* non_atomic_set = AllocateWithSlots(start, stride);
+  EXPECT_EQ(
+      IterateAndRemoveOddSlots<TestSlotSet::AccessMode::ATOMIC>(atomic_set),
+      IterateAndRemoveOddSlots<TestSlotSet::AccessMode::NON_ATOMIC>(
+          non_atomic_set));
+  for (size_t i = 0; i < kTestPageSize; i += kTestGranularity) {
+    EXPECT_EQ(atomic_set->Lookup(i), non_atomic_set->Lookup(i));
+  }
+  TestSlotSet::Delete(atomic_set, kBucketsTestPage);
+  TestSlotSet::Delete(non_atomic_set, kBucketsTestPage);
+}
+
+}  // namespace
+
+TEST(BasicSlotSet, IterateNonAtomicDense) {
+  CheckNonAtomicIterationMatchesAtomic(0, 1);
+  CheckNonAtomicIterationMatchesAtomic(kTestGranularity, 3);
+}
+
+TEST(BasicSlotSet, IterateNonAtomicSparse) {
+  CheckNonAtomicIterationMatchesAtomic(0, 1021);
+  // Only the last slot of the page.
+  CheckNonAtomicIterationMatchesAtomic(kTestPageSize - kTestGranularity,
+                                       kTestPageSize);
+  // Only slots in the last cell of every other bucket.
+  TestSlotSet* set = TestSlotSet::Allocate(kBucketsTestPage);
+  const size_t bucket_size = TestSlotSet::kBitsPerBucket * kTestGranularity;
+  for (size_t i = bucket_size - kTestGranularity; i < kTestPageSize;
+       i += 2 * bucket_size) {
+    set->Insert<TestSlotSet::AccessMode::ATOMIC>(i);
+  }
+  std::vector<uintptr_t> visited =
+      IterateAndRemoveOddSlots<TestSlotSet::AccessMode::NON_ATOMIC>(set);
+  EXPECT_EQ(kBucketsTestPage / 2, visited.size());
+  TestSlotSet::Delete(set, kBucketsTestPage);
+}
+
 }  // namespace base
 }  // namespace heap
@@ -0,0 +1,94 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/concurrent-allocator.h"
+
+#include "src/heap/concurrent-allocator-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/local-heap.h"
+#include "src/heap/memory-chunk-layout.h"
+#include "src/heap/safepoint.h"
+#include "test/unittests/heap/heap-utils.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+class ConcurrentAllocatorTest : public TestWithHeapInternalsAndContext {
+ public:
+  ConcurrentAllocator* allocator() {
+    return i_isolate()->main_thread_local_heap()->old_space_allocator();
+  }
+
+  Address Allocate(int size) {
+    AllocationResult result = allocator()->AllocateRaw(
+        size, kTaggedAligned, AllocationOrigin::kRuntime);
+    CHECK(!result.IsFailure());
+    heap()->CreateFillerObjectAt(result.ToAddress(), size);
+    return result.ToAddress();
+  }
+
+  void FreeLabs() {
+    IsolateSafepointScope safepoint_scope(heap());
+    heap()->FreeLinearAllocationAreas();
+  }
+};
+
+TEST_F(ConcurrentAllocatorTest, ReserveLabIsContiguous) {
+  FreeLabs();
+  constexpr int kObjectSize = ConcurrentAllocator::kMaxLabObjectSize * 2;
+  constexpr int kObjects = 8;
+  base::Optional<base::AddressRegion> region = allocator()->ReserveLab(
+      kObjectSize * kObjects, AllocationOrigin::kRuntime);
+  ASSERT_TRUE(region.has_value());
+  EXPECT_LE(static_cast<size_t>(kObjectSize * kObjects), region->size());
+
+  // Objects larger than kMaxLabObjectSize are allocated back to back in the
+  // reserved LAB.
+  Address expected = region->begin();
+  for (int i = 0; i < kObjects; ++i) {
+    EXPECT_EQ(expected, Allocate(kObjectSize));
+    expected += kObjectSize;
+  }
+  FreeLabs();
+}
+
+TEST_F(ConcurrentAllocatorTest, ReserveLabLargerThanMaxLabSize) {
+  FreeLabs();
+  constexpr int kSize = 3 * ConcurrentAllocator::kMaxLabSize;
+  base::Optional<base::AddressRegion> region =
+      allocator()->ReserveLab(kSize, AllocationOrigin::kRuntime);
+  ASSERT_TRUE(region.has_value());
+  EXPECT_LE(static_cast<size_t>(kSize), region->size());
+
+  // A single object larger than a regular LAB fits.
+  constexpr int kObjectSize = 2 * ConcurrentAllocator::kMaxLabSize;
+  EXPECT_EQ(region->begin(), Allocate(kObjectSize));
+
+  // Once the reservation ends, large objects are allocated outside the LAB
+  // again, while small ones still use it.
+  allocator()->EndLabReservation();
+  constexpr int kLargeObjectSize = ConcurrentAllocator::kMaxLabObjectSize * 2;
+  EXPECT_FALSE(region->contains(Allocate(kLargeObjectSize)));
+  EXPECT_EQ(region->begin() + kObjectSize, Allocate(kTaggedSize * 4));
+  FreeLabs();
+}
+
+TEST_F(ConcurrentAllocatorTest, ReserveLabFallsBackWithoutRegion) {
+  FreeLabs();
+  // No page has an area this large, so the reservation fails.
+  const int size = static_cast<int>(
+      MemoryChunkLayout::AllocatableMemoryInDataPage() + KB);
+  EXPECT_FALSE(
+      allocator()->ReserveLab(size, AllocationOrigin::kRuntime).has_value());
+
+  // Allocations still succeed through the regular paths.
+  Allocate(ConcurrentAllocator::kMaxLabObjectSize * 2);
+  Allocate(kTaggedSize * 4);
+  FreeLabs();
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -4,6 +4,8 @@
 
 #include "src/heap/cppgc/compactor.h"
 
+#include <unordered_set>
+
 #include "include/cppgc/allocation.h"
 #include "include/cppgc/custom-space.h"
 #include "include/cppgc/persistent.h"
@@ -23,6 +25,13 @@ class CompactableCustomSpace : public CustomSpace<CompactableCustomSpace> {
   static constexpr bool kSupportsCompaction = true;
 };
 
+class OtherCompactableCustomSpace
+    : public CustomSpace<OtherCompactableCustomSpace> {
+ public:
+  static constexpr size_t kSpaceIndex = 1;
+  static constexpr bool kSupportsCompaction = true;
+};
+
 namespace internal {
 
 namespace {
@@ -63,12 +72,55 @@ struct CompactableHolder
   CompactableGCed* objects[kNumObjects]{};
 };
 
+struct LargeCompactableGCed : public GarbageCollected<LargeCompactableGCed> {
+ public:
+  void Trace(Visitor* visitor) const {
+    VisitorBase::TraceRawForTesting(
+        visitor, const_cast<const LargeCompactableGCed*>(other));
+    visitor->RegisterMovableReference(
+        const_cast<const LargeCompactableGCed**>(&other));
+  }
+  LargeCompactableGCed* other = nullptr;
+  char payload[4 * kKB - sizeof(other) - sizeof(HeapObjectHeader)];
+};
+
+// A LargeCompactableGCed that lives in OtherCompactableCustomSpace.
+struct OtherLargeCompactableGCed : public LargeCompactableGCed {};
+
+// The number of LargeCompactableGCed objects that fill a page.
+size_t LargeCompactableGCedPerPage() {
+  return NormalPage::PayloadSize() /
+         (sizeof(LargeCompactableGCed) + sizeof(HeapObjectHeader));
+}
+
+// Holds a list of LargeCompactableGCed objects linked through |other|.
+struct LargeCompactableList : public GarbageCollected<LargeCompactableList> {
+ public:
+  void Trace(Visitor* visitor) const {
+    VisitorBase::TraceRawForTesting(
+        visitor, const_cast<const LargeCompactableGCed*>(head));
+    visitor->RegisterMovableReference(
+        const_cast<const LargeCompactableGCed**>(&head));
+  }
+  size_t CountPages(HeapBase* heap) const {
+    std::unordered_set<const BasePage*> pages;
+    for (const LargeCompactableGCed* object = head; object;
+         object = object->other) {
+      pages.insert(BasePage::FromInnerAddress(heap, object));
+    }
+    return pages.size();
+  }
+  LargeCompactableGCed* head = nullptr;
+};
+
 class CompactorTest : public testing::TestWithPlatform {
  public:
   CompactorTest() {
     Heap::HeapOptions options;
     options.custom_spaces.emplace_back(
         std::make_unique<CompactableCustomSpace>());
+    options.custom_spaces.emplace_back(
+        std::make_unique<OtherCompactableCustomSpace>());
     heap_ = Heap::Create(platform_, std::move(options));
   }
 
@@ -83,19 +135,20 @@ class CompactorTest : public testing::TestWithPlatform {
 
   void StartGC() {
     CompactableGCed::g_destructor_callcount = 0u;
-    StartCompaction();
+    compactor().EnableForNextGCForTesting();
     heap()->StartIncrementalGarbageCollection(
         GCConfig::PreciseIncrementalConfig());
+    EXPECT_TRUE(compactor().IsEnabledForTesting());
   }
 
   void EndGC() {
     heap()->marker()->FinishMarking(StackState::kNoHeapPointers);
     heap()->GetMarkerRefForTesting().reset();
-    FinishCompaction();
+    const SweepingConfig::CompactableSpaceHandling compactable_space_handling =
+        compactor().CompactSpacesIfEnabled();
     // Sweeping also verifies the object start bitmap.
-    const SweepingConfig sweeping_config{
-        SweepingConfig::SweepingType::kAtomic,
-        SweepingConfig::CompactableSpaceHandling::kIgnore};
+    const SweepingConfig sweeping_config{SweepingConfig::SweepingType::kAtomic,
+                                         compactable_space_handling};
     heap()->sweeper().Start(sweeping_config);
     heap()->sweeper().FinishIfRunning();
   }
@@ -119,6 +172,16 @@ struct SpaceTrait<internal::CompactableGCed> {
   using Space = CompactableCustomSpace;
 };
 
+template <>
+struct SpaceTrait<internal::LargeCompactableGCed> {
+  using Space = CompactableCustomSpace;
+};
+
+template <>
+struct SpaceTrait<internal::OtherLargeCompactableGCed> {
+  using Space = OtherCompactableCustomSpace;
+};
+
 namespace internal {
 
 TEST_F(CompactorTest, NothingToCompact) {
@@ -245,5 +308,125 @@ TEST_F(CompactorTest, InteriorSlotToNextObject) {
   EXPECT_EQ(references[1], holder->objects[1]->other);
 }
 
+TEST_F(CompactorTest, DensePagesAreNotEvacuated) {
+  static constexpr size_t kNumObjects = 64;
+  Persistent<LargeCompactableList> list =
+      MakeGarbageCollected<LargeCompactableList>(GetAllocationHandle());
+  std::vector<LargeCompactableGCed*> references;
+  for (size_t i = 0; i < kNumObjects; ++i) {
+    auto* object =
+        MakeGarbageCollected<LargeCompactableGCed>(GetAllocationHandle());
+    // Every fourth object dies, which leaves the pages mostly live.
+    if (i % 4 == 3) continue;
+    object->other = list->head;
+    list->head = object;
+    references.push_back(object);
+  }
+  StartGC();
+  EndGC();
+  auto it = references.rbegin();
+  for (const LargeCompactableGCed* object = list->head; object;
+       object = object->other) {
+    ASSERT_NE(references.rend(), it);
+    EXPECT_EQ(*it++, object);
+  }
+}
+
+TEST_F(CompactorTest, CompactionIsBoundedPerGC) {
+  static constexpr size_t kNumObjects = 4096;
+  Persistent<LargeCompactableList> list =
+      MakeGarbageCollected<LargeCompactableList>(GetAllocationHandle());
+  for (size_t i = 0; i < kNumObjects; ++i) {
+    auto* object =
+        MakeGarbageCollected<LargeCompactableGCed>(GetAllocationHandle());
+    // Only every fourth object survives, which leaves 4MB of live objects on
+    // sparse pages. Evacuating all of them exceeds the budget of a single GC.
+    if (i % 4 != 0) continue;
+    object->other = list->head;
+    list->head = object;
+  }
+  const size_t pages_before_compaction = list->CountPages(heap());
+  StartGC();
+  EndGC();
+  const size_t pages_after_first_compaction = list->CountPages(heap());
+  EXPECT_LT(pages_after_first_compaction, pages_before_compaction);
+  StartGC();
+  EndGC();
+  const size_t pages_after_second_compaction = list->CountPages(heap());
+  EXPECT_LT(pages_after_second_compaction, pages_after_first_compaction);
+  size_t num_live_objects = 0;
+  for (const LargeCompactableGCed* object = list->head; object;
+       object = object->other) {
+    ++num_live_objects;
+  }
+  EXPECT_EQ(kNumObjects / 4, num_live_objects);
+}
+
+TEST_F(CompactorTest, NoPageQualifiesForEvacuation) {
+  // Two full pages and a page that is three quarters full, all live.
+  const size_t num_objects =
+      2 * LargeCompactableGCedPerPage() + 3 * LargeCompactableGCedPerPage() / 4;
+  Persistent<LargeCompactableList> list =
+      MakeGarbageCollected<LargeCompactableList>(GetAllocationHandle());
+  std::vector<LargeCompactableGCed*> references;
+  for (size_t i = 0; i < num_objects; ++i) {
+    auto* object =
+        MakeGarbageCollected<LargeCompactableGCed>(GetAllocationHandle());
+    object->other = list->head;
+    list->head = object;
+    references.push_back(object);
+  }
+  EXPECT_EQ(3u, list->CountPages(heap()));
+  StartGC();
+  EndGC();
+  auto it = references.rbegin();
+  for (const LargeCompactableGCed* object = list->head; object;
+       object = object->other) {
+    ASSERT_NE(references.rend(), it);
+    EXPECT_EQ(*it++, object);
+  }
+  EXPECT_EQ(references.rend(), it);
+}
+
+TEST_F(CompactorTest, EarlierSpaceUsesUpTheBudget) {
+  // The first space has 4MB of live objects on sparse pages, which uses up
+  // the budget of the GC.
+  static constexpr size_t kNumObjects = 4096;
+  Persistent<LargeCompactableList> list =
+      MakeGarbageCollected<LargeCompactableList>(GetAllocationHandle());
+  for (size_t i = 0; i < kNumObjects; ++i) {
+    auto* object =
+        MakeGarbageCollected<LargeCompactableGCed>(GetAllocationHandle());
+    if (i % 4 != 0) continue;
+    object->other = list->head;
+    list->head = object;
+  }
+  // Every page of the second space is half live. The pages qualify for
+  // evacuation, but there is no budget left for them.
+  const size_t num_other_objects = 4 * LargeCompactableGCedPerPage();
+  Persistent<LargeCompactableList> other_list =
+      MakeGarbageCollected<LargeCompactableList>(GetAllocationHandle());
+  std::vector<LargeCompactableGCed*> references;
+  for (size_t i = 0; i < num_other_objects; ++i) {
+    auto* object =
+        MakeGarbageCollected<OtherLargeCompactableGCed>(GetAllocationHandle());
+    if (i % 2 != 0) continue;
+    object->other = other_list->head;
+    other_list->head = object;
+    references.push_back(object);
+  }
+  const size_t pages_before_compaction = list->CountPages(heap());
+  StartGC();
+  EndGC();
+  EXPECT_LT(list->CountPages(heap()), pages_before_compaction);
+  auto it = references.rbegin();
+  for (const LargeCompactableGCed* object = other_list->head; object;
+       object = object->other) {
+    ASSERT_NE(references.rend(), it);
+    EXPECT_EQ(*it++, object);
+  }
+  EXPECT_EQ(references.rend(), it);
+}
+
 }  // namespace internal
 }  // namespace cppgc
@@ -23,7 +23,7 @@ class FakeGarbageCollector : public GarbageCollector {
   void SetLiveBytes(size_t live_bytes) { live_bytes_ = live_bytes; }
 
   void CollectGarbage(GCConfig config) override {
-    stats_collector_->NotifyMarkingStarted(CollectionType::kMajor,
+    stats_collector_->NotifyMarkingStarted(config.collection_type,
                                            GCConfig::MarkingType::kAtomic,
                                            GCConfig::IsForcedGC::kNotForced);
     stats_collector_->NotifyMarkingCompleted(live_bytes_);
@@ -172,5 +172,60 @@ TEST(HeapGrowingTest, IncrementalGCFinalized) {
   FakeAllocate(&stats_collector, StatsCollector::kAllocationThresholdBytes);
 }
 
+TEST(HeapGrowingTest, MinorGCInvoked) {
+  StatsCollector stats_collector(kNoPlatform);
+  MockGarbageCollector gc;
+  cppgc::Heap::ResourceConstraints constraints;
+  constraints.initial_heap_size_bytes = 10 * kMB;
+  constraints.young_generation_size_bytes = 1 * kMB;
+  HeapGrowing growing(&gc, &stats_collector, constraints,
+                      cppgc::Heap::MarkingType::kIncrementalAndConcurrent,
+                      cppgc::Heap::SweepingType::kIncrementalAndConcurrent,
+                      true /* young_generation_enabled */);
+  EXPECT_EQ(1 * kMB, growing.limit_for_minor_gc());
+  FakeAllocate(&stats_collector, 1 * kMB);
+  EXPECT_CALL(gc, CollectGarbage(::testing::Field(&GCConfig::collection_type,
+                                                  CollectionType::kMinor)));
+  EXPECT_CALL(gc, StartIncrementalGarbageCollection(::testing::_)).Times(0);
+  FakeAllocate(&stats_collector, StatsCollector::kAllocationThresholdBytes);
+}
+
+TEST(HeapGrowingTest, MinorGCNotInvokedWithoutYoungGeneration) {
+  StatsCollector stats_collector(kNoPlatform);
+  MockGarbageCollector gc;
+  cppgc::Heap::ResourceConstraints constraints;
+  constraints.initial_heap_size_bytes = 10 * kMB;
+  constraints.young_generation_size_bytes = 1 * kMB;
+  HeapGrowing growing(&gc, &stats_collector, constraints,
+                      cppgc::Heap::MarkingType::kIncrementalAndConcurrent,
+                      cppgc::Heap::SweepingType::kIncrementalAndConcurrent);
+  EXPECT_CALL(gc, CollectGarbage(::testing::_)).Times(0);
+  EXPECT_CALL(gc, StartIncrementalGarbageCollection(::testing::_)).Times(0);
+  FakeAllocate(&stats_collector, 2 * kMB);
+}
+
+TEST(HeapGrowingTest, MinorGCKeepsLimitsForMajorGC) {
+  StatsCollector stats_collector(kNoPlatform);
+  FakeGarbageCollector gc(&stats_collector);
+  cppgc::Heap::ResourceConstraints constraints;
+  constraints.initial_heap_size_bytes = 10 * kMB;
+  constraints.young_generation_size_bytes = 1 * kMB;
+  HeapGrowing growing(&gc, &stats_collector, constraints,
+                      cppgc::Heap::MarkingType::kIncrementalAndConcurrent,
+                      cppgc::Heap::SweepingType::kIncrementalAndConcurrent,
+                      true /* young_generation_enabled */);
+  const size_t limit_for_atomic_gc = growing.limit_for_atomic_gc();
+  const size_t limit_for_incremental_gc = growing.limit_for_incremental_gc();
+  gc.SetLiveBytes(1 * kMB);
+  FakeAllocate(&stats_collector, 2 * kMB);
+  EXPECT_EQ(1u, gc.epoch());
+  EXPECT_EQ(CollectionType::kMinor,
+            stats_collector.GetPreviousEventForTesting().collection_type);
+  EXPECT_EQ(limit_for_atomic_gc, growing.limit_for_atomic_gc());
+  EXPECT_EQ(limit_for_incremental_gc, growing.limit_for_incremental_gc());
+  // The promoted bytes count towards the limit for the next minor GC.
+  EXPECT_EQ(2 * kMB, growing.limit_for_minor_gc());
+}
+
 }  // namespace internal
 }  // namespace cppgc
@@ -5,6 +5,7 @@
 #if defined(CPPGC_YOUNG_GENERATION)
 
 #include <initializer_list>
+#include <memory>
 #include <vector>
 
 #include "include/cppgc/allocation.h"
@@ -15,6 +16,7 @@
 #include "src/heap/cppgc/heap-object-header.h"
 #include "src/heap/cppgc/heap-visitor.h"
 #include "src/heap/cppgc/heap.h"
+#include "src/heap/cppgc/stats-collector.h"
 #include "test/unittests/heap/cppgc/tests.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -876,6 +878,72 @@ TEST_F(MinorGCTest, RevisitNestedInConstructionObjects) {
   EXPECT_EQ(0u, RememberedInConstructionObjects().size());
 }
 
+TEST_F(MinorGCTest, ForcedMinorGC) {
+  const StatsCollector& stats_collector =
+      *Heap::From(GetHeap())->stats_collector();
+  const size_t minor_gcs =
+      stats_collector.GetCollectionTypeStats(CollectionType::kMinor).cycles;
+  const size_t major_gcs =
+      stats_collector.GetCollectionTypeStats(CollectionType::kMajor).cycles;
+
+  Persistent<Small> old_object =
+      MakeGarbageCollected<Small>(GetAllocationHandle());
+  CollectMinor();
+  EXPECT_TRUE(IsHeapObjectOld(old_object.Get()));
+
+  MakeGarbageCollected<Small>(GetAllocationHandle());
+  GetHeap()->ForceGarbageCollectionSlow(
+      "MinorGCTest", "Testing", cppgc::Heap::StackState::kNoHeapPointers,
+      cppgc::Heap::CollectionType::kMinor);
+  EXPECT_EQ(1u, DestructedObjects());
+
+  const StatsCollector::CollectionTypeStats& minor_gc_stats =
+      stats_collector.GetCollectionTypeStats(CollectionType::kMinor);
+  EXPECT_EQ(minor_gcs + 2, minor_gc_stats.cycles);
+  EXPECT_LE(sizeof(Small), minor_gc_stats.marked_bytes);
+  EXPECT_EQ(major_gcs,
+            stats_collector.GetCollectionTypeStats(CollectionType::kMajor)
+                .cycles);
+}
+
+TEST_F(MinorGCTest, MinorGCDuringIncrementalMajorGCIsSkipped) {
+  Heap* heap = Heap::From(GetHeap());
+  const size_t epoch = heap->epoch();
+  heap->StartIncrementalGarbageCollection(
+      GCConfig::PreciseIncrementalConfig());
+  CollectMinor();
+  EXPECT_EQ(epoch + 1, heap->epoch());
+  EXPECT_TRUE(GetMarkerRef());
+  heap->FinalizeIncrementalGarbageCollectionIfRunning(
+      GCConfig::PreciseIncrementalConfig());
+  EXPECT_FALSE(GetMarkerRef());
+}
+
+class YoungGenerationHeapOptionsTest : public testing::TestWithPlatform {};
+
+TEST_F(YoungGenerationHeapOptionsTest, EnabledByFirstGC) {
+  cppgc::Heap::HeapOptions options;
+  options.enable_young_generation = true;
+  std::unique_ptr<cppgc::Heap> heap =
+      cppgc::Heap::Create(GetPlatformHandle(), std::move(options));
+  EXPECT_FALSE(Heap::From(heap.get())->generational_gc_supported());
+
+  // A minor GC is upgraded to a major GC until the young generation is set up.
+  heap->ForceGarbageCollectionSlow(
+      "YoungGenerationHeapOptionsTest", "Testing",
+      cppgc::Heap::StackState::kNoHeapPointers,
+      cppgc::Heap::CollectionType::kMinor);
+  EXPECT_TRUE(Heap::From(heap.get())->generational_gc_supported());
+  const StatsCollector& stats_collector =
+      *Heap::From(heap.get())->stats_collector();
+  EXPECT_EQ(0u, stats_collector.GetCollectionTypeStats(CollectionType::kMinor)
+                    .cycles);
+  EXPECT_EQ(1u, stats_collector.GetCollectionTypeStats(CollectionType::kMajor)
+                    .cycles);
+
+  Heap::From(heap.get())->Terminate();
+}
+
 }  // namespace internal
 }  // namespace cppgc
 
@@ -227,6 +227,27 @@ TEST_F(GCTracerTest, RegularScope) {
             tracer->current_.scopes[GCTracer::Scope::MC_MARK]);
 }
 
+TEST_F(GCTracerTest, Compaction) {
+  if (v8_flags.stress_incremental_marking) return;
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+  const size_t kCompactedBytes = 100 * KB;
+
+  StartTracing(tracer, GarbageCollector::MARK_COMPACTOR,
+               StartTracingMode::kAtomic);
+  tracer->NotifyCompaction(3, kCompactedBytes);
+  StopTracing(tracer, GarbageCollector::MARK_COMPACTOR);
+  EXPECT_EQ(3u, tracer->current_.compacted_pages);
+  EXPECT_EQ(kCompactedBytes, tracer->current_.compacted_bytes);
+
+  // The next cycle starts without compacted pages.
+  StartTracing(tracer, GarbageCollector::MARK_COMPACTOR,
+               StartTracingMode::kAtomic);
+  StopTracing(tracer, GarbageCollector::MARK_COMPACTOR);
+  EXPECT_EQ(0u, tracer->current_.compacted_pages);
+  EXPECT_EQ(0u, tracer->current_.compacted_bytes);
+}
+
 TEST_F(GCTracerTest, IncrementalScope) {
   if (v8_flags.stress_incremental_marking) return;
   GCTracer* tracer = i_isolate()->heap()->tracer();
@@ -0,0 +1,67 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/young-generation-controller.h"
+
+#include "src/common/globals.h"
+#include "src/flags/flags.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr size_t kMinCapacity = 1 * MB;
+constexpr size_t kMaxCapacity = 32 * MB;
+// With a survival ratio of 1/8 and a scavenge speed of 1MB/ms, a scavenge of
+// 8MB takes 1ms.
+constexpr size_t kCurrentCapacity = 8 * MB;
+constexpr double kSurvivalRatio = 0.125;
+constexpr double kScavengeSpeed = 1.0 * MB;
+
+size_t ComputeCapacity(double allocation_throughput, double pause_target_ms,
+                       double throughput_target) {
+  return YoungGenerationController::ComputeCapacity(
+      kCurrentCapacity, kMinCapacity, kMaxCapacity, kSurvivalRatio,
+      kScavengeSpeed, allocation_throughput, pause_target_ms,
+      throughput_target);
+}
+
+}  // namespace
+
+TEST(YoungGenerationControllerTest, SizesForThroughput) {
+  // Scavenges need to be 1ms apart for a throughput of 0.5.
+  EXPECT_EQ(4 * MB, ComputeCapacity(4.0 * MB, 2, 0.5));
+  // And 3ms apart for a throughput of 0.75.
+  EXPECT_EQ(12 * MB, ComputeCapacity(4.0 * MB, 2, 0.75));
+}
+
+TEST(YoungGenerationControllerTest, PauseTargetTakesPrecedence) {
+  EXPECT_EQ(8 * MB, ComputeCapacity(64.0 * MB, 1, 0.5));
+  EXPECT_EQ(4 * MB, ComputeCapacity(64.0 * MB, 0.5, 0.5));
+}
+
+TEST(YoungGenerationControllerTest, LimitsGrowingStep) {
+  EXPECT_EQ(v8_flags.semi_space_growth_factor * kCurrentCapacity,
+            ComputeCapacity(1.0 * GB, 10, 0.99));
+}
+
+TEST(YoungGenerationControllerTest, StaysWithinBounds) {
+  EXPECT_EQ(kMinCapacity, ComputeCapacity(1.0 * KB, 1, 0.5));
+  EXPECT_EQ(kMinCapacity, ComputeCapacity(64.0 * MB, 0, 0.5));
+  EXPECT_EQ(kMaxCapacity, YoungGenerationController::ComputeCapacity(
+                              24 * MB, kMinCapacity, kMaxCapacity,
+                              kSurvivalRatio, kScavengeSpeed, 1.0 * GB, 10,
+                              0.99));
+}
+
+TEST(YoungGenerationControllerTest, NoSurvivors) {
+  EXPECT_EQ(kMinCapacity, YoungGenerationController::ComputeCapacity(
+                              kCurrentCapacity, kMinCapacity, kMaxCapacity, 0,
+                              kScavengeSpeed, 64.0 * MB, 1, 0.97));
+}
+
+}  // namespace internal
+}  // namespace v8
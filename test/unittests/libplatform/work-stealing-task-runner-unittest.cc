@@ -0,0 +1,256 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/libplatform/work-stealing-task-runner.h"
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "include/v8-platform.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
+#include "src/base/platform/time.h"
+#include "src/libplatform/work-stealing-deque.h"
+#include "testing/gtest-support.h"
+
+namespace v8 {
+namespace platform {
+
+namespace {
+
+class TestTask : public v8::Task {
+ public:
+  explicit TestTask(std::function<void()> f) : f_(std::move(f)) {}
+
+  void Run() override { f_(); }
+
+ private:
+  std::function<void()> f_;
+};
+
+double RealTime() {
+  return base::TimeTicks::Now().ToInternalValue() /
+         static_cast<double>(base::Time::kMicrosecondsPerSecond);
+}
+
+}  // namespace
+
+TEST(WorkStealingDequeUnittest, PushPopIsLifo) {
+  WorkStealingDeque<int> deque;
+  int item;
+  EXPECT_TRUE(deque.IsEmpty());
+  EXPECT_FALSE(deque.Pop(&item));
+  for (int i = 0; i < 3; i++) deque.Push(i);
+  EXPECT_FALSE(deque.IsEmpty());
+  for (int i = 2; i >= 0; i--) {
+    ASSERT_TRUE(deque.Pop(&item));
+    EXPECT_EQ(i, item);
+  }
+  EXPECT_TRUE(deque.IsEmpty());
+  EXPECT_FALSE(deque.Pop(&item));
+}
+
+TEST(WorkStealingDequeUnittest, StealIsFifo) {
+  WorkStealingDeque<int> deque;
+  int item;
+  EXPECT_FALSE(deque.Steal(&item));
+  for (int i = 0; i < 3; i++) deque.Push(i);
+  ASSERT_TRUE(deque.Steal(&item));
+  EXPECT_EQ(0, item);
+  ASSERT_TRUE(deque.Pop(&item));
+  EXPECT_EQ(2, item);
+  ASSERT_TRUE(deque.Steal(&item));
+  EXPECT_EQ(1, item);
+  EXPECT_FALSE(deque.Steal(&item));
+  EXPECT_FALSE(deque.Pop(&item));
+}
+
+TEST(WorkStealingDequeUnittest, Grow) {
+  WorkStealingDeque<int> deque(4);
+  int item;
+  // Move the indices away from zero before growing.
+  deque.Push(-1);
+  ASSERT_TRUE(deque.Steal(&item));
+  for (int i = 0; i < 100; i++) deque.Push(i);
+  for (int i = 0; i < 50; i++) {
+    ASSERT_TRUE(deque.Steal(&item));
+    EXPECT_EQ(i, item);
+  }
+  for (int i = 99; i >= 50; i--) {
+    ASSERT_TRUE(deque.Pop(&item));
+    EXPECT_EQ(i, item);
+  }
+  EXPECT_TRUE(deque.IsEmpty());
+}
+
+namespace {
+
+class ThiefThread final : public base::Thread {
+ public:
+  ThiefThread(WorkStealingDeque<int>* deque, std::atomic<bool>* done)
+      : base::Thread(Options("ThiefThread")), deque_(deque), done_(done) {}
+
+  void Run() override {
+    int item;
+    while (!done_->load()) {
+      if (deque_->Steal(&item)) stolen_.push_back(item);
+    }
+    while (deque_->Steal(&item)) stolen_.push_back(item);
+  }
+
+  const std::vector<int>& stolen() const { return stolen_; }
+
+ private:
+  WorkStealingDeque<int>* const deque_;
+  std::atomic<bool>* const done_;
+  std::vector<int> stolen_;
+};
+
+}  // namespace
+
+TEST(WorkStealingDequeUnittest, ConcurrentSteal) {
+  constexpr int kItems = 100000;
+  constexpr int kThieves = 4;
+  WorkStealingDeque<int> deque(2);
+  std::atomic<bool> done{false};
+  std::vector<std::unique_ptr<ThiefThread>> thieves;
+  for (int i = 0; i < kThieves; i++) {
+    thieves.push_back(std::make_unique<ThiefThread>(&deque, &done));
+    CHECK(thieves.back()->Start());
+  }
+
+  // Every item is taken exactly once, either by the owner or by a thief.
+  std::vector<int> taken(kItems, 0);
+  int item;
+  for (int i = 0; i < kItems; i++) {
+    deque.Push(i);
+    if (i % 3 == 0 && deque.Pop(&item)) taken[item]++;
+  }
+  while (deque.Pop(&item)) taken[item]++;
+  done.store(true);
+  for (auto& thief : thieves) {
+    thief->Join();
+    for (int stolen : thief->stolen()) taken[stolen]++;
+  }
+  for (int i = 0; i < kItems; i++) EXPECT_EQ(1, taken[i]);
+}
+
+TEST(WorkStealingTaskRunnerUnittest, PostTask) {
+  constexpr int kTasks = 1000;
+  WorkStealingTaskRunner runner(4, RealTime);
+
+  std::atomic<int> count{0};
+  base::Semaphore semaphore(0);
+  for (int i = 0; i < kTasks; i++) {
+    runner.PostTask(TaskPriority::kUserVisible,
+                    std::make_unique<TestTask>([&] {
+                      if (++count == kTasks) semaphore.Signal();
+                    }));
+  }
+  semaphore.Wait();
+
+  runner.Terminate();
+  EXPECT_EQ(kTasks, count.load());
+}
+
+TEST(WorkStealingTaskRunnerUnittest, PostTaskFromWorker) {
+  // Every task posts two more tasks from its worker thread, which go to the
+  // worker's own deque and have to be stolen by the other workers.
+  constexpr int kDepth = 12;
+  constexpr int kTasks = (1 << (kDepth + 1)) - 1;
+  WorkStealingTaskRunner runner(4, RealTime);
+
+  std::atomic<int> count{0};
+  base::Semaphore semaphore(0);
+  std::function<void(int)> spawn = [&](int depth) {
+    runner.PostTask(TaskPriority::kUserBlocking,
+                    std::make_unique<TestTask>([&, depth] {
+                      if (depth > 0) {
+                        spawn(depth - 1);
+                        spawn(depth - 1);
+                      }
+                      if (++count == kTasks) semaphore.Signal();
+                    }));
+  };
+  spawn(kDepth);
+  semaphore.Wait();
+
+  runner.Terminate();
+  EXPECT_EQ(kTasks, count.load());
+}
+
+TEST(WorkStealingTaskRunnerUnittest, InjectedTasksRunInPriorityOrder) {
+  WorkStealingTaskRunner runner(1, RealTime);
+
+  base::Semaphore blocking_task_started(0);
+  base::Semaphore unblock(0);
+  base::Semaphore done(0);
+  std::vector<TaskPriority> order;
+
+  runner.PostTask(TaskPriority::kUserVisible, std::make_unique<TestTask>([&] {
+                    blocking_task_started.Signal();
+                    unblock.Wait();
+                  }));
+  blocking_task_started.Wait();
+
+  for (TaskPriority priority :
+       {TaskPriority::kBestEffort, TaskPriority::kUserVisible,
+        TaskPriority::kUserBlocking}) {
+    runner.PostTask(priority, std::make_unique<TestTask>([&, priority] {
+                      order.push_back(priority);
+                      if (order.size() == 3) done.Signal();
+                    }));
+  }
+  unblock.Signal();
+  done.Wait();
+
+  runner.Terminate();
+  ASSERT_EQ(3UL, order.size());
+  EXPECT_EQ(TaskPriority::kUserBlocking, order[0]);
+  EXPECT_EQ(TaskPriority::kUserVisible, order[1]);
+  EXPECT_EQ(TaskPriority::kBestEffort, order[2]);
+}
+
+TEST(WorkStealingTaskRunnerUnittest, PostDelayedTask) {
+  WorkStealingTaskRunner runner(2, RealTime);
+
+  base::Semaphore semaphore(0);
+  std::vector<int> order;
+  base::Mutex lock;
+  auto push = [&](int value) {
+    base::MutexGuard guard(&lock);
+    order.push_back(value);
+    semaphore.Signal();
+  };
+
+  double start = RealTime();
+  runner.PostDelayedTask(TaskPriority::kUserVisible,
+                         std::make_unique<TestTask>([&] { push(2); }), 0.1);
+  runner.PostTask(TaskPriority::kUserVisible,
+                  std::make_unique<TestTask>([&] { push(1); }));
+  semaphore.Wait();
+  semaphore.Wait();
+
+  EXPECT_LE(start + 0.1, RealTime());
+  runner.Terminate();
+  ASSERT_EQ(2UL, order.size());
+  EXPECT_EQ(1, order[0]);
+  EXPECT_EQ(2, order[1]);
+}
+
+TEST(WorkStealingTaskRunnerUnittest, NoTasksRunAfterTerminate) {
+  WorkStealingTaskRunner runner(2, RealTime);
+
+  std::atomic<bool> ran{false};
+  runner.PostDelayedTask(TaskPriority::kUserVisible,
+                         std::make_unique<TestTask>([&] { ran = true; }), 10);
+  runner.Terminate();
+  runner.PostTask(TaskPriority::kUserVisible,
+                  std::make_unique<TestTask>([&] { ran = true; }));
+  EXPECT_FALSE(ran.load());
+}
+
+}  // namespace platform
+}  // namespace v8
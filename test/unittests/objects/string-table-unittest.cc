@@ -0,0 +1,141 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/objects/string-table.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/base/platform/semaphore.h"
+#include "src/handles/local-handles-inl.h"
+#include "src/handles/persistent-handles.h"
+#include "src/heap/local-heap-inl.h"
+#include "src/heap/parked-scope-inl.h"
+#include "src/objects/string-inl.h"
+#include "test/unittests/heap/heap-utils.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+using StringTableTest = TestWithHeapInternalsAndContext;
+
+namespace {
+
+constexpr int kStrings = 10000;
+
+std::string NumberedString(const char* prefix, int i) {
+  return prefix + std::to_string(i);
+}
+
+Handle<String> Internalize(Factory* factory, const std::string& string) {
+  return factory->InternalizeString(
+      factory->NewStringFromAsciiChecked(string.c_str()));
+}
+
+class InternalizeThread final : public ParkingThread {
+ public:
+  InternalizeThread(Isolate* isolate, const char* prefix,
+                    base::Semaphore* sema_started)
+      : ParkingThread(base::Thread::Options("InternalizeThread")),
+        isolate_(isolate),
+        prefix_(prefix),
+        sema_started_(sema_started) {}
+
+  void Run() override {
+    LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(local_isolate.heap());
+    LocalHandleScope handle_scope(&local_isolate);
+
+    sema_started_->Signal();
+    for (int i = 0; i < kStrings; i++) {
+      std::string string = NumberedString(prefix_, i);
+      Handle<String> internalized = local_isolate.factory()->InternalizeString(
+          base::OneByteVector(string.c_str()));
+      EXPECT_TRUE(IsInternalizedString(*internalized));
+      strings_.push_back(
+          local_isolate.heap()->NewPersistentHandle(internalized));
+    }
+    ph_ = local_isolate.heap()->DetachPersistentHandles();
+  }
+
+  const std::vector<Handle<String>>& strings() const { return strings_; }
+
+ private:
+  Isolate* const isolate_;
+  const char* const prefix_;
+  base::Semaphore* const sema_started_;
+  std::vector<Handle<String>> strings_;
+  std::unique_ptr<PersistentHandles> ph_;
+};
+
+}  // namespace
+
+TEST_F(StringTableTest, LookupManyStrings) {
+  StringTable* string_table = i_isolate()->string_table();
+  HandleScope scope(i_isolate());
+
+  std::vector<Handle<String>> strings;
+  for (int i = 0; i < kStrings; i++) {
+    strings.push_back(Internalize(factory(), NumberedString("many-", i)));
+    EXPECT_TRUE(IsInternalizedString(*strings.back()));
+  }
+  EXPECT_LE(kStrings, string_table->NumberOfElements());
+  EXPECT_LT(string_table->NumberOfElements(), string_table->Capacity());
+
+  // Every string is found again after the table grew.
+  const int elements = string_table->NumberOfElements();
+  for (int i = 0; i < kStrings; i++) {
+    EXPECT_EQ(*strings[i], *Internalize(factory(), NumberedString("many-", i)));
+  }
+  EXPECT_GE(elements, string_table->NumberOfElements());
+}
+
+TEST_F(StringTableTest, ReuseEntriesOfDeadStrings) {
+  StringTable* string_table = i_isolate()->string_table();
+  {
+    HandleScope scope(i_isolate());
+    for (int i = 0; i < kStrings; i++) {
+      Internalize(factory(), NumberedString("dead-", i));
+    }
+  }
+  const int elements_before_gc = string_table->NumberOfElements();
+  InvokeMajorGC();
+  EXPECT_GT(elements_before_gc, string_table->NumberOfElements());
+
+  // Strings with the same hashes take the slots of the dead strings.
+  HandleScope scope(i_isolate());
+  std::vector<Handle<String>> strings;
+  for (int i = 0; i < kStrings; i++) {
+    strings.push_back(Internalize(factory(), NumberedString("dead-", i)));
+  }
+  for (int i = 0; i < kStrings; i++) {
+    EXPECT_EQ(*strings[i], *Internalize(factory(), NumberedString("dead-", i)));
+  }
+}
+
+TEST_F(StringTableTest, ConcurrentLookup) {
+  HandleScope scope(i_isolate());
+  base::Semaphore sema_started(0);
+  InternalizeThread thread(i_isolate(), "concurrent-", &sema_started);
+  ASSERT_TRUE(thread.Start());
+  sema_started.Wait();
+
+  std::vector<Handle<String>> strings;
+  for (int i = kStrings - 1; i >= 0; i--) {
+    strings.push_back(Internalize(factory(), NumberedString("concurrent-", i)));
+  }
+  thread.ParkedJoin(i_isolate()->main_thread_local_isolate());
+
+  // Both threads must have ended up with the same internalized strings.
+  ASSERT_EQ(static_cast<size_t>(kStrings), thread.strings().size());
+  for (int i = 0; i < kStrings; i++) {
+    EXPECT_EQ(*strings[kStrings - 1 - i], *thread.strings()[i]);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,82 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/utils/locked-priority-queue-inl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using Record = int;
+
+}  // namespace
+
+namespace v8 {
+namespace internal {
+
+TEST(LockedPriorityQueue, ConstructorEmpty) {
+  LockedPriorityQueue<Record> queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(0u, queue.size());
+}
+
+TEST(LockedPriorityQueue, SingleRecordEnqueueDequeue) {
+  LockedPriorityQueue<Record> queue;
+  queue.Enqueue(1, 0);
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_EQ(1u, queue.size());
+  Record a = -1;
+  base::TimeDelta queue_time = base::TimeDelta::FromSeconds(-1);
+  EXPECT_TRUE(queue.Dequeue(&a, &queue_time));
+  EXPECT_EQ(1, a);
+  EXPECT_LE(base::TimeDelta(), queue_time);
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_FALSE(queue.Dequeue(&a));
+}
+
+TEST(LockedPriorityQueue, HighestPriorityFirst) {
+  LockedPriorityQueue<Record> queue;
+  queue.Enqueue(1, 10);
+  queue.Enqueue(2, 30);
+  queue.Enqueue(3, 20);
+  Record rec = 0;
+  EXPECT_TRUE(queue.Dequeue(&rec));
+  EXPECT_EQ(2, rec);
+  EXPECT_TRUE(queue.Dequeue(&rec));
+  EXPECT_EQ(3, rec);
+  EXPECT_TRUE(queue.Dequeue(&rec));
+  EXPECT_EQ(1, rec);
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(LockedPriorityQueue, FifoWithinPriority) {
+  LockedPriorityQueue<Record> queue;
+  for (int i = 1; i <= 12; ++i) queue.Enqueue(i, 0);
+  Record rec = 0;
+  for (int i = 1; i <= 12; ++i) {
+    EXPECT_TRUE(queue.Dequeue(&rec));
+    EXPECT_EQ(i, rec);
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(LockedPriorityQueue, RaisePriority) {
+  LockedPriorityQueue<Record> queue;
+  queue.Enqueue(1, 10);
+  queue.Enqueue(2, 20);
+  queue.Enqueue(3, 5);
+  EXPECT_TRUE(queue.RaisePriority([](Record r) { return r == 3; }, 100));
+  EXPECT_FALSE(queue.RaisePriority([](Record r) { return r == 4; }, 100));
+  // Lowering is not possible through RaisePriority.
+  EXPECT_TRUE(queue.RaisePriority([](Record r) { return r == 2; }, 0));
+  Record rec = 0;
+  EXPECT_TRUE(queue.Dequeue(&rec));
+  EXPECT_EQ(3, rec);
+  EXPECT_TRUE(queue.Dequeue(&rec));
+  EXPECT_EQ(2, rec);
+  EXPECT_TRUE(queue.Dequeue(&rec));
+  EXPECT_EQ(1, rec);
+}
+
+}  // namespace internal
+}  // namespace v8